@@ -8,12 +8,17 @@
 */
 
 // basic packages
+#include <algorithm>
+#include <vector>
 
 // project packages
 #include "BlasMpi.hpp"
 #include "Vector.hpp"
 #include "MatrixDense.hpp"
 #include "DataTopology.hpp"
+#include "Trace.hpp"
+#include "Tune.hpp"
+#include "Memory.hpp"
 
 // third-party packages
 
@@ -29,12 +34,11 @@ namespace BlasMpi {
             const MatrixDense<double, int> &A,
             const Vector<double, int> &x,
             MPI_Comm &mpi_comm) {
+        TRACE_SCOPE("MatrixVectorProductBandRow");
         int rank, nproc;
         MPI_Comm_rank(mpi_comm,&rank);
         MPI_Comm_size(mpi_comm,&nproc);
 
-        Vector<double,int> x_temp(y.GetSize());
-
         int* recvcounts = new int[nproc];
         int* shifts = new int[nproc];
         int* ones = new int[nproc];
@@ -44,19 +48,86 @@ namespace BlasMpi {
             idty[i] = i;
         }
         int size = x.GetSize();
+        TRACE_BEGIN("metadata");
         MPI_Allgatherv(&size,1,MPI_INT,recvcounts,ones,idty,MPI_INT,mpi_comm);
+        TRACE_END();
+        int total_size = 0;
         for(int i = 0; i < nproc; i++){
             if(i == 0)
                 shifts[i] = 0;
             else
                 shifts[i] = shifts[i-1]+recvcounts[i-1];
+            total_size += recvcounts[i];
         }
 
+        // -- the whole x on every processor: n doubles, whatever the number of processors
+        MEMORY_TAG("MatrixVectorProductBandRow x_temp");
+        Vector<double,int> x_temp(total_size);
+
+        // -- chunk c of every band: one allgather per chunk, the columns of
+        //    a chunk are multiplied as soon as it has arrived
+        Tune::Parameters params;
+        Tune::Agree(params, mpi_comm);
+        const int numb_chunks = params.allgather_chunks;
+        if (numb_chunks > 1) {
+            std::vector<int> counts(numb_chunks * nproc);
+            std::vector<int> displs(numb_chunks * nproc);
+            std::vector<MPI_Request> requests(numb_chunks);
+            TRACE_BEGIN("communication");
+            for (int c = 0; c < numb_chunks; c++) {
+                for (int r = 0; r < nproc; r++) {
+                    counts[c * nproc + r] = DataTopology::BandSize(c, numb_chunks, recvcounts[r]);
+                    displs[c * nproc + r] = shifts[r] +
+                                            DataTopology::BandIndexPos(c, numb_chunks, recvcounts[r]);
+                }
+                MPI_Iallgatherv(x.GetCoef() + DataTopology::BandIndexPos(c, numb_chunks, size),
+                                counts[c * nproc + rank], MPI_DOUBLE,
+                                x_temp.GetCoef(), &counts[c * nproc], &displs[c * nproc],
+                                MPI_DOUBLE, mpi_comm, &requests[c]);
+            }
+            TRACE_END();
+
+            for (int i = 0; i < A.GetNumbRows(); i++) {
+                y(i) = 0.;
+            }
+            for (int c = 0; c < numb_chunks; c++) {
+                TRACE_BEGIN("communication");
+                MPI_Wait(&requests[c], MPI_STATUS_IGNORE);
+                TRACE_END();
+                TRACE_BEGIN("kernel");
+                for (int i = 0; i < A.GetNumbRows(); i++) {
+                    const double *A_i = A.GetCoef(i);
+                    double res = 0.;
+                    for (int r = 0; r < nproc; r++) {
+                        int j_end = displs[c * nproc + r] + counts[c * nproc + r];
+                        for (int j = displs[c * nproc + r]; j < j_end; j++) {
+                            res += A_i[j] * x_temp(j);
+                        }
+                    }
+                    y(i) += res;
+                }
+                TRACE_END();
+            }
 
+            delete[] recvcounts;
+            delete[] shifts;
+            delete[] ones;
+            delete[] idty;
+
+            return 0;
+        }
 
+        TRACE_BEGIN("communication");
         MPI_Allgatherv(x.GetCoef(),x.GetSize(),MPI_DOUBLE,x_temp.GetCoef(),recvcounts,shifts,MPI_DOUBLE,mpi_comm);
-        A.MatrixVectorProduct(y, x_temp);
+        TRACE_END();
+        TRACE_BEGIN("kernel");
+        A.MatrixVectorProduct(y, x_temp, params.mvp_unroll);
+        TRACE_END();
 
+        delete[] recvcounts;
+        delete[] shifts;
+        delete[] ones;
+        delete[] idty;
 
         return 0;
     }
@@ -70,7 +141,10 @@ namespace BlasMpi {
             const Vector<double, int> &x,
             int root,
             MPI_Comm &mpi_comm) {
-        A.MatrixVectorProduct(y_global,x);
+        TRACE_SCOPE("MatrixVectorProductBandColumn");
+        TRACE_BEGIN("kernel");
+        A.MatrixVectorProduct(y_global, x, Tune::Get().mvp_unroll);
+        TRACE_END();
 
 
         return 0;
@@ -107,5 +181,127 @@ namespace BlasMpi {
 
     ________________________________________________________________________________
 
+//! @internal compute matrix-vector product y:= A *x (block-cyclic)
+    int MatrixVectorProductBlockCyclic(
+            Vector<double, int> &y,
+            const MatrixDense<double, int> &A,
+            const Vector<double, int> &x,
+            MPI_Comm &mpi_comm_rows,
+            MPI_Comm &mpi_comm_columns) {
+        TRACE_SCOPE("MatrixVectorProductBlockCyclic");
+        MEMORY_TAG("MatrixVectorProductBlockCyclic");
+
+        // -- local product on the blocks owned by the processor
+        Vector<double, int> y_partial(A.GetNumbRows());
+        TRACE_BEGIN("kernel");
+        A.MatrixVectorProduct(y_partial, x, Tune::Get().mvp_unroll);
+        TRACE_END();
+
+        // -- sum the partial products along the processor row
+        TRACE_BEGIN("communication");
+        MPI_Allreduce(y_partial.GetCoef(), y.GetCoef(), A.GetNumbRows(),
+                      MPI_DOUBLE, MPI_SUM, mpi_comm_rows);
+        TRACE_END();
+
+        return 0;
+    }
+
+    ________________________________________________________________________________
+
+//! @internal compute matrix-matrix product C := A * B (block-cyclic, SUMMA)
+    int MatrixMatrixProductBlockCyclic(
+            MatrixDense<double, int> &C,
+            const MatrixDense<double, int> &A,
+            const MatrixDense<double, int> &B,
+            int block_size,
+            MPI_Comm &mpi_comm_rows,
+            MPI_Comm &mpi_comm_columns) {
+        TRACE_SCOPE("MatrixMatrixProductBlockCyclic");
+        MEMORY_TAG("MatrixMatrixProductBlockCyclic");
+
+        int numb_procs_i, numb_procs_j, proc_numb_i, proc_numb_j;
+        MPI_Comm_size(mpi_comm_columns, &numb_procs_i);
+        MPI_Comm_rank(mpi_comm_columns, &proc_numb_i);
+        MPI_Comm_size(mpi_comm_rows, &numb_procs_j);
+        MPI_Comm_rank(mpi_comm_rows, &proc_numb_j);
+
+        // -- global inner dimension
+        int size_k_local = A.GetNumbColumns();
+        int size_k = 0;
+        TRACE_BEGIN("metadata");
+        MPI_Allreduce(&size_k_local, &size_k, 1, MPI_INT, MPI_SUM, mpi_comm_rows);
+        TRACE_END();
+
+        int rows = A.GetNumbRows();
+        int cols = B.GetNumbColumns();
+        C.Allocate(rows, cols);
+        for (int i = 0; i < rows * cols; i++) {
+            C.GetCoef()[i] = 0.;
+        }
+
+        // -- panels of A (rows x block_size) and B (block_size x cols),
+        //    scratch buffers kept by the context of the grid rows
+        double *A_panel;
+        double *B_panel;
+        DataTopology::ScratchBuffer(A_panel, (size_t) rows * block_size, mpi_comm_rows, 0);
+        DataTopology::ScratchBuffer(B_panel, (size_t) block_size * cols, mpi_comm_rows, 1);
+
+        // -- panels of summa_panel columns inside a block (0: the whole block)
+        Tune::Parameters params;
+        Tune::Agree(params, mpi_comm_rows, mpi_comm_columns);
+        const int panel = params.summa_panel;
+        const int panel_width = (panel > 0 && panel < block_size) ? panel : block_size;
+
+        int width = 0;
+        for (int k = 0; k < size_k; k += width) {
+            width = std::min(panel_width, block_size - k % block_size);
+            width = std::min(width, size_k - k);
+
+            // -- broadcast the panel of A along the processor row
+            int owner_j = DataTopology::CyclicGlobalToProc(k, numb_procs_j, block_size);
+            if (proc_numb_j == owner_j) {
+                TRACE_BEGIN("pack");
+                int k_local = DataTopology::CyclicGlobalToLocal(k, numb_procs_j, block_size);
+                for (int i = 0; i < rows; i++) {
+                    for (int l = 0; l < width; l++) {
+                        A_panel[i * width + l] = A(i, k_local + l);
+                    }
+                }
+                TRACE_END();
+            }
+            TRACE_BEGIN("communication");
+            MPI_Bcast(A_panel, rows * width, MPI_DOUBLE, owner_j, mpi_comm_rows);
+
+            // -- broadcast the panel of B along the processor column
+            //    (rows of B are contiguous, no packing needed)
+            int owner_i = DataTopology::CyclicGlobalToProc(k, numb_procs_i, block_size);
+            double *B_coef = B_panel;
+            if (proc_numb_i == owner_i) {
+                int k_local = DataTopology::CyclicGlobalToLocal(k, numb_procs_i, block_size);
+                B_coef = B.GetCoef(k_local);
+            }
+            MPI_Bcast(B_coef, width * cols, MPI_DOUBLE, owner_i, mpi_comm_columns);
+            TRACE_END();
+
+            // -- local rank-update C += A_panel * B_panel
+            TRACE_BEGIN("kernel");
+            for (int i = 0; i < rows; i++) {
+                double *C_i = C.GetCoef(i);
+                for (int l = 0; l < width; l++) {
+                    double a_il = A_panel[i * width + l];
+                    const double *B_l = B_coef + l * cols;
+                    for (int j = 0; j < cols; j++) {
+                        C_i[j] += a_il * B_l[j];
+                    }
+                }
+            }
+            TRACE_END();
+        }
+
+        return 0;
+    }
+
+    ________________________________________________________________________________
+
 
 } // namespace BlasMpi {
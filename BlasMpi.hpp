@@ -29,6 +29,7 @@ namespace BlasMpi {
 //! @param [in] A = global matrix
 //! @param [in] x = local vector
 //! @param [in] mpi_comm = MPI communicator
+//! @remarks x is gathered in Tune::Parameters::allgather_chunks chunks
 //! @return error code
 int MatrixVectorProductBandRow (
         Vector<double,int>& y,
@@ -82,6 +83,38 @@ int MatrixMatrixProductBlock (
         MPI_Comm& mpi_comm_rows,
         MPI_Comm& mpi_comm_columns ) ;
 
+//! @brief compute matrix-vector product y:= A *x (block-cyclic)
+//! @param [out] y = local result vector (cyclic over the processor rows)
+//! @param [in] A = local matrix
+//! @param [in] x = local vector (cyclic over the processor columns)
+//! @param [in] mpi_comm_rows = grid rows communicator
+//! @param [in] mpi_comm_columns = grid columns communicator
+//! @return error code
+int MatrixVectorProductBlockCyclic (
+        Vector<double,int>& y,
+        const MatrixDense<double,int>& A,
+        const Vector<double,int>& x,
+        MPI_Comm& mpi_comm_rows,
+        MPI_Comm& mpi_comm_columns ) ;
+
+//! @brief compute matrix-matrix product C := A * B (block-cyclic, SUMMA)
+//! @param [out] C = local result matrix
+//! @param [in] A = local matrix
+//! @param [in] B = local matrix
+//! @param [in] block_size = column block size of A (= row block size of B)
+//! @param [in] mpi_comm_rows = grid rows communicator
+//! @param [in] mpi_comm_columns = grid columns communicator
+//! @remarks C has the row blocks of A and the column blocks of B
+//! @remarks panels of Tune::Parameters::summa_panel columns (at most a block)
+//! @return error code
+int MatrixMatrixProductBlockCyclic (
+        MatrixDense<double,int>& C,
+        const MatrixDense<double,int>& A,
+        const MatrixDense<double,int>& B,
+        int block_size,
+        MPI_Comm& mpi_comm_rows,
+        MPI_Comm& mpi_comm_columns ) ;
+
 } // namespace BlasMpi {
 
 #endif // GUARD_BLASMPI_HPP_
@@ -8,10 +8,20 @@
 */
 
 // basic packages
+#include <string.h>
+#include <errno.h>
+#include <math.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <limits.h>
+#include <string>
+#include <vector>
 
 // project packages
 #include <iostream>
 #include "DataTopology.hpp"
+#include "Trace.hpp"
+#include "Memory.hpp"
 #include "Vector.hpp"
 #include "MatrixDense.hpp"
 
@@ -39,6 +49,17 @@ namespace DataTopology {
 
     ________________________________________________________________________________
 
+//! @internal index position of a given band
+    int BandIndexPos(
+            int proc_numb,
+            int numb_procs,
+            int size) {
+
+        return BandPos(proc_numb, numb_procs, size);
+    }
+
+    ________________________________________________________________________________
+
 //! @internal size of a given band
     int BandSize(
             int proc_numb,
@@ -79,429 +100,3187 @@ namespace DataTopology {
 
     ________________________________________________________________________________
 
-//! @internal creation of two-dimensional grid communicator and communicators
-//         for each row and each column of the grid
-    int GridCartesianComm(
-            MPI_Comm &mpi_comm_rows,
-            MPI_Comm &mpi_comm_columns,
-            MPI_Comm &mpi_comm) {
-
-        // -- number of processors
-        int numb_procs;
-        // -- get number of processes
-        MPI_Comm_size(mpi_comm, &numb_procs);
-
-        // -- number of cartesian dimensions (integer)
-        const int numb_dims = 2;
-
-        // -- get suggestion on best work divison
-        // integer array of size numb_dims specifying the number of nodes in each dimension
-        int grid_dims[numb_dims];
-        grid_dims[0] = 0;
-        grid_dims[1] = 0;
-        MPI_Dims_create(numb_procs, numb_dims, grid_dims);
+//! @internal weighted band list start and position
+    int BandTopology(
+            int *&band_list_start,
+            int *&band_list_size,
+            int size,
+            const Vector<double, int> &weights,
+            int shift) {
 
-        // -- create a new communicator with the layout of a cartesian grid
-        MPI_Comm mpi_comm_cart;
-        // logical array of size numb_dims specifying whether the grid is periodic or not in each dimension
-        int periods[numb_dims];
-        periods[0] = 0;
-        periods[1] = 0;
-        MPI_Cart_create(mpi_comm, numb_dims, grid_dims, periods, 1, &mpi_comm_cart);
+        int numb_procs = weights.GetSize();
+        const double *weight = weights.GetCoef();
 
-        // -- process number (process proc_numb)
-        int grid_proc_numb;
-        // -- get current process proc_numb
-        MPI_Comm_rank(mpi_comm_cart, &grid_proc_numb);
+        double total_weight = 0.;
+        for (int k = 0; k < numb_procs; k++) {
+            total_weight += (weight[k] > 0.) ? weight[k] : 0.;
+        }
+        // -- no weight: even bands
+        if (total_weight <= 0.) {
+            return BandTopology(band_list_start, band_list_size, size, numb_procs, shift);
+        }
 
-        // -- get local coordinates on grid
-        // cartesian coordinates of specified process
-        int grid_coords[numb_dims];
-        grid_coords[0] = 0;
-        grid_coords[1] = 0;
-        MPI_Cart_coords(mpi_comm_cart, grid_proc_numb, numb_dims, grid_coords);
+        // -- band starts (displacement)
+        band_list_start = new int[numb_procs];
+        // -- band sizes (count)
+        band_list_size = new int[numb_procs];
 
-        // -- create communicators that work across entire rows or columns
-        //  3 x 2 grid
-        // (0,0)=0 (1,0)=3
-        // (0,1)=1 (1,1)=4
-        // (0,2)=2 (1,2)=5
-        MPI_Comm_split(mpi_comm_cart, grid_coords[0], grid_coords[1],
-                       &mpi_comm_rows);
-        MPI_Comm_split(mpi_comm_cart, grid_coords[1], grid_coords[0],
-                       &mpi_comm_columns);
+        // -- band k ends at the rounded cumulated weight of bands 0..k
+        double cumulated_weight = 0.;
+        int band_start = 0;
+        for (int k = 0; k < numb_procs; k++) {
+            cumulated_weight += (weight[k] > 0.) ? weight[k] : 0.;
+            int band_end = (k == numb_procs - 1)
+                           ? size
+                           : (int) (size * (cumulated_weight / total_weight) + 0.5);
+            band_end = (band_end < band_start) ? band_start : band_end;
+            band_end = (band_end > size) ? size : band_end;
+            // -- start position
+            band_list_start[k] = band_start * shift;
+            // -- size of the block
+            band_list_size[k] = (band_end - band_start) * shift;
+            band_start = band_end;
+        }
 
         return 0;
     }
 
     ________________________________________________________________________________
 
-// -----------------------------------------------------------------------------
-// -- Vector: BAND
-// -----------------------------------------------------------------------------
-
-//! @internal distribute vector upon processors
-    int DistributeVectorBand(
-            Vector<double, int> &x_local,
-            const Vector<double, int> &x,
-            int root,
-            MPI_Comm &mpi_comm) {
+//! @internal band weights of the processors (relative speed)
+    int CalibrateBandWeights(
+            Vector<double, int> &weights,
+            MPI_Comm &mpi_comm,
+            const char *file_name,
+            int size,
+            int numb_reps) {
 
         int rank, nproc;
         MPI_Comm_rank(mpi_comm, &rank);
         MPI_Comm_size(mpi_comm, &nproc);
 
-        int vector_size;
-        if(rank == 0)
-            vector_size = x.GetSize();
-        MPI_Bcast(&vector_size,1,MPI_INT,root,mpi_comm);
+        // -- weights of a previous run
+        if (file_name != NULL) {
+            int is_loaded = 0;
+            if (rank == 0) {
+                FILE *file = fopen(file_name, "r");
+                if (file != NULL) {
+                    fclose(file);
+                    is_loaded = (weights.ReadFromFileCsv(file_name) == 0 &&
+                                 weights.GetSize() == nproc);
+                }
+            }
+            MPI_Bcast(&is_loaded, 1, MPI_INT, 0, mpi_comm);
+            if (is_loaded) {
+                if (rank != 0) {
+                    weights.Allocate(nproc);
+                }
+                MPI_Bcast(weights.GetCoef(), nproc, MPI_DOUBLE, 0, mpi_comm);
+                return 0;
+            }
+        }
 
-        int sendcounts[nproc];
-        int displs[nproc];
-        for (int i = 0; i < nproc; i++) {
-            sendcounts[i] = BandSize(rank, nproc, vector_size);
+        // -- GEMV micro-benchmark, same problem on every processor
+        MatrixDense<double, int> A(size, size);
+        Vector<double, int> x(size);
+        Vector<double, int> y(size);
+        for (int i = 0; i < size; i++) {
+            for (int j = 0; j < size; j++) {
+                A(i, j) = 1. / (1. + i + j);
+            }
+            x(i) = 1.;
+        }
+        // -- warm-up (page faults, caches)
+        const int unroll = Tune::Get().mvp_unroll;
+        A.MatrixVectorProduct(y, x, unroll);
+
+        MPI_Barrier(mpi_comm);
+        double time = MPI_Wtime();
+        for (int r = 0; r < numb_reps; r++) {
+            A.MatrixVectorProduct(y, x, unroll);
+        }
+        time = MPI_Wtime() - time;
+        double speed = (time > 0.) ? numb_reps / time : 1.;
+
+        // -- weights sum to the number of processors (1 for even bands)
+        weights.Allocate(nproc);
+        MPI_Allgather(&speed, 1, MPI_DOUBLE, weights.GetCoef(), 1, MPI_DOUBLE, mpi_comm);
+        double total_speed = 0.;
+        for (int k = 0; k < nproc; k++) {
+            total_speed += weights(k);
+        }
+        for (int k = 0; k < nproc; k++) {
+            weights(k) *= nproc / total_speed;
         }
 
-        for(int i = 0; i < nproc; i++){
-            if(i == 0)
-                displs[i] = 0;
-            else
-                displs[i] = displs[i-1]+sendcounts[i-1];
+        if (file_name != NULL && rank == 0) {
+            weights.WriteToFileCsv(file_name, '\n');
         }
 
+        return 0;
+    }
 
-        x_local.Allocate(sendcounts[rank]);
+    ________________________________________________________________________________
 
-        MPI_Scatterv(x.GetCoef(),sendcounts,displs,MPI_DOUBLE, x_local.GetCoef(), sendcounts[rank], MPI_DOUBLE, root, mpi_comm);
+//! @internal keyval of the grid communicator attached to rows and columns communicators
+    int g_grid_keyval = MPI_KEYVAL_INVALID;
 
+//! @internal communicators attached to the rows and columns communicators of a grid
+    struct GridAttr {
+        //! grid communicator (cartesian, owned by the context)
+        MPI_Comm mpi_comm_grid;
+        //! communicator the grid was created from (not owned)
+        MPI_Comm mpi_comm;
+    };
 
+//! @internal release the grid communicator handles attached to a communicator
+    int GridCommDeleteAttr(
+            MPI_Comm mpi_comm,
+            int keyval,
+            void *attribute_val,
+            void *extra_state) {
 
+        delete static_cast<GridAttr *>(attribute_val);
 
-        return 0;
+        return MPI_SUCCESS;
     }
 
     ________________________________________________________________________________
 
-//! @internal assemble vector upon processors
-    int AssembleVectorBand(
-            Vector<double, int> &x_global,
-            const Vector<double, int> &x,
-            int root,
-            MPI_Comm &mpi_comm) {
-        int rank, nproc;
-        MPI_Comm_rank(mpi_comm, &rank);
-        MPI_Comm_size(mpi_comm, &nproc);
+// -----------------------------------------------------------------------------
+// -- Context (communicators and scratch buffers cached per communicator)
+// -----------------------------------------------------------------------------
 
-        int* recvcounts = new int[nproc];
-        int* shifts = new int[nproc];
-        int* ones = new int[nproc];
-        int* idty = new int[nproc];
-        for(int i = 0; i < nproc; i++){
-            ones[i] = 1;
-            idty[i] = i;
+//! @internal keyval of the context attached to a communicator
+    int g_context_keyval = MPI_KEYVAL_INVALID;
+
+//! @internal keyval of the finalize hook attached to MPI_COMM_SELF
+    int g_finalize_keyval = MPI_KEYVAL_INVALID;
+
+//! @internal contexts in order of creation
+    std::vector<Context *> g_contexts;
+
+    ________________________________________________________________________________
+
+//! @internal release a context (communicators and buffers)
+    int ContextDeleteAttr(
+            MPI_Comm mpi_comm,
+            int keyval,
+            void *attribute_val,
+            void *extra_state) {
+
+        Context *context = static_cast<Context *>(attribute_val);
+
+        // -- rows and columns before the cartesian communicator they split
+        std::map<std::pair<int, int>, ContextGrid>::iterator it;
+        for (it = context->grids.begin(); it != context->grids.end(); ++it) {
+            MPI_Comm_free(&it->second.mpi_comm_columns);
+            MPI_Comm_free(&it->second.mpi_comm_rows);
+            MPI_Comm_free(&it->second.mpi_comm_cart);
         }
-        int size = x.GetSize();
-        int total_size = 0;
-        MPI_Gatherv(&size,1,MPI_INT,recvcounts,ones,idty,MPI_INT,root,mpi_comm);
-        for(int i = 0; i < nproc; i++){
-            if(i == 0)
-                shifts[i] = 0;
-            else
-                shifts[i] = shifts[i-1]+recvcounts[i-1];
-            total_size += recvcounts[i];
+        if (context->mpi_comm_node != MPI_COMM_NULL) {
+            MPI_Comm_free(&context->mpi_comm_node);
+        }
+        std::map<int, std::vector<double> >::iterator it_scratch;
+        for (it_scratch = context->scratch.begin(); it_scratch != context->scratch.end();
+             ++it_scratch) {
+            Memory::Freed(it_scratch->second.capacity() * sizeof(double),
+                          context->scratch_tags[it_scratch->first]);
         }
 
+        for (size_t k = 0; k < g_contexts.size(); k++) {
+            if (g_contexts[k] == context) {
+                g_contexts.erase(g_contexts.begin() + k);
+                break;
+            }
+        }
+        delete context;
 
+        return MPI_SUCCESS;
+    }
 
+    ________________________________________________________________________________
 
-        x_global.Allocate(total_size);
-        MPI_Gatherv(x.GetCoef(),x.GetSize(),MPI_DOUBLE,x_global.GetCoef(),recvcounts,shifts,MPI_DOUBLE,root,mpi_comm);
+//! @internal release all contexts when MPI_Finalize frees MPI_COMM_SELF
+    int FinalizeDeleteAttr(
+            MPI_Comm mpi_comm,
+            int keyval,
+            void *attribute_val,
+            void *extra_state) {
 
+        FreeContexts();
 
-        return 0;
+        return MPI_SUCCESS;
     }
 
     ________________________________________________________________________________
 
-//! @internal build the 'band_numb'-th band
-    template<class T, class U>
-    int BuildVectorBand(
-            Vector<double, int> &x_local,
-            const Vector<double, int> &x,
-            const int numb_procs,
-            const int proc_numb) {
+//! @internal context of an MPI communicator
+    int GetContext(
+            Context *&context,
+            MPI_Comm &mpi_comm) {
 
-        // -- size of the global vector
-        int size = x.GetSize();
+        if (g_context_keyval == MPI_KEYVAL_INVALID) {
+            MPI_Comm_create_keyval(MPI_COMM_NULL_COPY_FN, ContextDeleteAttr,
+                                   &g_context_keyval, NULL);
+            MPI_Comm_create_keyval(MPI_COMM_NULL_COPY_FN, FinalizeDeleteAttr,
+                                   &g_finalize_keyval, NULL);
+            MPI_Comm_set_attr(MPI_COMM_SELF, g_finalize_keyval, NULL);
+        }
 
-        // -- compute the number of rows per band
-        int size_local = BandSize(proc_numb, numb_procs, size);
-        // -- allocate and fill out the local vector
-        x_local.Allocate(size_local);
-        for (U i = 0; i < size_local; i++) {
-            // local (i) to global indice (l2g_i)
-            int l2g_i = BandPos(proc_numb, numb_procs, size) + i;
-            x_local(i) = x(l2g_i);
+        void *attribute_val = NULL;
+        int flag = 0;
+        MPI_Comm_get_attr(mpi_comm, g_context_keyval, &attribute_val, &flag);
+        if (flag) {
+            context = static_cast<Context *>(attribute_val);
+            return 0;
         }
 
+        context = new Context();
+        context->mpi_comm = mpi_comm;
+        context->mpi_comm_node = MPI_COMM_NULL;
+        context->node_numb = 0;
+        context->numb_nodes = 1;
+        MPI_Comm_set_attr(mpi_comm, g_context_keyval, context);
+        g_contexts.push_back(context);
+
         return 0;
     }
 
     ________________________________________________________________________________
 
+//! @internal scratch buffer of the context of an MPI communicator
+    int ScratchBuffer(
+            double *&buffer,
+            size_t numb_elements,
+            MPI_Comm &mpi_comm,
+            int slot) {
+        // -- buffers kept by the context, not by the operation asking for them
+        MEMORY_TAG("DataTopology::ScratchBuffer");
+
+        Context *context;
+        GetContext(context, mpi_comm);
+
+        std::vector<double> &scratch = context->scratch[slot];
+        if (scratch.size() < numb_elements) {
+            size_t capacity = scratch.capacity();
+            scratch.resize(numb_elements);
+            if (scratch.capacity() > capacity) {
+                const char *&tag = context->scratch_tags[slot];
+                Memory::Freed(capacity * sizeof(double), tag);
+                tag = Memory::Allocated(scratch.capacity() * sizeof(double),
+                                        "DataTopology::ScratchBuffer");
+            }
+        }
+        buffer = scratch.data();
 
-// -----------------------------------------------------------------------------
-// -- Matrix: BAND-ROW
-// -----------------------------------------------------------------------------
+        return 0;
+    }
 
-//! @internal distribute matrix upon processors (band row)
-    int DistributeMatrixBandRow(
-            MatrixDense<double, int> &A_local,
-            const MatrixDense<double, int> &A,
-            int root,
-            MPI_Comm &mpi_comm) {
+    ________________________________________________________________________________
 
-        int rank, nproc;
-        MPI_Comm_rank(mpi_comm, &rank);
-        MPI_Comm_size(mpi_comm, &nproc);
+//! @internal release the context of an MPI communicator
+    int FreeContext(
+            MPI_Comm &mpi_comm) {
 
-        int rows, cols;
-        if (rank == root) {
-            rows = A.GetNumbRows();
-            cols = A.GetNumbColumns();
+        if (g_context_keyval == MPI_KEYVAL_INVALID) {
+            return 0;
         }
 
+        return (MPI_Comm_delete_attr(mpi_comm, g_context_keyval) == MPI_SUCCESS) ? 0 : 1;
+    }
 
-        MPI_Bcast(&rows, 1, MPI_INT, root, mpi_comm);
-        MPI_Bcast(&cols, 1, MPI_INT, root, mpi_comm);
+    ________________________________________________________________________________
 
+//! @internal release all contexts, in reverse order of creation
+    int FreeContexts() {
 
-        int sendcounts[nproc];
-        int shifts[nproc];
-        for (int i = 0; i < nproc; i++) {
-            sendcounts[i] = BandSize(rank, nproc, rows) * cols;
+        // -- releasing a context may release the contexts of its communicators
+        while (!g_contexts.empty()) {
+            Context *context = g_contexts.back();
+            MPI_Comm_delete_attr(context->mpi_comm, g_context_keyval);
         }
 
-        for(int i = 0; i < nproc; i++){
-            if(i == 0)
-                shifts[i] = 0;
-            else
-                shifts[i] = shifts[i-1]+sendcounts[i-1];
+        return 0;
+    }
+
+    ________________________________________________________________________________
+
+//! @internal time of a broadcast (scatter + allgather) among numb_procs processors
+    double BroadcastCost(
+            int numb_procs,
+            double numb_bytes,
+            const NetworkModel &model) {
+
+        if (numb_procs <= 1) {
+            return 0.;
+        }
+        int numb_steps = 0;
+        while ((1 << numb_steps) < numb_procs) {
+            numb_steps++;
         }
 
+        return numb_steps * model.alpha
+               + 2. * (numb_procs - 1) / numb_procs * numb_bytes * model.beta;
+    }
 
-        A_local.Allocate(sendcounts[rank]/cols,cols);
+    ________________________________________________________________________________
+
+//! @internal time of an allreduce (reduce-scatter + allgather) among numb_procs processors
+    double AllreduceCost(
+            int numb_procs,
+            double numb_bytes,
+            const NetworkModel &model) {
+
+        return BroadcastCost(numb_procs, numb_bytes, model)
+               + BroadcastCost(numb_procs, 0., model);
+    }
+
+    ________________________________________________________________________________
 
+//! @internal predicted communication time of an operation on a processor grid
+    double GridCost(
+            int numb_procs_i,
+            int numb_procs_j,
+            int numb_rows,
+            int numb_columns,
+            int numb_inner,
+            int operation,
+            const NetworkModel &model) {
+
+        const double m = numb_rows;
+        const double n = numb_columns;
+        const double k = (numb_inner > 0) ? numb_inner : numb_columns;
+
+        if (operation == operation::c_GEMM) {
+            // -- SUMMA, panels of (about) 64 columns of A and rows of B:
+            //    A panel along a processor row, B panel along a processor column
+            const double numb_panels = (k > 0) ? ceil(k / 64.) : 0.;
+            const double width = (k > 0) ? k / numb_panels : 0.;
+            return numb_panels * (BroadcastCost(numb_procs_j, 8. * m / numb_procs_i * width, model)
+                                  + BroadcastCost(numb_procs_i, 8. * width * n / numb_procs_j, model));
+        }
 
+        // -- GEMV: x (n / numb_procs_j) along a processor column,
+        //    partial y (m / numb_procs_i) summed along a processor row
+        return BroadcastCost(numb_procs_i, 8. * n / numb_procs_j, model)
+               + AllreduceCost(numb_procs_j, 8. * m / numb_procs_i, model);
+    }
 
+    ________________________________________________________________________________
 
-        MPI_Scatterv(A.GetCoef(), sendcounts, shifts, MPI_DOUBLE, A_local.GetCoef(), sendcounts[rank], MPI_DOUBLE, root,
-                     mpi_comm);
+//! @internal processor grid minimizing the predicted communication time
+    int GridDims(
+            int &numb_procs_i,
+            int &numb_procs_j,
+            int numb_procs,
+            int numb_rows,
+            int numb_columns,
+            int operation,
+            const NetworkModel &model,
+            int numb_inner) {
+
+        mathmrg::CreateDims(numb_procs_i, numb_procs_j, numb_procs);
+        double cost_min = GridCost(numb_procs_i, numb_procs_j, numb_rows, numb_columns,
+                                   numb_inner, operation, model);
+
+        for (int p_i = 1; p_i <= numb_procs; p_i++) {
+            if (numb_procs % p_i != 0) {
+                continue;
+            }
+            int p_j = numb_procs / p_i;
+            double cost = GridCost(p_i, p_j, numb_rows, numb_columns,
+                                   numb_inner, operation, model);
+            // -- strictly cheaper (relative): equal costs keep the squarest grid
+            if (cost < cost_min * (1. - 1.e-9)) {
+                cost_min = cost;
+                numb_procs_i = p_i;
+                numb_procs_j = p_j;
+            }
+        }
 
         return 0;
     }
 
     ________________________________________________________________________________
 
-//! @internal assemble matrix upon processors (band row)
-    int AssembleMatrixBandRow(
-            MatrixDense<double, int> &A_global,
-            const MatrixDense<double, int> &A,
-            int root,
+//! @internal communicator of the processors sharing a node
+    int NodeComm(
+            MPI_Comm &mpi_comm_node,
+            int &node_numb,
+            int &numb_nodes,
             MPI_Comm &mpi_comm) {
 
+        Context *context;
+        GetContext(context, mpi_comm);
+        if (context->mpi_comm_node != MPI_COMM_NULL) {
+            mpi_comm_node = context->mpi_comm_node;
+            node_numb = context->node_numb;
+            numb_nodes = context->numb_nodes;
+            return 0;
+        }
+
+        int rank;
+        MPI_Comm_rank(mpi_comm, &rank);
+        MPI_Comm_split_type(mpi_comm, MPI_COMM_TYPE_SHARED, rank, MPI_INFO_NULL,
+                            &mpi_comm_node);
+        int node_rank;
+        MPI_Comm_rank(mpi_comm_node, &node_rank);
+
+        // -- nodes are numbered by their lowest rank
+        MPI_Comm mpi_comm_leaders;
+        MPI_Comm_split(mpi_comm, (node_rank == 0) ? 0 : MPI_UNDEFINED, rank,
+                       &mpi_comm_leaders);
+        int node_info[2];
+        if (node_rank == 0) {
+            MPI_Comm_rank(mpi_comm_leaders, &node_info[0]);
+            MPI_Comm_size(mpi_comm_leaders, &node_info[1]);
+            MPI_Comm_free(&mpi_comm_leaders);
+        }
+        MPI_Bcast(node_info, 2, MPI_INT, 0, mpi_comm_node);
+        node_numb = node_info[0];
+        numb_nodes = node_info[1];
+
+        context->mpi_comm_node = mpi_comm_node;
+        context->node_numb = node_numb;
+        context->numb_nodes = numb_nodes;
 
         return 0;
     }
 
     ________________________________________________________________________________
 
-//! @internal build the 'band_numb'-th band (row) of a matrix
-    int BuildMatrixBandRow(
-            MatrixDense<double, int> &A_local,
-            const MatrixDense<double, int> &A,
-            const int numb_procs,
-            const int proc_numb) {
+//! @internal communicator whose ranks follow the nodes: processors of a node
+//         are consecutive
+    int NodePlacementComm(
+            MPI_Comm &mpi_comm_placed,
+            MPI_Comm &mpi_comm) {
+
+        int rank, nproc;
+        MPI_Comm_rank(mpi_comm, &rank);
+        MPI_Comm_size(mpi_comm, &nproc);
+
+        MPI_Comm mpi_comm_node;
+        int node_numb, numb_nodes;
+        NodeComm(mpi_comm_node, node_numb, numb_nodes, mpi_comm);
+
+        int node_numbs[nproc];
+        MPI_Allgather(&node_numb, 1, MPI_INT, node_numbs, 1, MPI_INT, mpi_comm);
+
+        // -- position of the processor when sorted by (node, rank)
+        int position = 0;
+        for (int q = 0; q < nproc; q++) {
+            if (node_numbs[q] < node_numb || (node_numbs[q] == node_numb && q < rank)) {
+                position++;
+            }
+        }
+
+        // -- the grid is filled row by row (row-major ranks): a row (reductions
+        //    of BlasMpi) stays on a node whenever numb_procs_j divides the
+        //    processors per node, a numb_procs_i x 1 grid packs its column
+        MPI_Comm_split(mpi_comm, 0, position, &mpi_comm_placed);
 
         return 0;
     }
 
     ________________________________________________________________________________
 
+//! @internal creation of a numb_procs_i x numb_procs_j grid communicator and
+//         communicators for each row and each column of the grid
+    int GridCartesianCommDims(
+            MPI_Comm &mpi_comm_rows,
+            MPI_Comm &mpi_comm_columns,
+            MPI_Comm &mpi_comm,
+            const int numb_procs_i,
+            const int numb_procs_j) {
+
+        // -- grid already created on this communicator
+        Context *context;
+        GetContext(context, mpi_comm);
+        std::pair<int, int> key(numb_procs_i, numb_procs_j);
+        std::map<std::pair<int, int>, ContextGrid>::iterator it = context->grids.find(key);
+        if (it != context->grids.end()) {
+            mpi_comm_rows = it->second.mpi_comm_rows;
+            mpi_comm_columns = it->second.mpi_comm_columns;
+            return 0;
+        }
 
-// -----------------------------------------------------------------------------
-// -- Matrix: BAND-COLUMN
-// -----------------------------------------------------------------------------
+        // -- number of cartesian dimensions (integer)
+        const int numb_dims = 2;
 
+        // -- integer array of size numb_dims specifying the number of nodes in each dimension
+        int grid_dims[numb_dims];
+        grid_dims[0] = numb_procs_i;
+        grid_dims[1] = numb_procs_j;
 
-//! @internal distribute matrix upon processors (band column)
-    int DistributeMatrixBandColumn(
-            MatrixDense<double, int> &A_local,
-            const MatrixDense<double, int> &A,
-            int root,
+        // -- create a new communicator with the layout of a cartesian grid
+        MPI_Comm mpi_comm_cart;
+        // logical array of size numb_dims specifying whether the grid is periodic or not in each dimension
+        int periods[numb_dims];
+        periods[0] = 0;
+        periods[1] = 0;
+        // -- explicit placement on the nodes (reorder is ignored by most MPI)
+        MPI_Comm mpi_comm_placed;
+        NodePlacementComm(mpi_comm_placed, mpi_comm);
+        MPI_Cart_create(mpi_comm_placed, numb_dims, grid_dims, periods, 0, &mpi_comm_cart);
+        MPI_Comm_free(&mpi_comm_placed);
+
+        // -- process number (process proc_numb)
+        int grid_proc_numb;
+        // -- get current process proc_numb
+        MPI_Comm_rank(mpi_comm_cart, &grid_proc_numb);
+
+        // -- get local coordinates on grid
+        // cartesian coordinates of specified process
+        int grid_coords[numb_dims];
+        grid_coords[0] = 0;
+        grid_coords[1] = 0;
+        MPI_Cart_coords(mpi_comm_cart, grid_proc_numb, numb_dims, grid_coords);
+
+        // -- create communicators that work across entire rows or columns
+        //  3 x 2 grid
+        // (0,0)=0 (1,0)=3
+        // (0,1)=1 (1,1)=4
+        // (0,2)=2 (1,2)=5
+        MPI_Comm_split(mpi_comm_cart, grid_coords[0], grid_coords[1],
+                       &mpi_comm_rows);
+        MPI_Comm_split(mpi_comm_cart, grid_coords[1], grid_coords[0],
+                       &mpi_comm_columns);
+
+        // -- attach the grid communicator to the rows and columns communicators
+        if (g_grid_keyval == MPI_KEYVAL_INVALID) {
+            MPI_Comm_create_keyval(MPI_COMM_NULL_COPY_FN, GridCommDeleteAttr,
+                                   &g_grid_keyval, NULL);
+        }
+        MPI_Comm_set_attr(mpi_comm_rows, g_grid_keyval, new GridAttr{mpi_comm_cart, mpi_comm});
+        MPI_Comm_set_attr(mpi_comm_columns, g_grid_keyval, new GridAttr{mpi_comm_cart, mpi_comm});
+
+        // -- the context owns the communicators
+        ContextGrid &grid = context->grids[key];
+        grid.mpi_comm_cart = mpi_comm_cart;
+        grid.mpi_comm_rows = mpi_comm_rows;
+        grid.mpi_comm_columns = mpi_comm_columns;
+
+        return 0;
+    }
+
+    ________________________________________________________________________________
+
+//! @internal creation of two-dimensional grid communicator and communicators
+//         for each row and each column of the grid (squarest grid)
+    int GridCartesianComm(
+            MPI_Comm &mpi_comm_rows,
+            MPI_Comm &mpi_comm_columns,
+            MPI_Comm &mpi_comm) {
+
+        // -- number of processors
+        int numb_procs;
+        // -- get number of processes
+        MPI_Comm_size(mpi_comm, &numb_procs);
+
+        int numb_procs_i, numb_procs_j;
+        mathmrg::CreateDims(numb_procs_i, numb_procs_j, numb_procs);
+
+        return GridCartesianCommDims(mpi_comm_rows, mpi_comm_columns, mpi_comm,
+                                     numb_procs_i, numb_procs_j);
+    }
+
+    ________________________________________________________________________________
+
+//! @internal creation of two-dimensional grid communicator and communicators
+//         for each row and each column of the grid (GridDims)
+    int GridCartesianComm(
+            MPI_Comm &mpi_comm_rows,
+            MPI_Comm &mpi_comm_columns,
+            MPI_Comm &mpi_comm,
+            int numb_rows,
+            int numb_columns,
+            int operation,
+            const NetworkModel &model,
+            int numb_inner) {
+
+        // -- number of processors
+        int numb_procs;
+        // -- get number of processes
+        MPI_Comm_size(mpi_comm, &numb_procs);
+
+        int numb_procs_i, numb_procs_j;
+        GridDims(numb_procs_i, numb_procs_j, numb_procs, numb_rows, numb_columns,
+                 operation, model, numb_inner);
+
+        return GridCartesianCommDims(mpi_comm_rows, mpi_comm_columns, mpi_comm,
+                                     numb_procs_i, numb_procs_j);
+    }
+
+    ________________________________________________________________________________
+
+//! @internal get the two-dimensional grid communicator attached to the grid rows
+//         (or columns) communicator by GridCartesianComm
+    int GridComm(
+            MPI_Comm &mpi_comm_grid,
+            MPI_Comm &mpi_comm_rows) {
+
+        if (g_grid_keyval == MPI_KEYVAL_INVALID) {
+            return 1;
+        }
+
+        void *attribute_val = NULL;
+        int flag = 0;
+        MPI_Comm_get_attr(mpi_comm_rows, g_grid_keyval, &attribute_val, &flag);
+        if (!flag) {
+            return 1;
+        }
+        mpi_comm_grid = static_cast<GridAttr *>(attribute_val)->mpi_comm_grid;
+
+        return 0;
+    }
+
+    ________________________________________________________________________________
+
+//! @internal rank in the grid communicator of a processor of the communicator
+//         the grid was created from
+    int GridRank(
+            int &grid_rank,
+            int rank,
+            MPI_Comm &mpi_comm_rows) {
+
+        if (g_grid_keyval == MPI_KEYVAL_INVALID) {
+            return 1;
+        }
+
+        void *attribute_val = NULL;
+        int flag = 0;
+        MPI_Comm_get_attr(mpi_comm_rows, g_grid_keyval, &attribute_val, &flag);
+        if (!flag) {
+            return 1;
+        }
+        GridAttr *grid = static_cast<GridAttr *>(attribute_val);
+
+        MPI_Group group, grid_group;
+        MPI_Comm_group(grid->mpi_comm, &group);
+        MPI_Comm_group(grid->mpi_comm_grid, &grid_group);
+        MPI_Group_translate_ranks(group, 1, &rank, grid_group, &grid_rank);
+        MPI_Group_free(&group);
+        MPI_Group_free(&grid_group);
+
+        return (grid_rank == MPI_UNDEFINED) ? 1 : 0;
+    }
+
+    ________________________________________________________________________________
+
+//! @internal intra- and inter-node pairs of processors of the lines (rows or
+//         columns) of a grid, counted once by the first processor of each line
+    int LineNodeEdges(
+            int &numb_edges_intra,
+            int &numb_edges_inter,
+            const int node_numb,
+            MPI_Comm &mpi_comm_line) {
+
+        int line_rank, line_size;
+        MPI_Comm_rank(mpi_comm_line, &line_rank);
+        MPI_Comm_size(mpi_comm_line, &line_size);
+
+        int node_numbs[line_size];
+        MPI_Allgather(&node_numb, 1, MPI_INT, node_numbs, 1, MPI_INT, mpi_comm_line);
+
+        numb_edges_intra = 0;
+        numb_edges_inter = 0;
+        if (line_rank == 0) {
+            for (int p = 0; p < line_size; p++) {
+                for (int q = p + 1; q < line_size; q++) {
+                    if (node_numbs[p] == node_numbs[q]) {
+                        numb_edges_intra++;
+                    } else {
+                        numb_edges_inter++;
+                    }
+                }
+            }
+        }
+
+        return 0;
+    }
+
+    ________________________________________________________________________________
+
+//! @internal intra- and inter-node edges of the rows and columns of a grid
+    int GridNodeEdges(
+            int &numb_edges_intra_rows,
+            int &numb_edges_inter_rows,
+            int &numb_edges_intra_columns,
+            int &numb_edges_inter_columns,
+            MPI_Comm &mpi_comm_rows,
+            MPI_Comm &mpi_comm_columns) {
+
+        MPI_Comm mpi_comm_grid;
+        if (GridComm(mpi_comm_grid, mpi_comm_rows) != 0) {
+            return 1;
+        }
+
+        MPI_Comm mpi_comm_node;
+        int node_numb, numb_nodes;
+        NodeComm(mpi_comm_node, node_numb, numb_nodes, mpi_comm_grid);
+
+        int edges[4];
+        LineNodeEdges(edges[0], edges[1], node_numb, mpi_comm_rows);
+        LineNodeEdges(edges[2], edges[3], node_numb, mpi_comm_columns);
+        MPI_Allreduce(MPI_IN_PLACE, edges, 4, MPI_INT, MPI_SUM, mpi_comm_grid);
+
+        numb_edges_intra_rows = edges[0];
+        numb_edges_inter_rows = edges[1];
+        numb_edges_intra_columns = edges[2];
+        numb_edges_inter_columns = edges[3];
+
+        return 0;
+    }
+
+    ________________________________________________________________________________
+
+// -----------------------------------------------------------------------------
+// -- block-cyclic distribution - topology
+// -----------------------------------------------------------------------------
+
+//! @internal number of local indices owned by a processor (block-cyclic)
+    int CyclicSize(
+            int proc_numb,
+            int numb_procs,
+            int block_size,
+            int size) {
+
+        // -- number of whole blocks
+        int numb_blocks = size / block_size;
+        // -- whole rounds of blocks over all processors
+        int size_local = (numb_blocks / numb_procs) * block_size;
+        // -- remaining blocks (the last one may be partial)
+        int numb_extra_blocks = numb_blocks % numb_procs;
+        if (proc_numb < numb_extra_blocks) {
+            size_local += block_size;
+        } else if (proc_numb == numb_extra_blocks) {
+            size_local += size % block_size;
+        }
+
+        return size_local;
+    }
+
+    ________________________________________________________________________________
+
+//! @internal local to global index (block-cyclic)
+    int CyclicLocalToGlobal(
+            int idx_local,
+            int proc_numb,
+            int numb_procs,
+            int block_size) {
+
+        return (idx_local / block_size) * numb_procs * block_size
+               + proc_numb * block_size + idx_local % block_size;
+    }
+
+    ________________________________________________________________________________
+
+//! @internal global to local index (block-cyclic)
+    int CyclicGlobalToLocal(
+            int idx_global,
+            int numb_procs,
+            int block_size) {
+
+        return (idx_global / (numb_procs * block_size)) * block_size
+               + idx_global % block_size;
+    }
+
+    ________________________________________________________________________________
+
+//! @internal owner processor of a global index (block-cyclic)
+    int CyclicGlobalToProc(
+            int idx_global,
+            int numb_procs,
+            int block_size) {
+
+        return (idx_global / block_size) % numb_procs;
+    }
+
+    ________________________________________________________________________________
+
+//! @internal datatype selecting the part of a processor inside the global
+//         row-major matrix (block-cyclic)
+//! @remarks proc_numb follows row major order (as the cartesian grid)
+    int BlockCyclicType(
+            MPI_Datatype &mpi_type,
+            int numb_rows,
+            int numb_columns,
+            int block_rows,
+            int block_columns,
+            int numb_procs_i,
+            int numb_procs_j,
+            int proc_numb) {
+
+        int grid_sizes[2] = {numb_rows, numb_columns};
+        int grid_distribs[2] = {MPI_DISTRIBUTE_CYCLIC, MPI_DISTRIBUTE_CYCLIC};
+        int grid_dargs[2] = {block_rows, block_columns};
+        int grid_procs[2] = {numb_procs_i, numb_procs_j};
+
+        MPI_Type_create_darray(numb_procs_i * numb_procs_j, proc_numb, 2,
+                               grid_sizes, grid_distribs, grid_dargs, grid_procs,
+                               MPI_ORDER_C, MPI_DOUBLE, &mpi_type);
+        MPI_Type_commit(&mpi_type);
+
+        return 0;
+    }
+
+    ________________________________________________________________________________
+
+// -----------------------------------------------------------------------------
+// -- distribution
+// -----------------------------------------------------------------------------
+
+//! @internal create a distribution from a processor grid
+    int CreateDistribution(
+            Distribution &dist,
+            int type,
+            int numb_rows,
+            int numb_columns,
+            int numb_procs_i,
+            int numb_procs_j,
+            int proc_numb_i,
+            int proc_numb_j,
+            int block_rows,
+            int block_columns) {
+
+        dist.type = type;
+        dist.numb_rows = numb_rows;
+        dist.numb_columns = numb_columns;
+        dist.numb_procs_i = numb_procs_i;
+        dist.numb_procs_j = numb_procs_j;
+        dist.proc_numb_i = proc_numb_i;
+        dist.proc_numb_j = proc_numb_j;
+        dist.block_rows = block_rows;
+        dist.block_columns = block_columns;
+
+        return 0;
+    }
+
+    ________________________________________________________________________________
+
+//! @internal create a band distribution (band-row or band-column)
+    int CreateDistribution(
+            Distribution &dist,
+            int type,
+            int numb_rows,
+            int numb_columns,
+            MPI_Comm &mpi_comm) {
+
+        int rank, nproc;
+        MPI_Comm_rank(mpi_comm, &rank);
+        MPI_Comm_size(mpi_comm, &nproc);
+
+        if (type == distribution::c_BAND_ROW) {
+            return CreateDistribution(dist, type, numb_rows, numb_columns,
+                                      nproc, 1, rank, 0);
+        }
+        if (type == distribution::c_BAND_COLUMN) {
+            return CreateDistribution(dist, type, numb_rows, numb_columns,
+                                      1, nproc, 0, rank);
+        }
+
+        return 1;
+    }
+
+    ________________________________________________________________________________
+
+//! @internal create a grid distribution (block or block-cyclic)
+    int CreateDistribution(
+            Distribution &dist,
+            int type,
+            int numb_rows,
+            int numb_columns,
+            MPI_Comm &mpi_comm_rows,
+            MPI_Comm &mpi_comm_columns,
+            int block_rows,
+            int block_columns) {
+
+        int numb_procs_i, numb_procs_j, proc_numb_i, proc_numb_j;
+        MPI_Comm_size(mpi_comm_columns, &numb_procs_i);
+        MPI_Comm_rank(mpi_comm_columns, &proc_numb_i);
+        MPI_Comm_size(mpi_comm_rows, &numb_procs_j);
+        MPI_Comm_rank(mpi_comm_rows, &proc_numb_j);
+
+        return CreateDistribution(dist, type, numb_rows, numb_columns,
+                                  numb_procs_i, numb_procs_j,
+                                  proc_numb_i, proc_numb_j,
+                                  block_rows, block_columns);
+    }
+
+    ________________________________________________________________________________
+
+//! @internal local number of rows
+    int LocalNumbRows(
+            const Distribution &dist) {
+
+        if (dist.type == distribution::c_BLOCK_CYCLIC) {
+            return CyclicSize(dist.proc_numb_i, dist.numb_procs_i,
+                              dist.block_rows, dist.numb_rows);
+        }
+
+        return BandSize(dist.proc_numb_i, dist.numb_procs_i, dist.numb_rows);
+    }
+
+    ________________________________________________________________________________
+
+//! @internal local number of columns
+    int LocalNumbColumns(
+            const Distribution &dist) {
+
+        if (dist.type == distribution::c_BLOCK_CYCLIC) {
+            return CyclicSize(dist.proc_numb_j, dist.numb_procs_j,
+                              dist.block_columns, dist.numb_columns);
+        }
+
+        return BandSize(dist.proc_numb_j, dist.numb_procs_j, dist.numb_columns);
+    }
+
+    ________________________________________________________________________________
+
+//! @internal local to global row index
+    int LocalToGlobalRow(
+            const Distribution &dist,
+            int idx_local) {
+
+        if (dist.type == distribution::c_BLOCK_CYCLIC) {
+            return CyclicLocalToGlobal(idx_local, dist.proc_numb_i,
+                                       dist.numb_procs_i, dist.block_rows);
+        }
+
+        return BandPos(dist.proc_numb_i, dist.numb_procs_i, dist.numb_rows)
+               + idx_local;
+    }
+
+    ________________________________________________________________________________
+
+//! @internal local to global column index
+    int LocalToGlobalColumn(
+            const Distribution &dist,
+            int idy_local) {
+
+        if (dist.type == distribution::c_BLOCK_CYCLIC) {
+            return CyclicLocalToGlobal(idy_local, dist.proc_numb_j,
+                                       dist.numb_procs_j, dist.block_columns);
+        }
+
+        return BandPos(dist.proc_numb_j, dist.numb_procs_j, dist.numb_columns)
+               + idy_local;
+    }
+
+    ________________________________________________________________________________
+
+// -----------------------------------------------------------------------------
+// -- Vector: BAND
+// -----------------------------------------------------------------------------
+
+//! @internal distribute vector upon processors
+    int DistributeVectorBand(
+            Vector<double, int> &x_local,
+            const Vector<double, int> &x,
+            int root,
+            MPI_Comm &mpi_comm) {
+        TRACE_SCOPE("DistributeVectorBand");
+        MEMORY_TAG("DistributeVectorBand");
+
+        int rank, nproc;
+        MPI_Comm_rank(mpi_comm, &rank);
+        MPI_Comm_size(mpi_comm, &nproc);
+
+        int vector_size;
+        if(rank == root)
+            vector_size = x.GetSize();
+        TRACE_BEGIN("metadata");
+        MPI_Bcast(&vector_size,1,MPI_INT,root,mpi_comm);
+        TRACE_END();
+
+        int sendcounts[nproc];
+        int displs[nproc];
+        for (int i = 0; i < nproc; i++) {
+            sendcounts[i] = BandSize(i, nproc, vector_size);
+        }
+
+        for(int i = 0; i < nproc; i++){
+            if(i == 0)
+                displs[i] = 0;
+            else
+                displs[i] = displs[i-1]+sendcounts[i-1];
+        }
+
+
+        x_local.Allocate(sendcounts[rank]);
+
+        TRACE_BEGIN("communication");
+        MPI_Scatterv(x.GetCoef(),sendcounts,displs,MPI_DOUBLE, x_local.GetCoef(), sendcounts[rank], MPI_DOUBLE, root, mpi_comm);
+        TRACE_END();
+
+
+
+
+        return 0;
+    }
+
+    ________________________________________________________________________________
+
+//! @internal distribute vector upon processors (weighted band)
+    int DistributeVectorBand(
+            Vector<double, int> &x_local,
+            const Vector<double, int> &x,
+            int root,
+            MPI_Comm &mpi_comm,
+            const Vector<double, int> &weights) {
+        TRACE_SCOPE("DistributeVectorBand");
+        MEMORY_TAG("DistributeVectorBand");
+
+        int rank, nproc;
+        MPI_Comm_rank(mpi_comm, &rank);
+        MPI_Comm_size(mpi_comm, &nproc);
+        if (weights.GetSize() != nproc) {
+            return 1;
+        }
+
+        int vector_size;
+        if (rank == root)
+            vector_size = x.GetSize();
+        TRACE_BEGIN("metadata");
+        MPI_Bcast(&vector_size, 1, MPI_INT, root, mpi_comm);
+        TRACE_END();
+
+        int *displs, *sendcounts;
+        BandTopology(displs, sendcounts, vector_size, weights);
+
+        x_local.Allocate(sendcounts[rank]);
+
+        TRACE_BEGIN("communication");
+        MPI_Scatterv(x.GetCoef(), sendcounts, displs, MPI_DOUBLE, x_local.GetCoef(), sendcounts[rank], MPI_DOUBLE, root, mpi_comm);
+        TRACE_END();
+
+        delete[] displs;
+        delete[] sendcounts;
+
+        return 0;
+    }
+
+    ________________________________________________________________________________
+
+//! @internal assemble vector upon processors
+    int AssembleVectorBand(
+            Vector<double, int> &x_global,
+            const Vector<double, int> &x,
+            int root,
+            MPI_Comm &mpi_comm) {
+        TRACE_SCOPE("AssembleVectorBand");
+        MEMORY_TAG("AssembleVectorBand");
+        int rank, nproc;
+        MPI_Comm_rank(mpi_comm, &rank);
+        MPI_Comm_size(mpi_comm, &nproc);
+
+        int* recvcounts = new int[nproc];
+        int* shifts = new int[nproc];
+        int* ones = new int[nproc];
+        int* idty = new int[nproc];
+        for(int i = 0; i < nproc; i++){
+            ones[i] = 1;
+            idty[i] = i;
+        }
+        int size = x.GetSize();
+        int total_size = 0;
+        TRACE_BEGIN("metadata");
+        MPI_Gatherv(&size,1,MPI_INT,recvcounts,ones,idty,MPI_INT,root,mpi_comm);
+        TRACE_END();
+        // -- counts are only known on root
+        if (rank == root) {
+            for(int i = 0; i < nproc; i++){
+                if(i == 0)
+                    shifts[i] = 0;
+                else
+                    shifts[i] = shifts[i-1]+recvcounts[i-1];
+                total_size += recvcounts[i];
+            }
+            x_global.Allocate(total_size);
+        }
+
+        TRACE_BEGIN("communication");
+        MPI_Gatherv(x.GetCoef(),x.GetSize(),MPI_DOUBLE,x_global.GetCoef(),recvcounts,shifts,MPI_DOUBLE,root,mpi_comm);
+        TRACE_END();
+
+        delete[] recvcounts;
+        delete[] shifts;
+        delete[] ones;
+        delete[] idty;
+
+
+        return 0;
+    }
+
+    ________________________________________________________________________________
+
+//! @internal build the 'band_numb'-th band
+    template<class T, class U>
+    int BuildVectorBand(
+            Vector<double, int> &x_local,
+            const Vector<double, int> &x,
+            const int numb_procs,
+            const int proc_numb) {
+
+        // -- size of the global vector
+        int size = x.GetSize();
+
+        // -- compute the number of rows per band
+        int size_local = BandSize(proc_numb, numb_procs, size);
+        // -- allocate and fill out the local vector
+        x_local.Allocate(size_local);
+        for (U i = 0; i < size_local; i++) {
+            // local (i) to global indice (l2g_i)
+            int l2g_i = BandPos(proc_numb, numb_procs, size) + i;
+            x_local(i) = x(l2g_i);
+        }
+
+        return 0;
+    }
+
+    ________________________________________________________________________________
+
+
+// -----------------------------------------------------------------------------
+// -- Matrix: BAND-ROW
+// -----------------------------------------------------------------------------
+
+//! @internal distribute matrix upon processors (band row)
+    int DistributeMatrixBandRow(
+            MatrixDense<double, int> &A_local,
+            const MatrixDense<double, int> &A,
+            int root,
+            MPI_Comm &mpi_comm) {
+        TRACE_SCOPE("DistributeMatrixBandRow");
+        MEMORY_TAG("DistributeMatrixBandRow");
+
+        int rank, nproc;
+        MPI_Comm_rank(mpi_comm, &rank);
+        MPI_Comm_size(mpi_comm, &nproc);
+
+        int rows, cols;
+        if (rank == root) {
+            rows = A.GetNumbRows();
+            cols = A.GetNumbColumns();
+        }
+
+
+        TRACE_BEGIN("metadata");
+        MPI_Bcast(&rows, 1, MPI_INT, root, mpi_comm);
+        MPI_Bcast(&cols, 1, MPI_INT, root, mpi_comm);
+        TRACE_END();
+
+
+        int sendcounts[nproc];
+        int shifts[nproc];
+        for (int i = 0; i < nproc; i++) {
+            sendcounts[i] = BandSize(i, nproc, rows) * cols;
+        }
+
+        for(int i = 0; i < nproc; i++){
+            if(i == 0)
+                shifts[i] = 0;
+            else
+                shifts[i] = shifts[i-1]+sendcounts[i-1];
+        }
+
+
+        A_local.Allocate(sendcounts[rank]/cols,cols);
+
+
+
+
+        TRACE_BEGIN("communication");
+        MPI_Scatterv(A.GetCoef(), sendcounts, shifts, MPI_DOUBLE, A_local.GetCoef(), sendcounts[rank], MPI_DOUBLE, root,
+                     mpi_comm);
+        TRACE_END();
+
+        return 0;
+    }
+
+    ________________________________________________________________________________
+
+//! @internal distribute matrix upon processors (weighted band row)
+    int DistributeMatrixBandRow(
+            MatrixDense<double, int> &A_local,
+            const MatrixDense<double, int> &A,
+            int root,
+            MPI_Comm &mpi_comm,
+            const Vector<double, int> &weights) {
+        TRACE_SCOPE("DistributeMatrixBandRow");
+        MEMORY_TAG("DistributeMatrixBandRow");
+
+        int rank, nproc;
+        MPI_Comm_rank(mpi_comm, &rank);
+        MPI_Comm_size(mpi_comm, &nproc);
+        if (weights.GetSize() != nproc) {
+            return 1;
+        }
+
+        int dims[2];
+        if (rank == root) {
+            dims[0] = A.GetNumbRows();
+            dims[1] = A.GetNumbColumns();
+        }
+        TRACE_BEGIN("metadata");
+        MPI_Bcast(dims, 2, MPI_INT, root, mpi_comm);
+        TRACE_END();
+
+        // -- bands of rows, counted in elements
+        int *shifts, *sendcounts;
+        BandTopology(shifts, sendcounts, dims[0], weights, dims[1]);
+
+        A_local.Allocate((dims[1] > 0) ? sendcounts[rank] / dims[1] : 0, dims[1]);
+
+        TRACE_BEGIN("communication");
+        MPI_Scatterv(A.GetCoef(), sendcounts, shifts, MPI_DOUBLE, A_local.GetCoef(), sendcounts[rank], MPI_DOUBLE, root,
+                     mpi_comm);
+        TRACE_END();
+
+        delete[] shifts;
+        delete[] sendcounts;
+
+        return 0;
+    }
+
+    ________________________________________________________________________________
+
+//! @internal assemble matrix upon processors (band row)
+    int AssembleMatrixBandRow(
+            MatrixDense<double, int> &A_global,
+            const MatrixDense<double, int> &A,
+            int root,
+            MPI_Comm &mpi_comm) {
+        TRACE_SCOPE("AssembleMatrixBandRow");
+        MEMORY_TAG("AssembleMatrixBandRow");
+
+        int rank, nproc;
+        MPI_Comm_rank(mpi_comm, &rank);
+        MPI_Comm_size(mpi_comm, &nproc);
+
+        int cols = A.GetNumbColumns();
+        int size = A.GetNumbRows() * cols;
+
+        int recvcounts[nproc];
+        int shifts[nproc];
+        TRACE_BEGIN("metadata");
+        MPI_Gather(&size, 1, MPI_INT, recvcounts, 1, MPI_INT, root, mpi_comm);
+        TRACE_END();
+
+        if (rank == root) {
+            int total_size = 0;
+            for (int i = 0; i < nproc; i++) {
+                shifts[i] = total_size;
+                total_size += recvcounts[i];
+            }
+            A_global.Allocate((cols > 0) ? total_size / cols : 0, cols);
+        }
+
+        TRACE_BEGIN("communication");
+        MPI_Gatherv(A.GetCoef(), size, MPI_DOUBLE, A_global.GetCoef(), recvcounts, shifts,
+                    MPI_DOUBLE, root, mpi_comm);
+        TRACE_END();
+
+        return 0;
+    }
+
+    ________________________________________________________________________________
+
+//! @internal build the 'band_numb'-th band (row) of a matrix
+    int BuildMatrixBandRow(
+            MatrixDense<double, int> &A_local,
+            const MatrixDense<double, int> &A,
+            const int numb_procs,
+            const int proc_numb) {
+
+        return 0;
+    }
+
+    ________________________________________________________________________________
+
+// -----------------------------------------------------------------------------
+// -- Non-blocking BAND (request handles)
+// -----------------------------------------------------------------------------
+
+//! @internal release a (completed) request handle
+    int FreeRequest(
+            Request &request) {
+
+        delete[] request.mpi_requests;
+        delete[] request.counts;
+        delete[] request.shifts;
+        delete[] request.chunk_rows;
+        request.numb_chunks = 0;
+        request.mpi_requests = NULL;
+        request.counts = NULL;
+        request.shifts = NULL;
+        request.chunk_rows = NULL;
+
+        return 0;
+    }
+
+    ________________________________________________________________________________
+
+//! @internal allocate a request handle
+//! @remarks the arrays of a completed request are released first; a request
+//           still active is kept and 1 is returned
+    int CreateRequest(
+            Request &request,
+            int numb_chunks,
+            int nproc) {
+
+        for (int c = 0; c < request.numb_chunks; c++) {
+            if (request.mpi_requests[c] != MPI_REQUEST_NULL) {
+                return 1;
+            }
+        }
+        FreeRequest(request);
+
+        request.numb_chunks = numb_chunks;
+        request.mpi_requests = new MPI_Request[numb_chunks];
+        request.counts = new int[numb_chunks * nproc];
+        request.shifts = new int[numb_chunks * nproc];
+        request.chunk_rows = new int[numb_chunks + 1];
+        for (int c = 0; c < numb_chunks; c++) {
+            request.mpi_requests[c] = MPI_REQUEST_NULL;
+        }
+
+        return 0;
+    }
+
+    ________________________________________________________________________________
+
+//! @internal scatter bands of rows, one MPI_Iscatterv per chunk of rows
+//! @remarks row_size = number of elements of a row (1 for a vector)
+    int IDistributeBand(
+            double *coef_local,
+            const double *coef,
+            int numb_rows,
+            int row_size,
+            int root,
+            MPI_Comm &mpi_comm,
+            Request &request,
+            int numb_chunks) {
+
+        int rank, nproc;
+        MPI_Comm_rank(mpi_comm, &rank);
+        MPI_Comm_size(mpi_comm, &nproc);
+
+        numb_chunks = (numb_chunks < 1) ? 1 : numb_chunks;
+        if (CreateRequest(request, numb_chunks, nproc) != 0) {
+            return 1;
+        }
+
+        // -- chunk c of band k: rows BandPos(c) .. of the band
+        for (int c = 0; c < numb_chunks; c++) {
+            int *counts = request.counts + c * nproc;
+            int *shifts = request.shifts + c * nproc;
+            for (int k = 0; k < nproc; k++) {
+                int band_size = BandSize(k, nproc, numb_rows);
+                counts[k] = BandSize(c, numb_chunks, band_size) * row_size;
+                shifts[k] = (BandPos(k, nproc, numb_rows) +
+                             BandPos(c, numb_chunks, band_size)) * row_size;
+            }
+        }
+        int band_size = BandSize(rank, nproc, numb_rows);
+        for (int c = 0; c <= numb_chunks; c++) {
+            request.chunk_rows[c] = BandPos(c, numb_chunks, band_size);
+        }
+
+        for (int c = 0; c < numb_chunks; c++) {
+            MPI_Iscatterv(coef, request.counts + c * nproc, request.shifts + c * nproc,
+                          MPI_DOUBLE,
+                          coef_local + request.chunk_rows[c] * row_size,
+                          request.counts[c * nproc + rank], MPI_DOUBLE,
+                          root, mpi_comm, &request.mpi_requests[c]);
+        }
+
+        return 0;
+    }
+
+    ________________________________________________________________________________
+
+//! @internal distribute vector upon processors (band, non-blocking)
+    int IDistributeVectorBand(
+            Vector<double, int> &x_local,
+            const Vector<double, int> &x,
+            int root,
+            MPI_Comm &mpi_comm,
+            Request &request,
+            int numb_chunks) {
+        MEMORY_TAG("IDistributeVectorBand");
+
+        int rank, nproc;
+        MPI_Comm_rank(mpi_comm, &rank);
+        MPI_Comm_size(mpi_comm, &nproc);
+
+        int vector_size;
+        if (rank == root)
+            vector_size = x.GetSize();
+        MPI_Bcast(&vector_size, 1, MPI_INT, root, mpi_comm);
+
+        x_local.Allocate(BandSize(rank, nproc, vector_size));
+
+        return IDistributeBand(x_local.GetCoef(), x.GetCoef(), vector_size, 1,
+                               root, mpi_comm, request, numb_chunks);
+    }
+
+    ________________________________________________________________________________
+
+//! @internal distribute matrix upon processors (band row, non-blocking)
+    int IDistributeMatrixBandRow(
+            MatrixDense<double, int> &A_local,
+            const MatrixDense<double, int> &A,
+            int root,
+            MPI_Comm &mpi_comm,
+            Request &request,
+            int numb_chunks) {
+        MEMORY_TAG("IDistributeMatrixBandRow");
+
+        int rank, nproc;
+        MPI_Comm_rank(mpi_comm, &rank);
+        MPI_Comm_size(mpi_comm, &nproc);
+
+        int dims[2];
+        if (rank == root) {
+            dims[0] = A.GetNumbRows();
+            dims[1] = A.GetNumbColumns();
+        }
+        MPI_Bcast(dims, 2, MPI_INT, root, mpi_comm);
+
+        A_local.Allocate(BandSize(rank, nproc, dims[0]), dims[1]);
+
+        return IDistributeBand(A_local.GetCoef(), A.GetCoef(), dims[0], dims[1],
+                               root, mpi_comm, request, numb_chunks);
+    }
+
+    ________________________________________________________________________________
+
+//! @internal assemble vector upon processors (band, non-blocking)
+    int IAssembleVectorBand(
+            Vector<double, int> &x_global,
+            const Vector<double, int> &x,
+            int root,
+            MPI_Comm &mpi_comm,
+            Request &request) {
+        MEMORY_TAG("IAssembleVectorBand");
+
+        int rank, nproc;
+        MPI_Comm_rank(mpi_comm, &rank);
+        MPI_Comm_size(mpi_comm, &nproc);
+
+        if (CreateRequest(request, 1, nproc) != 0) {
+            return 1;
+        }
+
+        int size = x.GetSize();
+        MPI_Gather(&size, 1, MPI_INT, request.counts, 1, MPI_INT, root, mpi_comm);
+        // -- counts are only known on root
+        if (rank == root) {
+            int total_size = 0;
+            for (int k = 0; k < nproc; k++) {
+                request.shifts[k] = total_size;
+                total_size += request.counts[k];
+            }
+            x_global.Allocate(total_size);
+        }
+        request.chunk_rows[0] = 0;
+        request.chunk_rows[1] = (rank == root) ? x_global.GetSize() : 0;
+
+        MPI_Igatherv(x.GetCoef(), size, MPI_DOUBLE,
+                     x_global.GetCoef(), request.counts, request.shifts, MPI_DOUBLE,
+                     root, mpi_comm, &request.mpi_requests[0]);
+
+        return 0;
+    }
+
+    ________________________________________________________________________________
+
+//! @internal test the completion of all chunks of a request
+    int TestRequest(
+            Request &request,
+            bool &flag) {
+
+        int is_complete = 1;
+        if (request.numb_chunks > 0) {
+            MPI_Testall(request.numb_chunks, request.mpi_requests, &is_complete,
+                        MPI_STATUSES_IGNORE);
+        }
+        flag = (is_complete != 0);
+        if (flag && request.mpi_requests != NULL) {
+            FreeRequest(request);
+        }
+
+        return 0;
+    }
+
+    ________________________________________________________________________________
+
+//! @internal wait the completion of all chunks of a request
+    int WaitRequest(
+            Request &request) {
+
+        if (request.mpi_requests == NULL) {
+            return 0;
+        }
+        MPI_Waitall(request.numb_chunks, request.mpi_requests, MPI_STATUSES_IGNORE);
+        FreeRequest(request);
+
+        return 0;
+    }
+
+    ________________________________________________________________________________
+
+//! @internal test the completion of a chunk of a request
+    int TestRequestChunk(
+            Request &request,
+            int chunk_numb,
+            bool &flag,
+            int &row_begin,
+            int &numb_rows) {
+
+        if (chunk_numb < 0 || chunk_numb >= request.numb_chunks) {
+            return 1;
+        }
+
+        int is_complete;
+        MPI_Test(&request.mpi_requests[chunk_numb], &is_complete, MPI_STATUS_IGNORE);
+        flag = (is_complete != 0);
+        row_begin = request.chunk_rows[chunk_numb];
+        numb_rows = request.chunk_rows[chunk_numb + 1] - row_begin;
+
+        return 0;
+    }
+
+    ________________________________________________________________________________
+
+//! @internal wait the completion of a chunk of a request
+    int WaitRequestChunk(
+            Request &request,
+            int chunk_numb,
+            int &row_begin,
+            int &numb_rows) {
+
+        if (chunk_numb < 0 || chunk_numb >= request.numb_chunks) {
+            return 1;
+        }
+
+        MPI_Wait(&request.mpi_requests[chunk_numb], MPI_STATUS_IGNORE);
+        row_begin = request.chunk_rows[chunk_numb];
+        numb_rows = request.chunk_rows[chunk_numb + 1] - row_begin;
+
+        return 0;
+    }
+
+    ________________________________________________________________________________
+
+
+// -----------------------------------------------------------------------------
+// -- Matrix: BAND-COLUMN
+// -----------------------------------------------------------------------------
+
+//! @internal datatype of a band of columns inside a row-major matrix
+//! @remarks rows of the band are traversed in memory order
+    int BandColumnType(
+            MPI_Datatype &mpi_type,
+            int numb_rows,
+            int numb_columns_band,
+            int numb_columns) {
+
+        MPI_Type_vector(numb_rows, numb_columns_band, numb_columns, MPI_DOUBLE,
+                        &mpi_type);
+        MPI_Type_commit(&mpi_type);
+
+        return 0;
+    }
+
+    ________________________________________________________________________________
+
+
+//! @internal distribute matrix upon processors (band column)
+    int DistributeMatrixBandColumn(
+            MatrixDense<double, int> &A_local,
+            const MatrixDense<double, int> &A,
+            int root,
+            MPI_Comm &mpi_comm) {
+        TRACE_SCOPE("DistributeMatrixBandColumn");
+        MEMORY_TAG("DistributeMatrixBandColumn");
+
+        int rank, nproc;
+        MPI_Comm_rank(mpi_comm, &rank);
+        MPI_Comm_size(mpi_comm, &nproc);
+
+        int rows, cols;
+        if (rank == root) {
+            rows = A.GetNumbRows();
+            cols = A.GetNumbColumns();
+        }
+
+
+        TRACE_BEGIN("metadata");
+        MPI_Bcast(&rows, 1, MPI_INT, root, mpi_comm);
+        MPI_Bcast(&cols, 1, MPI_INT, root, mpi_comm);
+        TRACE_END();
+
+
+        // -- number of columns (count) and first column (displacement) of each band
+        int sendcounts[nproc];
+        int shifts[nproc];
+        for (int i = 0; i < nproc; i++) {
+            sendcounts[i] = BandSize(i, nproc, cols);
+            shifts[i] = BandPos(i, nproc, cols);
+        }
+
+        A_local.Allocate(rows, sendcounts[rank]);
+
+        // -- root sends one strided band per processor, others only receive
+        int counts[nproc];
+        int byte_shifts[nproc];
+        MPI_Datatype types[nproc];
+        int recvcounts[nproc];
+        int recvshifts[nproc];
+        MPI_Datatype recvtypes[nproc];
+        for (int i = 0; i < nproc; i++) {
+            counts[i] = 0;
+            byte_shifts[i] = 0;
+            types[i] = MPI_DOUBLE;
+            recvcounts[i] = 0;
+            recvshifts[i] = 0;
+            recvtypes[i] = MPI_DOUBLE;
+        }
+        TRACE_BEGIN("pack");
+        if (rank == root) {
+            for (int i = 0; i < nproc; i++) {
+                BandColumnType(types[i], rows, sendcounts[i], cols);
+                counts[i] = 1;
+                byte_shifts[i] = shifts[i] * sizeof(double);
+            }
+        }
+        TRACE_END();
+        recvcounts[root] = rows * sendcounts[rank];
+
+        // -- all bands in a single collective, no packing on root
+        TRACE_BEGIN("communication");
+        MPI_Alltoallw(A.GetCoef(), counts, byte_shifts, types,
+                      A_local.GetCoef(), recvcounts, recvshifts, recvtypes,
+                      mpi_comm);
+        TRACE_END();
+
+        if (rank == root) {
+            for (int i = 0; i < nproc; i++) {
+                MPI_Type_free(&types[i]);
+            }
+        }
+
+        return 0;
+    }
+
+    ________________________________________________________________________________
+
+//! @internal assemble matrix upon processors (band column)
+    int AssembleMatrixBandColumn(
+            MatrixDense<double, int> &A_global,
+            const MatrixDense<double, int> &A,
+            int root,
+            MPI_Comm &mpi_comm) {
+        TRACE_SCOPE("AssembleMatrixBandColumn");
+        MEMORY_TAG("AssembleMatrixBandColumn");
+
+        int rank, nproc;
+        MPI_Comm_rank(mpi_comm, &rank);
+        MPI_Comm_size(mpi_comm, &nproc);
+
+        int rows = A.GetNumbRows();
+        int cols_local = A.GetNumbColumns();
+
+        // -- number of columns (count) and first column (displacement) of each band
+        int recvcounts[nproc];
+        int shifts[nproc];
+        TRACE_BEGIN("metadata");
+        MPI_Gather(&cols_local, 1, MPI_INT, recvcounts, 1, MPI_INT, root, mpi_comm);
+        TRACE_END();
+        int cols = 0;
+        if (rank == root) {
+            for (int i = 0; i < nproc; i++) {
+                shifts[i] = cols;
+                cols += recvcounts[i];
+            }
+        }
+
+        // -- others send their band, root receives one strided band per processor
+        int sendcounts[nproc];
+        int sendshifts[nproc];
+        MPI_Datatype sendtypes[nproc];
+        int counts[nproc];
+        int byte_shifts[nproc];
+        MPI_Datatype types[nproc];
+        for (int i = 0; i < nproc; i++) {
+            sendcounts[i] = 0;
+            sendshifts[i] = 0;
+            sendtypes[i] = MPI_DOUBLE;
+            counts[i] = 0;
+            byte_shifts[i] = 0;
+            types[i] = MPI_DOUBLE;
+        }
+        sendcounts[root] = rows * cols_local;
+        TRACE_BEGIN("pack");
+        if (rank == root) {
+            A_global.Allocate(rows, cols);
+            for (int i = 0; i < nproc; i++) {
+                BandColumnType(types[i], rows, recvcounts[i], cols);
+                counts[i] = 1;
+                byte_shifts[i] = shifts[i] * sizeof(double);
+            }
+        }
+        TRACE_END();
+
+        // -- all bands in a single collective, no unpacking on root
+        TRACE_BEGIN("communication");
+        MPI_Alltoallw(A.GetCoef(), sendcounts, sendshifts, sendtypes,
+                      A_global.GetCoef(), counts, byte_shifts, types,
+                      mpi_comm);
+        TRACE_END();
+
+        if (rank == root) {
+            for (int i = 0; i < nproc; i++) {
+                MPI_Type_free(&types[i]);
+            }
+        }
+
+        return 0;
+    }
+
+    ________________________________________________________________________________
+
+//! @internal build the 'band_numb'-th band (column) of a matrix
+    int BuildMatrixBandColumn(
+            MatrixDense<double, int> &A_local,
+            const MatrixDense<double, int> &A,
+            const int numb_procs,
+            const int proc_numb) {
+
+        return 0;
+    }
+
+    ________________________________________________________________________________
+
+
+// -----------------------------------------------------------------------------
+// -- Vector : BLOCK
+// -----------------------------------------------------------------------------
+
+//! @internal distribute vector upon processors (block)
+    int DistributeVectorBlock(
+            Vector<double, int> &x_local,
+            const Vector<double, int> &x,
+            int root,
+            MPI_Comm &mpi_comm_rows,
+            MPI_Comm &mpi_comm_columns) {
+
+        return 0;
+    }
+
+    ________________________________________________________________________________
+
+//! @internal build the 'block_numb'-th band of a vector (block)
+    int BuildVectorBlock(
+            Vector<double, int> &x_local,
+            const Vector<double, int> &x,
+            const int numb_procs_i,
+            const int numb_procs_j,
+            const int proc_numb_i,
+            const int proc_numb_j) {
+
+        // -- size of the global vector
+        int size = x.GetSize();
+
+        // -- compute the number of block in j-
+        int size_local = BandSize(proc_numb_j, numb_procs_j, size);
+        // -- allocate and fill out the local vector
+        x_local.Allocate(size_local);
+        for (int j = 0; j < size_local; j++) {
+            // local (j) to global indice (l2g_j)
+            int l2g_j = BandPos(proc_numb_j, numb_procs_j, size) + j;
+            x_local(j) = x(l2g_j);
+        }
+
+        return 0;
+    }
+
+    ________________________________________________________________________________
+
+// -----------------------------------------------------------------------------
+// -- Matrix: BAND-ROW
+// -----------------------------------------------------------------------------
+
+//! @internal datatype of the block of a processor inside the global
+//         row-major matrix (block)
+//! @remarks proc_numb follows row major order (as the cartesian grid)
+    int BlockType(
+            MPI_Datatype &mpi_type,
+            int numb_rows,
+            int numb_columns,
+            int numb_procs_i,
+            int numb_procs_j,
+            int proc_numb) {
+
+        int proc_numb_i = proc_numb / numb_procs_j;
+        int proc_numb_j = proc_numb % numb_procs_j;
+
+        // -- empty block (more processors than rows or columns)
+        if (BandSize(proc_numb_i, numb_procs_i, numb_rows) == 0 ||
+            BandSize(proc_numb_j, numb_procs_j, numb_columns) == 0) {
+            MPI_Type_contiguous(0, MPI_DOUBLE, &mpi_type);
+            MPI_Type_commit(&mpi_type);
+            return 0;
+        }
+
+        int sizes[2] = {numb_rows, numb_columns};
+        int sub_sizes[2] = {BandSize(proc_numb_i, numb_procs_i, numb_rows),
+                            BandSize(proc_numb_j, numb_procs_j, numb_columns)};
+        int starts[2] = {BandPos(proc_numb_i, numb_procs_i, numb_rows),
+                         BandPos(proc_numb_j, numb_procs_j, numb_columns)};
+
+        MPI_Type_create_subarray(2, sizes, sub_sizes, starts, MPI_ORDER_C,
+                                 MPI_DOUBLE, &mpi_type);
+        MPI_Type_commit(&mpi_type);
+
+        return 0;
+    }
+
+    ________________________________________________________________________________
+
+//! @internal distribute matrix upon processors (block)
+//! @remarks root is a rank of the communicator given to GridCartesianComm
+//! @remarks blocks may be uneven (BandSize on each dimension of the grid)
+    int DistributeMatrixBlock(
+            MatrixDense<double, int> &A_local,
+            const MatrixDense<double, int> &A,
+            int root,
+            MPI_Comm &mpi_comm_rows,
+            MPI_Comm &mpi_comm_columns) {
+        TRACE_SCOPE("DistributeMatrixBlock");
+        MEMORY_TAG("DistributeMatrixBlock");
+
+        MPI_Comm mpi_comm_grid;
+        if (GridComm(mpi_comm_grid, mpi_comm_rows) != 0) {
+            return 1;
+        }
+        // -- root: rank of the communicator the grid was created from
+        if (GridRank(root, root, mpi_comm_rows) != 0) {
+            return 1;
+        }
+
+        int rank, nproc;
+        MPI_Comm_rank(mpi_comm_grid, &rank);
+        MPI_Comm_size(mpi_comm_grid, &nproc);
+        int numb_procs_i, numb_procs_j, proc_numb_i, proc_numb_j;
+        MPI_Comm_size(mpi_comm_columns, &numb_procs_i);
+        MPI_Comm_rank(mpi_comm_columns, &proc_numb_i);
+        MPI_Comm_size(mpi_comm_rows, &numb_procs_j);
+        MPI_Comm_rank(mpi_comm_rows, &proc_numb_j);
+
+        int dims[2];
+        if (rank == root) {
+            dims[0] = A.GetNumbRows();
+            dims[1] = A.GetNumbColumns();
+        }
+        TRACE_BEGIN("metadata");
+        MPI_Bcast(dims, 2, MPI_INT, root, mpi_comm_grid);
+        TRACE_END();
+
+        int rows_local = BandSize(proc_numb_i, numb_procs_i, dims[0]);
+        int cols_local = BandSize(proc_numb_j, numb_procs_j, dims[1]);
+        A_local.Allocate(rows_local, cols_local);
+
+        // -- root sends one subarray per processor, others only receive
+        int counts[nproc];
+        int byte_shifts[nproc];
+        MPI_Datatype types[nproc];
+        int recvcounts[nproc];
+        int recvshifts[nproc];
+        MPI_Datatype recvtypes[nproc];
+        for (int k = 0; k < nproc; k++) {
+            counts[k] = 0;
+            byte_shifts[k] = 0;
+            types[k] = MPI_DOUBLE;
+            recvcounts[k] = 0;
+            recvshifts[k] = 0;
+            recvtypes[k] = MPI_DOUBLE;
+        }
+        TRACE_BEGIN("pack");
+        if (rank == root) {
+            for (int k = 0; k < nproc; k++) {
+                BlockType(types[k], dims[0], dims[1], numb_procs_i, numb_procs_j, k);
+                counts[k] = 1;
+            }
+        }
+        TRACE_END();
+        recvcounts[root] = rows_local * cols_local;
+
+        // -- all blocks in a single collective, no packing on root
+        TRACE_BEGIN("communication");
+        MPI_Alltoallw(A.GetCoef(), counts, byte_shifts, types,
+                      A_local.GetCoef(), recvcounts, recvshifts, recvtypes,
+                      mpi_comm_grid);
+        TRACE_END();
+
+        if (rank == root) {
+            for (int k = 0; k < nproc; k++) {
+                MPI_Type_free(&types[k]);
+            }
+        }
+
+        return 0;
+    }
+
+    ________________________________________________________________________________
+
+//! @internal assemble matrix upon processors (block)
+//! @remarks root is a rank of the communicator given to GridCartesianComm
+//! @remarks blocks may be uneven (BandSize on each dimension of the grid)
+    int AssembleMatrixBlock(
+            MatrixDense<double, int> &A_global,
+            const MatrixDense<double, int> &A,
+            int root,
+            MPI_Comm &mpi_comm_rows,
+            MPI_Comm &mpi_comm_columns) {
+        TRACE_SCOPE("AssembleMatrixBlock");
+        MEMORY_TAG("AssembleMatrixBlock");
+
+        MPI_Comm mpi_comm_grid;
+        if (GridComm(mpi_comm_grid, mpi_comm_rows) != 0) {
+            return 1;
+        }
+        // -- root: rank of the communicator the grid was created from
+        if (GridRank(root, root, mpi_comm_rows) != 0) {
+            return 1;
+        }
+
+        int rank, nproc;
+        MPI_Comm_rank(mpi_comm_grid, &rank);
+        MPI_Comm_size(mpi_comm_grid, &nproc);
+        int numb_procs_i, numb_procs_j;
+        MPI_Comm_size(mpi_comm_columns, &numb_procs_i);
+        MPI_Comm_size(mpi_comm_rows, &numb_procs_j);
+
+        // -- global size of the matrix
+        int rows_local = A.GetNumbRows();
+        int cols_local = A.GetNumbColumns();
+        int dims[2];
+        TRACE_BEGIN("metadata");
+        MPI_Allreduce(&rows_local, &dims[0], 1, MPI_INT, MPI_SUM, mpi_comm_columns);
+        MPI_Allreduce(&cols_local, &dims[1], 1, MPI_INT, MPI_SUM, mpi_comm_rows);
+        TRACE_END();
+
+        // -- others send their block, root receives one subarray per processor
+        int sendcounts[nproc];
+        int sendshifts[nproc];
+        MPI_Datatype sendtypes[nproc];
+        int counts[nproc];
+        int byte_shifts[nproc];
+        MPI_Datatype types[nproc];
+        for (int k = 0; k < nproc; k++) {
+            sendcounts[k] = 0;
+            sendshifts[k] = 0;
+            sendtypes[k] = MPI_DOUBLE;
+            counts[k] = 0;
+            byte_shifts[k] = 0;
+            types[k] = MPI_DOUBLE;
+        }
+        sendcounts[root] = rows_local * cols_local;
+        TRACE_BEGIN("pack");
+        if (rank == root) {
+            A_global.Allocate(dims[0], dims[1]);
+            for (int k = 0; k < nproc; k++) {
+                BlockType(types[k], dims[0], dims[1], numb_procs_i, numb_procs_j, k);
+                counts[k] = 1;
+            }
+        }
+        TRACE_END();
+
+        // -- all blocks in a single collective, no unpacking on root
+        TRACE_BEGIN("communication");
+        MPI_Alltoallw(A.GetCoef(), sendcounts, sendshifts, sendtypes,
+                      A_global.GetCoef(), counts, byte_shifts, types,
+                      mpi_comm_grid);
+        TRACE_END();
+
+        if (rank == root) {
+            for (int k = 0; k < nproc; k++) {
+                MPI_Type_free(&types[k]);
+            }
+        }
+
+        return 0;
+    }
+
+    ________________________________________________________________________________
+
+//! @internal build the 'band_numb'-th block of a matrix
+//! @remarks proc_numb follows row major order
+//! @remarks proc_numb = proc_numb_i * numb_procs_j + proc_numb_j
+//! @note number of processors must be perfect square
+    int BuildMatrixMatrixBlock(
+            MatrixDense<double, int> &A_local,
+            const MatrixDense<double, int> &A,
+            const int numb_procs_i,
+            const int numb_procs_j,
+            const int proc_numb_i,
+            const int proc_numb_j) {
+
+        return 0;
+    }
+
+// -----------------------------------------------------------------------------
+// -- Vector : BLOCK-CYCLIC
+// -----------------------------------------------------------------------------
+
+//! @internal distribute vector upon processors (block-cyclic)
+    int DistributeVectorBlockCyclic(
+            Vector<double, int> &x_local,
+            const Vector<double, int> &x,
+            int block_size,
+            int root,
+            MPI_Comm &mpi_comm_rows,
+            MPI_Comm &mpi_comm_columns) {
+        TRACE_SCOPE("DistributeVectorBlockCyclic");
+        MEMORY_TAG("DistributeVectorBlockCyclic");
+
+        MPI_Comm mpi_comm_grid;
+        if (GridComm(mpi_comm_grid, mpi_comm_rows) != 0) {
+            return 1;
+        }
+        // -- root: rank of the communicator the grid was created from
+        if (GridRank(root, root, mpi_comm_rows) != 0) {
+            return 1;
+        }
+
+        int grid_proc_numb;
+        MPI_Comm_rank(mpi_comm_grid, &grid_proc_numb);
+        int numb_procs_j, proc_numb_j, proc_numb_i;
+        MPI_Comm_size(mpi_comm_rows, &numb_procs_j);
+        MPI_Comm_rank(mpi_comm_rows, &proc_numb_j);
+        MPI_Comm_rank(mpi_comm_columns, &proc_numb_i);
+
+        // -- size of the vector and coordinates of root on the grid
+        int root_info[3];
+        if (grid_proc_numb == root) {
+            root_info[0] = x.GetSize();
+            root_info[1] = proc_numb_i;
+            root_info[2] = proc_numb_j;
+        }
+        TRACE_BEGIN("metadata");
+        MPI_Bcast(root_info, 3, MPI_INT, root, mpi_comm_grid);
+        TRACE_END();
+        int size = root_info[0];
+
+        int size_local = CyclicSize(proc_numb_j, numb_procs_j, block_size, size);
+        x_local.Allocate(size_local);
+
+        // -- scatter the cyclic parts along the processor row of root
+        TRACE_BEGIN("communication");
+        if (proc_numb_i == root_info[1]) {
+            MPI_Request *requests = new MPI_Request[numb_procs_j];
+            if (grid_proc_numb == root) {
+                for (int j = 0; j < numb_procs_j; j++) {
+                    MPI_Datatype mpi_type;
+                    BlockCyclicType(mpi_type, 1, size, 1, block_size,
+                                    1, numb_procs_j, j);
+                    MPI_Isend(x.GetCoef(), 1, mpi_type, j, 0, mpi_comm_rows,
+                              &requests[j]);
+                    MPI_Type_free(&mpi_type);
+                }
+            }
+            MPI_Recv(x_local.GetCoef(), size_local, MPI_DOUBLE, root_info[2], 0,
+                     mpi_comm_rows, MPI_STATUS_IGNORE);
+            if (grid_proc_numb == root) {
+                MPI_Waitall(numb_procs_j, requests, MPI_STATUSES_IGNORE);
+            }
+            delete[] requests;
+        }
+
+        // -- replicate over the processor rows
+        MPI_Bcast(x_local.GetCoef(), size_local, MPI_DOUBLE, root_info[1],
+                  mpi_comm_columns);
+        TRACE_END();
+
+        return 0;
+    }
+
+    ________________________________________________________________________________
+
+//! @internal assemble vector upon processors (block-cyclic)
+    int AssembleVectorBlockCyclic(
+            Vector<double, int> &y_global,
+            const Vector<double, int> &y,
+            int block_size,
+            int root,
+            MPI_Comm &mpi_comm_rows,
+            MPI_Comm &mpi_comm_columns) {
+        TRACE_SCOPE("AssembleVectorBlockCyclic");
+        MEMORY_TAG("AssembleVectorBlockCyclic");
+
+        MPI_Comm mpi_comm_grid;
+        if (GridComm(mpi_comm_grid, mpi_comm_rows) != 0) {
+            return 1;
+        }
+        // -- root: rank of the communicator the grid was created from
+        if (GridRank(root, root, mpi_comm_rows) != 0) {
+            return 1;
+        }
+
+        int grid_proc_numb;
+        MPI_Comm_rank(mpi_comm_grid, &grid_proc_numb);
+        int numb_procs_i, proc_numb_i, proc_numb_j;
+        MPI_Comm_size(mpi_comm_columns, &numb_procs_i);
+        MPI_Comm_rank(mpi_comm_columns, &proc_numb_i);
+        MPI_Comm_rank(mpi_comm_rows, &proc_numb_j);
+
+        // -- coordinates of root on the grid
+        int root_info[2] = {proc_numb_i, proc_numb_j};
+        TRACE_BEGIN("metadata");
+        MPI_Bcast(root_info, 2, MPI_INT, root, mpi_comm_grid);
+
+        // -- global size of the vector
+        int size_local = y.GetSize();
+        int size = 0;
+        MPI_Allreduce(&size_local, &size, 1, MPI_INT, MPI_SUM, mpi_comm_columns);
+        TRACE_END();
+
+        // -- gather the cyclic parts along the processor column of root
+        TRACE_BEGIN("communication");
+        if (proc_numb_j == root_info[1]) {
+            MPI_Request *requests = new MPI_Request[numb_procs_i];
+            if (grid_proc_numb == root) {
+                y_global.Allocate(size);
+                for (int i = 0; i < numb_procs_i; i++) {
+                    MPI_Datatype mpi_type;
+                    BlockCyclicType(mpi_type, size, 1, block_size, 1,
+                                    numb_procs_i, 1, i);
+                    MPI_Irecv(y_global.GetCoef(), 1, mpi_type, i, 0,
+                              mpi_comm_columns, &requests[i]);
+                    MPI_Type_free(&mpi_type);
+                }
+            }
+            MPI_Send(y.GetCoef(), size_local, MPI_DOUBLE, root_info[0], 0,
+                     mpi_comm_columns);
+            if (grid_proc_numb == root) {
+                MPI_Waitall(numb_procs_i, requests, MPI_STATUSES_IGNORE);
+            }
+            delete[] requests;
+        }
+        TRACE_END();
+
+        return 0;
+    }
+
+    ________________________________________________________________________________
+
+// -----------------------------------------------------------------------------
+// -- Matrix: BLOCK-CYCLIC
+// -----------------------------------------------------------------------------
+
+//! @internal distribute matrix upon processors (block-cyclic)
+    int DistributeMatrixBlockCyclic(
+            MatrixDense<double, int> &A_local,
+            const MatrixDense<double, int> &A,
+            int block_rows,
+            int block_columns,
+            int root,
+            MPI_Comm &mpi_comm_rows,
+            MPI_Comm &mpi_comm_columns) {
+        TRACE_SCOPE("DistributeMatrixBlockCyclic");
+        MEMORY_TAG("DistributeMatrixBlockCyclic");
+
+        MPI_Comm mpi_comm_grid;
+        if (GridComm(mpi_comm_grid, mpi_comm_rows) != 0) {
+            return 1;
+        }
+        // -- root: rank of the communicator the grid was created from
+        if (GridRank(root, root, mpi_comm_rows) != 0) {
+            return 1;
+        }
+
+        int grid_proc_numb;
+        MPI_Comm_rank(mpi_comm_grid, &grid_proc_numb);
+        int numb_procs_i, numb_procs_j, proc_numb_i, proc_numb_j;
+        MPI_Comm_size(mpi_comm_columns, &numb_procs_i);
+        MPI_Comm_rank(mpi_comm_columns, &proc_numb_i);
+        MPI_Comm_size(mpi_comm_rows, &numb_procs_j);
+        MPI_Comm_rank(mpi_comm_rows, &proc_numb_j);
+
+        int dims[2];
+        if (grid_proc_numb == root) {
+            dims[0] = A.GetNumbRows();
+            dims[1] = A.GetNumbColumns();
+        }
+        TRACE_BEGIN("metadata");
+        MPI_Bcast(dims, 2, MPI_INT, root, mpi_comm_grid);
+        TRACE_END();
+
+        int rows_local = CyclicSize(proc_numb_i, numb_procs_i, block_rows, dims[0]);
+        int cols_local = CyclicSize(proc_numb_j, numb_procs_j, block_columns, dims[1]);
+        A_local.Allocate(rows_local, cols_local);
+
+        // -- root sends the blocks of each processor straight from A
+        TRACE_BEGIN("communication");
+        int numb_procs = numb_procs_i * numb_procs_j;
+        MPI_Request *requests = new MPI_Request[numb_procs];
+        if (grid_proc_numb == root) {
+            for (int k = 0; k < numb_procs; k++) {
+                MPI_Datatype mpi_type;
+                BlockCyclicType(mpi_type, dims[0], dims[1], block_rows, block_columns,
+                                numb_procs_i, numb_procs_j, k);
+                MPI_Isend(A.GetCoef(), 1, mpi_type, k, 0, mpi_comm_grid, &requests[k]);
+                MPI_Type_free(&mpi_type);
+            }
+        }
+        MPI_Recv(A_local.GetCoef(), rows_local * cols_local, MPI_DOUBLE, root, 0,
+                 mpi_comm_grid, MPI_STATUS_IGNORE);
+        if (grid_proc_numb == root) {
+            MPI_Waitall(numb_procs, requests, MPI_STATUSES_IGNORE);
+        }
+        delete[] requests;
+        TRACE_END();
+
+        return 0;
+    }
+
+    ________________________________________________________________________________
+
+//! @internal assemble matrix upon processors (block-cyclic)
+    int AssembleMatrixBlockCyclic(
+            MatrixDense<double, int> &A_global,
+            const MatrixDense<double, int> &A,
+            int block_rows,
+            int block_columns,
+            int root,
+            MPI_Comm &mpi_comm_rows,
+            MPI_Comm &mpi_comm_columns) {
+        TRACE_SCOPE("AssembleMatrixBlockCyclic");
+        MEMORY_TAG("AssembleMatrixBlockCyclic");
+
+        MPI_Comm mpi_comm_grid;
+        if (GridComm(mpi_comm_grid, mpi_comm_rows) != 0) {
+            return 1;
+        }
+        // -- root: rank of the communicator the grid was created from
+        if (GridRank(root, root, mpi_comm_rows) != 0) {
+            return 1;
+        }
+
+        int grid_proc_numb;
+        MPI_Comm_rank(mpi_comm_grid, &grid_proc_numb);
+        int numb_procs_i, numb_procs_j;
+        MPI_Comm_size(mpi_comm_columns, &numb_procs_i);
+        MPI_Comm_size(mpi_comm_rows, &numb_procs_j);
+
+        // -- global size of the matrix
+        int rows_local = A.GetNumbRows();
+        int cols_local = A.GetNumbColumns();
+        int dims[2];
+        TRACE_BEGIN("metadata");
+        MPI_Allreduce(&rows_local, &dims[0], 1, MPI_INT, MPI_SUM, mpi_comm_columns);
+        MPI_Allreduce(&cols_local, &dims[1], 1, MPI_INT, MPI_SUM, mpi_comm_rows);
+        TRACE_END();
+
+        // -- root receives the blocks of each processor straight into A_global
+        TRACE_BEGIN("communication");
+        int numb_procs = numb_procs_i * numb_procs_j;
+        MPI_Request *requests = new MPI_Request[numb_procs];
+        if (grid_proc_numb == root) {
+            A_global.Allocate(dims[0], dims[1]);
+            for (int k = 0; k < numb_procs; k++) {
+                MPI_Datatype mpi_type;
+                BlockCyclicType(mpi_type, dims[0], dims[1], block_rows, block_columns,
+                                numb_procs_i, numb_procs_j, k);
+                MPI_Irecv(A_global.GetCoef(), 1, mpi_type, k, 0, mpi_comm_grid,
+                          &requests[k]);
+                MPI_Type_free(&mpi_type);
+            }
+        }
+        MPI_Send(A.GetCoef(), rows_local * cols_local, MPI_DOUBLE, root, 0,
+                 mpi_comm_grid);
+        if (grid_proc_numb == root) {
+            MPI_Waitall(numb_procs, requests, MPI_STATUSES_IGNORE);
+        }
+        delete[] requests;
+        TRACE_END();
+
+        return 0;
+    }
+
+    ________________________________________________________________________________
+
+// -----------------------------------------------------------------------------
+// -- Parallel construction (no root, no scatter)
+// -----------------------------------------------------------------------------
+
+//! @internal build the local part of a distributed matrix in place
+    int CreateMatrix(
+            MatrixDense<double, int> &A_local,
+            const Distribution &dist,
+            ElementGenerator generator,
+            void *data) {
+        MEMORY_TAG("CreateMatrix");
+
+        int rows_local = LocalNumbRows(dist);
+        int cols_local = LocalNumbColumns(dist);
+        A_local.Allocate(rows_local, cols_local);
+
+        for (int i = 0; i < rows_local; i++) {
+            // local (i) to global indice (l2g_i)
+            int l2g_i = LocalToGlobalRow(dist, i);
+            double *A_i = A_local.GetCoef(i);
+            for (int j = 0; j < cols_local; j++) {
+                A_i[j] = generator(l2g_i, LocalToGlobalColumn(dist, j), data);
+            }
+        }
+
+        return 0;
+    }
+
+    ________________________________________________________________________________
+
+//! @internal build the local part of a distributed matrix in place
+    int CreateMatrix(
+            MatrixDense<double, int> &A_local,
+            const Distribution &dist,
+            RowBlockGenerator generator,
+            void *data) {
+        MEMORY_TAG("CreateMatrix");
+
+        int rows_local = LocalNumbRows(dist);
+        int cols_local = LocalNumbColumns(dist);
+        A_local.Allocate(rows_local, cols_local);
+
+        // -- band and block: the local part is one contiguous global block
+        int block_rows = rows_local;
+        int block_columns = cols_local;
+        if (dist.type == distribution::c_BLOCK_CYCLIC) {
+            block_rows = dist.block_rows;
+            block_columns = dist.block_columns;
+        }
+
+        // -- one call per contiguous global block
+        for (int i = 0; i < rows_local; i += block_rows) {
+            int numb_rows = (rows_local - i < block_rows) ? rows_local - i : block_rows;
+            for (int j = 0; j < cols_local; j += block_columns) {
+                int numb_columns = (cols_local - j < block_columns) ? cols_local - j
+                                                                     : block_columns;
+                int error = generator(A_local.GetCoef(i) + j, cols_local,
+                                      LocalToGlobalRow(dist, i), numb_rows,
+                                      LocalToGlobalColumn(dist, j), numb_columns,
+                                      data);
+                if (error != 0) {
+                    return error;
+                }
+            }
+        }
+
+        return 0;
+    }
+
+    ________________________________________________________________________________
+
+//! @internal build the local part of a distributed vector in place
+    int CreateVector(
+            Vector<double, int> &x_local,
+            const Distribution &dist,
+            VectorGenerator generator,
+            void *data) {
+        MEMORY_TAG("CreateVector");
+
+        // -- column vector (n x 1) or row vector (1 x n)
+        bool is_column = (dist.numb_columns == 1);
+        int size_local = is_column ? LocalNumbRows(dist) : LocalNumbColumns(dist);
+        x_local.Allocate(size_local);
+
+        for (int i = 0; i < size_local; i++) {
+            // local (i) to global indice (l2g_i)
+            int l2g_i = is_column ? LocalToGlobalRow(dist, i)
+                                  : LocalToGlobalColumn(dist, i);
+            x_local(i) = generator(l2g_i, data);
+        }
+
+        return 0;
+    }
+
+    ________________________________________________________________________________
+
+// -----------------------------------------------------------------------------
+// -- Redistribution (all-to-all, no root)
+// -----------------------------------------------------------------------------
+
+//! @internal processor owning a global index (band)
+    int BandProc(
+            int idx_global,
+            int numb_procs,
+            int size) {
+
+        return (int) (((long long) numb_procs * (idx_global + 1) - 1) / size);
+    }
+
+    ________________________________________________________________________________
+
+//! @internal processor (i-) owning a global row
+    int GlobalToProcRow(
+            const Distribution &dist,
+            int idx_global) {
+
+        if (dist.type == distribution::c_BLOCK_CYCLIC) {
+            return CyclicGlobalToProc(idx_global, dist.numb_procs_i, dist.block_rows);
+        }
+
+        return BandProc(idx_global, dist.numb_procs_i, dist.numb_rows);
+    }
+
+    ________________________________________________________________________________
+
+//! @internal processor (j-) owning a global column
+    int GlobalToProcColumn(
+            const Distribution &dist,
+            int idy_global) {
+
+        if (dist.type == distribution::c_BLOCK_CYCLIC) {
+            return CyclicGlobalToProc(idy_global, dist.numb_procs_j, dist.block_columns);
+        }
+
+        return BandProc(idy_global, dist.numb_procs_j, dist.numb_columns);
+    }
+
+    ________________________________________________________________________________
+
+//! @internal local rows (or columns) of a distribution, sorted by the
+//         processor owning them in another distribution
+//! @param [in,out] shifts = start of each owner in list (numb_procs + 1)
+//! @param [in,out] list = local indices, increasing for each owner
+//! @param [in] owners = owner of each local index
+//! @param [in] size_local = number of local indices
+//! @param [in] numb_procs = number of owners
+    int OverlapIndices(
+            int *shifts,
+            int *list,
+            const int *owners,
+            int size_local,
+            int numb_procs) {
+
+        for (int k = 0; k <= numb_procs; k++) {
+            shifts[k] = 0;
+        }
+        for (int l = 0; l < size_local; l++) {
+            shifts[owners[l] + 1]++;
+        }
+        for (int k = 0; k < numb_procs; k++) {
+            shifts[k + 1] += shifts[k];
+        }
+        int position[numb_procs];
+        for (int k = 0; k < numb_procs; k++) {
+            position[k] = shifts[k];
+        }
+        for (int l = 0; l < size_local; l++) {
+            list[position[owners[l]]++] = l;
+        }
+
+        return 0;
+    }
+
+    ________________________________________________________________________________
+
+//! @internal datatype of a selection (rows x columns, local indices) of a
+//         local row-major matrix
+    int OverlapType(
+            MPI_Datatype &mpi_type,
+            const int *rows,
+            int numb_rows,
+            const int *columns,
+            int numb_columns,
+            int ld) {
+
+        // -- runs of contiguous columns
+        int *lengths = new int[numb_columns];
+        int *shifts = new int[numb_columns];
+        int numb_runs = 0;
+        for (int k = 0; k < numb_columns; k++) {
+            if (numb_runs > 0 && shifts[numb_runs - 1] + lengths[numb_runs - 1] == columns[k]) {
+                lengths[numb_runs - 1]++;
+            } else {
+                shifts[numb_runs] = columns[k];
+                lengths[numb_runs] = 1;
+                numb_runs++;
+            }
+        }
+        MPI_Datatype row_type;
+        MPI_Type_indexed(numb_runs, lengths, shifts, MPI_DOUBLE, &row_type);
+
+        // -- one row type per selected row
+        MPI_Aint *byte_shifts = new MPI_Aint[numb_rows];
+        for (int k = 0; k < numb_rows; k++) {
+            byte_shifts[k] = (MPI_Aint) rows[k] * ld * sizeof(double);
+        }
+        MPI_Type_create_hindexed_block(numb_rows, 1, byte_shifts, row_type, &mpi_type);
+        MPI_Type_commit(&mpi_type);
+
+        MPI_Type_free(&row_type);
+        delete[] lengths;
+        delete[] shifts;
+        delete[] byte_shifts;
+
+        return 0;
+    }
+
+    ________________________________________________________________________________
+
+//! @internal redistribute local row-major arrays from a distribution to another
+//! @remarks processors sharing a source part (replicas) share the sends:
+//           destination k reads from the replica (k modulo number of replicas)
+    int Redistribute(
+            double *coef_dst,
+            const Distribution &dist_dst,
+            const double *coef_src,
+            const Distribution &dist_src,
+            MPI_Comm &mpi_comm) {
+        TRACE_SCOPE("Redistribute");
+
+        if (dist_src.numb_rows != dist_dst.numb_rows ||
+            dist_src.numb_columns != dist_dst.numb_columns) {
+            return 1;
+        }
+
+        int rank, nproc;
+        MPI_Comm_rank(mpi_comm, &rank);
+        MPI_Comm_size(mpi_comm, &nproc);
+
+        // -- grid coordinates of every processor in both distributions
+        int coords[4] = {dist_src.proc_numb_i, dist_src.proc_numb_j,
+                         dist_dst.proc_numb_i, dist_dst.proc_numb_j};
+        int all_coords[4 * nproc];
+        TRACE_BEGIN("metadata");
+        MPI_Allgather(coords, 4, MPI_INT, all_coords, 4, MPI_INT, mpi_comm);
+        TRACE_END();
+
+        // -- replicas of the source parts
+        int replica_numb[nproc];
+        int numb_replicas[nproc];
+        for (int k = 0; k < nproc; k++) {
+            replica_numb[k] = 0;
+            numb_replicas[k] = 0;
+            for (int l = 0; l < nproc; l++) {
+                if (all_coords[4 * l] == all_coords[4 * k] &&
+                    all_coords[4 * l + 1] == all_coords[4 * k + 1]) {
+                    numb_replicas[k]++;
+                    if (l < k) {
+                        replica_numb[k]++;
+                    }
+                }
+            }
+        }
+
+        // -- local indices sorted by their owner in the other distribution
+        TRACE_BEGIN("pack");
+        int rows_src = LocalNumbRows(dist_src);
+        int cols_src = LocalNumbColumns(dist_src);
+        int rows_dst = LocalNumbRows(dist_dst);
+        int cols_dst = LocalNumbColumns(dist_dst);
+        int size_max = rows_src;
+        size_max = (cols_src > size_max) ? cols_src : size_max;
+        size_max = (rows_dst > size_max) ? rows_dst : size_max;
+        size_max = (cols_dst > size_max) ? cols_dst : size_max;
+        int *owners = new int[size_max];
+
+        int *send_rows = new int[rows_src];
+        int send_rows_shifts[dist_dst.numb_procs_i + 1];
+        for (int l = 0; l < rows_src; l++) {
+            owners[l] = GlobalToProcRow(dist_dst, LocalToGlobalRow(dist_src, l));
+        }
+        OverlapIndices(send_rows_shifts, send_rows, owners, rows_src, dist_dst.numb_procs_i);
+
+        int *send_cols = new int[cols_src];
+        int send_cols_shifts[dist_dst.numb_procs_j + 1];
+        for (int l = 0; l < cols_src; l++) {
+            owners[l] = GlobalToProcColumn(dist_dst, LocalToGlobalColumn(dist_src, l));
+        }
+        OverlapIndices(send_cols_shifts, send_cols, owners, cols_src, dist_dst.numb_procs_j);
+
+        int *recv_rows = new int[rows_dst];
+        int recv_rows_shifts[dist_src.numb_procs_i + 1];
+        for (int l = 0; l < rows_dst; l++) {
+            owners[l] = GlobalToProcRow(dist_src, LocalToGlobalRow(dist_dst, l));
+        }
+        OverlapIndices(recv_rows_shifts, recv_rows, owners, rows_dst, dist_src.numb_procs_i);
+
+        int *recv_cols = new int[cols_dst];
+        int recv_cols_shifts[dist_src.numb_procs_j + 1];
+        for (int l = 0; l < cols_dst; l++) {
+            owners[l] = GlobalToProcColumn(dist_src, LocalToGlobalColumn(dist_dst, l));
+        }
+        OverlapIndices(recv_cols_shifts, recv_cols, owners, cols_dst, dist_src.numb_procs_j);
+
+        // -- one datatype per overlap, on both sides
+        int sendcounts[nproc];
+        int sendshifts[nproc];
+        MPI_Datatype sendtypes[nproc];
+        int recvcounts[nproc];
+        int recvshifts[nproc];
+        MPI_Datatype recvtypes[nproc];
+        for (int k = 0; k < nproc; k++) {
+            sendcounts[k] = 0;
+            sendshifts[k] = 0;
+            sendtypes[k] = MPI_DOUBLE;
+            recvcounts[k] = 0;
+            recvshifts[k] = 0;
+            recvtypes[k] = MPI_DOUBLE;
+
+            // -- send to k the overlap of my source part with its destination part
+            int dst_i = all_coords[4 * k + 2];
+            int dst_j = all_coords[4 * k + 3];
+            int numb_rows = send_rows_shifts[dst_i + 1] - send_rows_shifts[dst_i];
+            int numb_columns = send_cols_shifts[dst_j + 1] - send_cols_shifts[dst_j];
+            if (replica_numb[rank] == k % numb_replicas[rank] &&
+                numb_rows > 0 && numb_columns > 0) {
+                OverlapType(sendtypes[k], send_rows + send_rows_shifts[dst_i], numb_rows,
+                            send_cols + send_cols_shifts[dst_j], numb_columns, cols_src);
+                sendcounts[k] = 1;
+            }
+
+            // -- receive from k the overlap of its source part with my destination part
+            int src_i = all_coords[4 * k];
+            int src_j = all_coords[4 * k + 1];
+            numb_rows = recv_rows_shifts[src_i + 1] - recv_rows_shifts[src_i];
+            numb_columns = recv_cols_shifts[src_j + 1] - recv_cols_shifts[src_j];
+            if (replica_numb[k] == rank % numb_replicas[k] &&
+                numb_rows > 0 && numb_columns > 0) {
+                OverlapType(recvtypes[k], recv_rows + recv_rows_shifts[src_i], numb_rows,
+                            recv_cols + recv_cols_shifts[src_j], numb_columns, cols_dst);
+                recvcounts[k] = 1;
+            }
+        }
+        TRACE_END();
+
+        // -- all overlaps in a single collective
+        TRACE_BEGIN("communication");
+        MPI_Alltoallw(coef_src, sendcounts, sendshifts, sendtypes,
+                      coef_dst, recvcounts, recvshifts, recvtypes,
+                      mpi_comm);
+        TRACE_END();
+
+        for (int k = 0; k < nproc; k++) {
+            if (sendcounts[k] > 0) {
+                MPI_Type_free(&sendtypes[k]);
+            }
+            if (recvcounts[k] > 0) {
+                MPI_Type_free(&recvtypes[k]);
+            }
+        }
+        delete[] owners;
+        delete[] send_rows;
+        delete[] send_cols;
+        delete[] recv_rows;
+        delete[] recv_cols;
+
+        return 0;
+    }
+
+    ________________________________________________________________________________
+
+//! @internal redistribute a matrix from a distribution to another one
+    int RedistributeMatrix(
+            MatrixDense<double, int> &A_dst,
+            const Distribution &dist_dst,
+            const MatrixDense<double, int> &A_src,
+            const Distribution &dist_src,
+            MPI_Comm &mpi_comm) {
+        MEMORY_TAG("RedistributeMatrix");
+
+        A_dst.Allocate(LocalNumbRows(dist_dst), LocalNumbColumns(dist_dst));
+
+        return Redistribute(A_dst.GetCoef(), dist_dst, A_src.GetCoef(), dist_src,
+                            mpi_comm);
+    }
+
+    ________________________________________________________________________________
+
+//! @internal vector distribution seen as a column vector (n x 1), replicated
+//         along the (j-) processors
+    int VectorDistribution(
+            Distribution &dist_vector,
+            const Distribution &dist) {
+
+        // -- row vector (1 x n): transpose the distribution
+        if (dist.numb_columns != 1) {
+            return CreateDistribution(dist_vector, dist.type,
+                                      dist.numb_columns, 1,
+                                      dist.numb_procs_j, 1,
+                                      dist.proc_numb_j, 0,
+                                      dist.block_columns, 1);
+        }
+
+        return CreateDistribution(dist_vector, dist.type,
+                                  dist.numb_rows, 1,
+                                  dist.numb_procs_i, 1,
+                                  dist.proc_numb_i, 0,
+                                  dist.block_rows, 1);
+    }
+
+    ________________________________________________________________________________
+
+//! @internal redistribute a vector from a distribution to another one
+    int RedistributeVector(
+            Vector<double, int> &x_dst,
+            const Distribution &dist_dst,
+            const Vector<double, int> &x_src,
+            const Distribution &dist_src,
+            MPI_Comm &mpi_comm) {
+        MEMORY_TAG("RedistributeVector");
+
+        Distribution dist_vector_dst, dist_vector_src;
+        VectorDistribution(dist_vector_dst, dist_dst);
+        VectorDistribution(dist_vector_src, dist_src);
+
+        x_dst.Allocate(LocalNumbRows(dist_vector_dst));
+
+        return Redistribute(x_dst.GetCoef(), dist_vector_dst,
+                            x_src.GetCoef(), dist_vector_src, mpi_comm);
+    }
+
+    ________________________________________________________________________________
+
+// -----------------------------------------------------------------------------
+// -- Parallel IO (MPI-IO, binary global files)
+// -----------------------------------------------------------------------------
+
+//! @internal datatype selecting the local part inside the global row-major matrix
+    int DistributionType(
+            MPI_Datatype &mpi_type,
+            const Distribution &dist) {
+
+        int proc_numb = dist.proc_numb_i * dist.numb_procs_j + dist.proc_numb_j;
+
+        if (dist.type == distribution::c_BLOCK_CYCLIC) {
+            return BlockCyclicType(mpi_type, dist.numb_rows, dist.numb_columns,
+                                   dist.block_rows, dist.block_columns,
+                                   dist.numb_procs_i, dist.numb_procs_j, proc_numb);
+        }
+
+        return BlockType(mpi_type, dist.numb_rows, dist.numb_columns,
+                         dist.numb_procs_i, dist.numb_procs_j, proc_numb);
+    }
+
+    ________________________________________________________________________________
+
+//! @internal hints of the collective (two-phase) buffering
+    int FileInfo(
+            MPI_Info &mpi_info) {
+
+        MPI_Info_create(&mpi_info);
+        MPI_Info_set(mpi_info, (char *) "romio_cb_read", (char *) "enable");
+        MPI_Info_set(mpi_info, (char *) "romio_cb_write", (char *) "enable");
+
+        return 0;
+    }
+
+    ________________________________________________________________________________
+
+//! @internal read the local part of a distribution from a binary global file
+//! @remarks elements are read into coef through the view of the distribution
+    int ReadFromFileBinary(
+            double *coef,
+            const iomrg::BinaryHeader &header,
+            const Distribution &dist,
+            MPI_File &mpi_file,
+            MPI_Info &mpi_info) {
+
+        MPI_Datatype mpi_type;
+        DistributionType(mpi_type, dist);
+        MPI_File_set_view(mpi_file, header.data_offset, MPI_DOUBLE, mpi_type,
+                          (char *) "native", mpi_info);
+        TRACE_BEGIN("io");
+        MPI_File_read_all(mpi_file, coef,
+                          LocalNumbRows(dist) * LocalNumbColumns(dist),
+                          MPI_DOUBLE, MPI_STATUS_IGNORE);
+        TRACE_END();
+        MPI_Type_free(&mpi_type);
+
+        return 0;
+    }
+
+    ________________________________________________________________________________
+
+//! @internal write the local part of a distribution into a binary global file
+    int WriteToFileBinary(
+            const double *coef,
+            const Distribution &dist,
+            int64_t numb_rows,
+            int64_t numb_columns,
+            const char *file_name,
             MPI_Comm &mpi_comm) {
+        TRACE_SCOPE("WriteToFileBinary");
 
-        int rank, nproc;
+        int rank;
         MPI_Comm_rank(mpi_comm, &rank);
-        MPI_Comm_size(mpi_comm, &nproc);
 
-        int rows, cols;
-        if (rank == root) {
-            rows = A.GetNumbRows();
-            cols = A.GetNumbColumns();
+        MPI_Info mpi_info;
+        FileInfo(mpi_info);
+        MPI_File mpi_file;
+        if (MPI_File_open(mpi_comm, (char *) file_name,
+                          MPI_MODE_CREATE | MPI_MODE_WRONLY,
+                          mpi_info, &mpi_file) != MPI_SUCCESS) {
+            MPI_Info_free(&mpi_info);
+            return 1;
+        }
+        MPI_File_set_size(mpi_file, 0);
+
+        // -- header written once
+        iomrg::BinaryHeader header;
+        iomrg::InitBinaryHeader(header, numb_rows, numb_columns);
+        if (rank == 0) {
+            MPI_File_write_at(mpi_file, 0, &header, sizeof(header), MPI_BYTE,
+                              MPI_STATUS_IGNORE);
         }
 
+        // -- each processor writes its own part through its view
+        MPI_Datatype mpi_type;
+        DistributionType(mpi_type, dist);
+        MPI_File_set_view(mpi_file, header.data_offset, MPI_DOUBLE, mpi_type,
+                          (char *) "native", mpi_info);
+        TRACE_BEGIN("io");
+        MPI_File_write_all(mpi_file, (void *) coef,
+                           LocalNumbRows(dist) * LocalNumbColumns(dist),
+                           MPI_DOUBLE, MPI_STATUS_IGNORE);
+        TRACE_END();
+        MPI_Type_free(&mpi_type);
+
+        MPI_File_close(&mpi_file);
+        MPI_Info_free(&mpi_info);
 
-        MPI_Bcast(&rows, 1, MPI_INT, root, mpi_comm);
-        MPI_Bcast(&cols, 1, MPI_INT, root, mpi_comm);
+        return 0;
+    }
 
+    ________________________________________________________________________________
 
-        int sendcounts[nproc];
-        int shifts[nproc];
-        for (int i = 0; i < nproc; i++) {
-            sendcounts[i] = BandSize(rank, nproc, rows);
+//! @internal open a binary global file and read its header
+    int OpenFileBinary(
+            MPI_File &mpi_file,
+            MPI_Info &mpi_info,
+            iomrg::BinaryHeader &header,
+            const char *file_name,
+            MPI_Comm &mpi_comm) {
+
+        FileInfo(mpi_info);
+        if (MPI_File_open(mpi_comm, (char *) file_name, MPI_MODE_RDONLY,
+                          mpi_info, &mpi_file) != MPI_SUCCESS) {
+            MPI_Info_free(&mpi_info);
+            return 1;
         }
 
-        for(int i = 0; i < nproc; i++){
-            if(i == 0)
-                shifts[i] = 0;
-            else
-                shifts[i] = shifts[i-1]+sendcounts[i-1];
+        MPI_File_read_at_all(mpi_file, 0, &header, sizeof(header), MPI_BYTE,
+                             MPI_STATUS_IGNORE);
+        if (iomrg::CheckBinaryHeader(header) != 0) {
+            MPI_File_close(&mpi_file);
+            MPI_Info_free(&mpi_info);
+            return 1;
         }
 
+        return 0;
+    }
+
+    ________________________________________________________________________________
+
+//! @internal read the local part of a matrix from a binary global file
+    int ReadMatrixFromFileBinary(
+            MatrixDense<double, int> &A_local,
+            Distribution &dist,
+            const char *file_name,
+            MPI_Comm &mpi_comm) {
+        TRACE_SCOPE("ReadMatrixFromFileBinary");
+        MEMORY_TAG("ReadMatrixFromFileBinary");
+
+        int rank;
+        MPI_Comm_rank(mpi_comm, &rank);
+        if (rank == 0) {
+            iomrg::printf(".r. Reading binary file (MPI-IO): %s \n", file_name);
+        }
 
-        A_local.Allocate(rows,sendcounts[rank]);
+        MPI_File mpi_file;
+        MPI_Info mpi_info;
+        iomrg::BinaryHeader header;
+        if (OpenFileBinary(mpi_file, mpi_info, header, file_name, mpi_comm) != 0) {
+            return 1;
+        }
+        if (header.numb_rows > INT_MAX || header.numb_columns > INT_MAX) {
+            MPI_File_close(&mpi_file);
+            MPI_Info_free(&mpi_info);
+            return 1;
+        }
 
+        dist.numb_rows = header.numb_rows;
+        dist.numb_columns = header.numb_columns;
+        A_local.Allocate(LocalNumbRows(dist), LocalNumbColumns(dist));
 
+        ReadFromFileBinary(A_local.GetCoef(), header, dist, mpi_file, mpi_info);
 
-        for(int i = 0; i < rows; i++)
-            MPI_Scatterv(A.GetCoef(i), sendcounts, shifts, MPI_DOUBLE, A_local.GetCoef(i), sendcounts[rank], MPI_DOUBLE, root,
-                     mpi_comm);
+        MPI_File_close(&mpi_file);
+        MPI_Info_free(&mpi_info);
 
         return 0;
     }
 
     ________________________________________________________________________________
 
-//! @internal assemble matrix upon processors (band column)
-    int AssembleMatrixBandColumn(
-            MatrixDense<double, int> &A_global,
-            const MatrixDense<double, int> &A,
-            int root,
+//! @internal write the local part of a matrix into a binary global file
+    int WriteMatrixToFileBinary(
+            const MatrixDense<double, int> &A_local,
+            const Distribution &dist,
+            const char *file_name,
             MPI_Comm &mpi_comm) {
 
-        return 0;
+        int rank;
+        MPI_Comm_rank(mpi_comm, &rank);
+        if (rank == 0) {
+            iomrg::printf(".w. Writing binary file (MPI-IO): %s \n", file_name);
+        }
+
+        return WriteToFileBinary(A_local.GetCoef(), dist,
+                                 dist.numb_rows, dist.numb_columns,
+                                 file_name, mpi_comm);
     }
 
     ________________________________________________________________________________
 
-//! @internal build the 'band_numb'-th band (column) of a matrix
-    int BuildMatrixBandColumn(
-            MatrixDense<double, int> &A_local,
-            const MatrixDense<double, int> &A,
-            const int numb_procs,
-            const int proc_numb) {
+//! @internal read the local part of a vector from a binary global file
+    int ReadVectorFromFileBinary(
+            Vector<double, int> &x_local,
+            Distribution &dist,
+            const char *file_name,
+            MPI_Comm &mpi_comm) {
+        TRACE_SCOPE("ReadVectorFromFileBinary");
+        MEMORY_TAG("ReadVectorFromFileBinary");
 
-        return 0;
-    }
+        int rank;
+        MPI_Comm_rank(mpi_comm, &rank);
+        if (rank == 0) {
+            iomrg::printf(".r. Reading binary file (MPI-IO): %s \n", file_name);
+        }
 
-    ________________________________________________________________________________
+        bool is_row = (dist.numb_rows == 1);
 
+        MPI_File mpi_file;
+        MPI_Info mpi_info;
+        iomrg::BinaryHeader header;
+        if (OpenFileBinary(mpi_file, mpi_info, header, file_name, mpi_comm) != 0) {
+            return 1;
+        }
+        // -- numb_rows x numb_columns elements must fit an int (no overflow)
+        if (header.numb_rows != 0 &&
+            header.numb_columns > INT_MAX / header.numb_rows) {
+            MPI_File_close(&mpi_file);
+            MPI_Info_free(&mpi_info);
+            return 1;
+        }
 
-// -----------------------------------------------------------------------------
-// -- Vector : BLOCK
-// -----------------------------------------------------------------------------
+        int size = header.numb_rows * header.numb_columns;
+        dist.numb_rows = is_row ? 1 : size;
+        dist.numb_columns = is_row ? size : 1;
+        x_local.Allocate(LocalNumbRows(dist) * LocalNumbColumns(dist));
 
-//! @internal distribute vector upon processors (block)
-    int DistributeVectorBlock(
-            Vector<double, int> &x_local,
-            const Vector<double, int> &x,
-            int root,
-            MPI_Comm &mpi_comm_rows,
-            MPI_Comm &mpi_comm_columns) {
+        ReadFromFileBinary(x_local.GetCoef(), header, dist, mpi_file, mpi_info);
+
+        MPI_File_close(&mpi_file);
+        MPI_Info_free(&mpi_info);
 
         return 0;
     }
 
     ________________________________________________________________________________
 
-//! @internal build the 'block_numb'-th band of a vector (block)
-    int BuildVectorBlock(
-            Vector<double, int> &x_local,
-            const Vector<double, int> &x,
-            const int numb_procs_i,
-            const int numb_procs_j,
-            const int proc_numb_i,
-            const int proc_numb_j) {
-
-        // -- size of the global vector
-        int size = x.GetSize();
+//! @internal write the local part of a vector into a binary global file
+    int WriteVectorToFileBinary(
+            const Vector<double, int> &x_local,
+            const Distribution &dist,
+            const char *file_name,
+            MPI_Comm &mpi_comm) {
 
-        // -- compute the number of block in j-
-        int size_local = BandSize(proc_numb_j, numb_procs_j, size);
-        // -- allocate and fill out the local vector
-        x_local.Allocate(size_local);
-        for (int j = 0; j < size_local; j++) {
-            // local (j) to global indice (l2g_j)
-            int l2g_j = BandPos(proc_numb_j, numb_procs_j, size) + j;
-            x_local(j) = x(l2g_j);
+        int rank;
+        MPI_Comm_rank(mpi_comm, &rank);
+        if (rank == 0) {
+            iomrg::printf(".w. Writing binary file (MPI-IO): %s \n", file_name);
         }
 
-        return 0;
+        return WriteToFileBinary(x_local.GetCoef(), dist,
+                                 dist.numb_rows * dist.numb_columns, 1,
+                                 file_name, mpi_comm);
     }
 
     ________________________________________________________________________________
 
 // -----------------------------------------------------------------------------
-// -- Matrix: BAND-ROW
+// -- Out-of-core (root streams a binary global file)
 // -----------------------------------------------------------------------------
 
-//! @internal distribute matrix upon processors (block)
-//! @remarks number of processors must be perfect square
-    int DistributeMatrixBlock(
+//! @internal distribute a matrix (band row) streamed by root from a binary file
+    int StreamMatrixBandRow(
             MatrixDense<double, int> &A_local,
-            const MatrixDense<double, int> &A,
+            MPI_File &mpi_file,
+            const iomrg::BinaryHeader &header,
+            int chunk_rows,
             int root,
-            MPI_Comm &mpi_comm_rows,
-            MPI_Comm &mpi_comm_columns) {
+            MPI_Comm &mpi_comm) {
+
+        int rank, nproc;
+        MPI_Comm_rank(mpi_comm, &rank);
+        MPI_Comm_size(mpi_comm, &nproc);
 
+        int rows = A_local.GetNumbRows();
+        int cols = A_local.GetNumbColumns();
+        int numb_rows = header.numb_rows;
+        int numb_chunks = (numb_rows + chunk_rows - 1) / chunk_rows;
+        int row_begin = BandPos(rank, nproc, numb_rows);
+        int row_end = row_begin + rows;
+        const int tag = 0;
+
+        // -- receive each chunk of my band in place, in order (non-overtaking)
+        int numb_recvs = 0;
+        MPI_Request *recv_requests = new MPI_Request[numb_chunks];
+        if (rank != root) {
+            for (int c = 0; c < numb_chunks; c++) {
+                int begin = (c * chunk_rows > row_begin) ? c * chunk_rows : row_begin;
+                int end = ((c + 1) * chunk_rows < row_end) ? (c + 1) * chunk_rows : row_end;
+                if (begin < end) {
+                    MPI_Irecv(A_local.GetCoef(begin - row_begin), (end - begin) * cols,
+                              MPI_DOUBLE, root, tag, mpi_comm, &recv_requests[numb_recvs++]);
+                }
+            }
+        } else {
+            // -- two buffers: read chunk c+1 while chunk c is sent
+            size_t chunk_size = (size_t) chunk_rows * cols;
+            double *buffers[2] = {new double[chunk_size], new double[chunk_size]};
+            const char *buffers_tag = Memory::Allocated(2 * chunk_size * sizeof(double),
+                                                        "StreamMatrixBandRow");
+            MPI_Request read_requests[2] = {MPI_REQUEST_NULL, MPI_REQUEST_NULL};
+            MPI_Request *send_requests[2] = {new MPI_Request[nproc], new MPI_Request[nproc]};
+            int numb_sends[2] = {0, 0};
+
+            for (int c = 0; c < numb_chunks && c < 2; c++) {
+                int c_rows = (numb_rows - c * chunk_rows < chunk_rows) ? numb_rows - c * chunk_rows
+                                                                        : chunk_rows;
+                MPI_File_iread_at(mpi_file,
+                                  header.data_offset + (MPI_Offset) c * chunk_size * sizeof(double),
+                                  buffers[c], c_rows * cols, MPI_DOUBLE, &read_requests[c]);
+            }
+
+            for (int c = 0; c < numb_chunks; c++) {
+                int b = c % 2;
+                int c_begin = c * chunk_rows;
+                int c_end = (c_begin + chunk_rows < numb_rows) ? c_begin + chunk_rows : numb_rows;
+                MPI_Wait(&read_requests[b], MPI_STATUS_IGNORE);
+
+                // -- forward each part of the chunk to the processor owning it
+                for (int k = BandProc(c_begin, nproc, numb_rows); k < nproc; k++) {
+                    int begin = BandPos(k, nproc, numb_rows);
+                    int end = begin + BandSize(k, nproc, numb_rows);
+                    if (begin >= c_end) {
+                        break;
+                    }
+                    begin = (begin > c_begin) ? begin : c_begin;
+                    end = (end < c_end) ? end : c_end;
+                    if (begin >= end) {
+                        continue;
+                    }
+                    double *part = buffers[b] + (size_t) (begin - c_begin) * cols;
+                    if (k == root) {
+                        memcpy(A_local.GetCoef(begin - row_begin), part,
+                               (size_t) (end - begin) * cols * sizeof(double));
+                    } else {
+                        MPI_Isend(part, (end - begin) * cols, MPI_DOUBLE, k, tag, mpi_comm,
+                                  &send_requests[b][numb_sends[b]++]);
+                    }
+                }
+
+                // -- the buffer is free once sent: read chunk c+2 into it
+                MPI_Waitall(numb_sends[b], send_requests[b], MPI_STATUSES_IGNORE);
+                numb_sends[b] = 0;
+                if (c + 2 < numb_chunks) {
+                    int c_rows = (numb_rows - (c + 2) * chunk_rows < chunk_rows)
+                                 ? numb_rows - (c + 2) * chunk_rows : chunk_rows;
+                    MPI_File_iread_at(mpi_file,
+                                      header.data_offset +
+                                      (MPI_Offset) (c + 2) * chunk_size * sizeof(double),
+                                      buffers[b], c_rows * cols, MPI_DOUBLE, &read_requests[b]);
+                }
+            }
+
+            delete[] buffers[0];
+            delete[] buffers[1];
+            Memory::Freed(2 * chunk_size * sizeof(double), buffers_tag);
+            delete[] send_requests[0];
+            delete[] send_requests[1];
+        }
 
+        MPI_Waitall(numb_recvs, recv_requests, MPI_STATUSES_IGNORE);
+        delete[] recv_requests;
 
         return 0;
     }
 
     ________________________________________________________________________________
 
-//! @internal assemble matrix upon processors (block)
-//! @remarks number of processors must be perfect square
-    int AssembleMatrixBlock(
-            MatrixDense<double, int> &A_global,
-            const MatrixDense<double, int> &A,
+//! @internal distribute a matrix (band row) streamed by root from a binary file
+    int StreamMatrixBandRowFromFile(
+            MatrixDense<double, int> &A_local,
+            const char *file_name,
             int root,
-            MPI_Comm &mpi_comm_rows,
-            MPI_Comm &mpi_comm_columns) {
-
+            MPI_Comm &mpi_comm,
+            size_t buffer_size) {
+        TRACE_SCOPE("StreamMatrixBandRowFromFile");
+        MEMORY_TAG("StreamMatrixBandRowFromFile");
 
-        return 0;
-    }
+        int rank, nproc;
+        MPI_Comm_rank(mpi_comm, &rank);
+        MPI_Comm_size(mpi_comm, &nproc);
 
-    ________________________________________________________________________________
+        // -- only root opens the file
+        MPI_File mpi_file;
+        MPI_Info mpi_info;
+        iomrg::BinaryHeader header;
+        int error = 0;
+        if (rank == root) {
+            MPI_Comm mpi_comm_self = MPI_COMM_SELF;
+            error = OpenFileBinary(mpi_file, mpi_info, header, file_name, mpi_comm_self);
+        }
+        MPI_Bcast(&error, 1, MPI_INT, root, mpi_comm);
+        if (error != 0) {
+            return 1;
+        }
+        MPI_Bcast(&header, sizeof(header), MPI_BYTE, root, mpi_comm);
+
+        int numb_rows = header.numb_rows;
+        int numb_columns = header.numb_columns;
+        A_local.Allocate(BandSize(rank, nproc, numb_rows), numb_columns);
+
+        // -- rows of a chunk: half of the buffer (double buffering), at least one
+        size_t row_bytes = (size_t) numb_columns * sizeof(double);
+        int chunk_rows = (row_bytes > 0) ? (int) (buffer_size / 2 / row_bytes) : numb_rows;
+        chunk_rows = (chunk_rows < 1) ? 1 : chunk_rows;
+        chunk_rows = (chunk_rows > numb_rows && numb_rows > 0) ? numb_rows : chunk_rows;
+
+        if (numb_rows > 0) {
+            TRACE_BEGIN("io");
+            StreamMatrixBandRow(A_local, mpi_file, header, chunk_rows, root, mpi_comm);
+            TRACE_END();
+        }
 
-//! @internal build the 'band_numb'-th block of a matrix
-//! @remarks proc_numb follows row major order
-//! @remarks proc_numb = proc_numb_i * numb_procs_j + proc_numb_j
-//! @note number of processors must be perfect square
-    int BuildMatrixMatrixBlock(
-            MatrixDense<double, int> &A_local,
-            const MatrixDense<double, int> &A,
-            const int numb_procs_i,
-            const int numb_procs_j,
-            const int proc_numb_i,
-            const int proc_numb_j) {
+        if (rank == root) {
+            MPI_File_close(&mpi_file);
+            MPI_Info_free(&mpi_info);
+        }
 
         return 0;
     }
 
+    ________________________________________________________________________________
+
 // -----------------------------------------------------------------------------
 // -- Read Local
 // -----------------------------------------------------------------------------
@@ -509,7 +3288,7 @@ namespace DataTopology {
     ________________________________________________________________________________
 
 //! @internal get the filename of given processor among others
-    const char *GetProcFilename(
+    std::string GetProcFilename(
             const char *file_group_name,
             const char *file_group_type,
             const int proc_numb,
@@ -559,7 +3338,7 @@ namespace DataTopology {
                                        + "_" + prefix_str + "."
                                        + std::string(file_group_type);
 
-        return strdup(output_file_name.c_str());
+        return output_file_name;
     }
 
     ________________________________________________________________________________
@@ -573,12 +3352,11 @@ namespace DataTopology {
             const int proc_numb) {
 
         // -- format file name
-        const char *output_file_name = NULL;
-        output_file_name = GetProcFilename(file_group_name, file_group_type,
-                                           numb_procs, proc_numb);
+        std::string output_file_name = GetProcFilename(file_group_name, file_group_type,
+                                                       proc_numb, numb_procs);
 
         // -- read vector
-        x_local.ReadFromFileCsv(output_file_name);
+        x_local.ReadFromFileCsv(output_file_name.c_str());
 
         return 0;
     }
@@ -595,17 +3373,266 @@ namespace DataTopology {
             const bool opt_image_matrix) {
 
         // -- format file name
-        const char *output_file_name = NULL;
-        output_file_name = GetProcFilename(file_group_name, file_group_type,
-                                           numb_procs, proc_numb);
+        std::string output_file_name = GetProcFilename(file_group_name, file_group_type,
+                                                       proc_numb, numb_procs);
 
         // -- read matrix
         if (opt_image_matrix) {
             // -- read image matrix from file csv
-            A_local.ReadImageMatrixFromFileCsv(output_file_name);
+            A_local.ReadImageMatrixFromFileCsv(output_file_name.c_str());
         } else {
             // -- read image matrix from file csv
-            A_local.ReadFromFileCsv(output_file_name);
+            A_local.ReadFromFileCsv(output_file_name.c_str());
+        }
+
+        return 0;
+    }
+
+    ________________________________________________________________________________
+
+// -----------------------------------------------------------------------------
+// -- Sharded dataset (one binary shard per processor, manifest)
+// -----------------------------------------------------------------------------
+
+    ________________________________________________________________________________
+
+//! @internal description of a shard in the manifest
+    struct ShardRecord {
+        int64_t row_begin;
+        int64_t column_begin;
+        int64_t numb_rows;
+        int64_t numb_columns;
+        int64_t data_offset;
+        int64_t data_size;
+        uint64_t checksum;
+    };
+
+    ________________________________________________________________________________
+
+//! @internal manifest of a sharded dataset
+    struct ShardManifest {
+        Distribution dist;
+        std::vector<ShardRecord> records;
+        std::vector<std::string> file_names;
+    };
+
+    ________________________________________________________________________________
+
+//! @internal file name of the manifest of a sharded dataset
+    std::string ShardManifestFilename(
+            const char *file_group_name) {
+
+        return std::string(file_group_name) + ".manifest";
+    }
+
+    ________________________________________________________________________________
+
+//! @internal file name of a shard (relative to the directory of the manifest)
+    std::string ShardFilename(
+            const char *file_group_name,
+            const int shard_numb,
+            const Distribution &dist,
+            const bool opt_base_name) {
+
+        std::string file_name = GetProcFilename(file_group_name, "bin", shard_numb,
+                                                dist.numb_procs_i, dist.numb_procs_j);
+        size_t pos = file_name.find_last_of('/');
+        if (opt_base_name && pos != std::string::npos) {
+            return file_name.substr(pos + 1);
+        }
+        return file_name;
+    }
+
+    ________________________________________________________________________________
+
+//! @internal write the manifest of a sharded dataset
+    int WriteShardManifest(
+            const ShardManifest &manifest,
+            const char *file_group_name) {
+
+        std::string file_name = ShardManifestFilename(file_group_name);
+        FILE *file = fopen(file_name.c_str(), "w");
+        if (file == NULL) {
+            return 1;
+        }
+
+        const Distribution &dist = manifest.dist;
+        fprintf(file, "MRGSHARDS 1\n");
+        fprintf(file, "dims %d %d\n", dist.numb_rows, dist.numb_columns);
+        fprintf(file, "distribution %d %d %d %d %d\n", dist.type,
+                dist.numb_procs_i, dist.numb_procs_j,
+                dist.block_rows, dist.block_columns);
+        fprintf(file, "shards %d\n", (int) manifest.records.size());
+        fprintf(file, "# shard row_begin column_begin numb_rows numb_columns "
+                      "data_offset data_size checksum file\n");
+        for (size_t k = 0; k < manifest.records.size(); k++) {
+            const ShardRecord &record = manifest.records[k];
+            fprintf(file, "shard %d %lld %lld %lld %lld %lld %lld %016llx %s\n", (int) k,
+                    (long long) record.row_begin, (long long) record.column_begin,
+                    (long long) record.numb_rows, (long long) record.numb_columns,
+                    (long long) record.data_offset, (long long) record.data_size,
+                    (unsigned long long) record.checksum,
+                    manifest.file_names[k].c_str());
+        }
+
+        int error = ferror(file);
+        error += fclose(file);
+
+        return (error == 0) ? 0 : 1;
+    }
+
+    ________________________________________________________________________________
+
+//! @internal parse and validate the manifest of a sharded dataset
+    int ParseShardManifest(
+            ShardManifest &manifest,
+            const std::string &text) {
+
+        std::stringstream ss_text(text);
+        std::string line;
+        Distribution &dist = manifest.dist;
+        int version = 0;
+        int numb_shards = -1;
+        int numb_fields = 0;
+        int numb_found = 0;
+
+        // -- header lines
+        while (std::getline(ss_text, line)) {
+            if (line.empty() || line[0] == '#') {
+                continue;
+            }
+            char key[32];
+            if (sscanf(line.c_str(), "%31s", key) != 1) {
+                return 1;
+            }
+            if (strcmp(key, "MRGSHARDS") == 0) {
+                numb_fields += sscanf(line.c_str(), "%*s %d", &version);
+            } else if (strcmp(key, "dims") == 0) {
+                numb_fields += sscanf(line.c_str(), "%*s %d %d",
+                                      &dist.numb_rows, &dist.numb_columns);
+            } else if (strcmp(key, "distribution") == 0) {
+                numb_fields += sscanf(line.c_str(), "%*s %d %d %d %d %d", &dist.type,
+                                      &dist.numb_procs_i, &dist.numb_procs_j,
+                                      &dist.block_rows, &dist.block_columns);
+            } else if (strcmp(key, "shards") == 0) {
+                numb_fields += sscanf(line.c_str(), "%*s %d", &numb_shards);
+                break;
+            } else {
+                return 1;
+            }
+        }
+        if (numb_fields != 9 || version != 1 || numb_shards < 1 ||
+            dist.numb_rows < 0 || dist.numb_columns < 0 ||
+            dist.type < distribution::c_BAND_ROW ||
+            dist.type > distribution::c_BLOCK_CYCLIC ||
+            dist.numb_procs_i < 1 || dist.numb_procs_j < 1 ||
+            dist.block_rows < 1 || dist.block_columns < 1 ||
+            numb_shards != dist.numb_procs_i * dist.numb_procs_j) {
+            return 1;
+        }
+
+        // -- one line per shard, each shard exactly once
+        manifest.records.assign(numb_shards, ShardRecord());
+        manifest.file_names.assign(numb_shards, std::string());
+        while (std::getline(ss_text, line)) {
+            if (line.empty() || line[0] == '#') {
+                continue;
+            }
+            int k = -1;
+            long long row_begin, column_begin, numb_rows, numb_columns;
+            long long data_offset, data_size;
+            unsigned long long checksum;
+            char file_name[4096];
+            if (sscanf(line.c_str(), "shard %d %lld %lld %lld %lld %lld %lld %llx %4095s",
+                       &k, &row_begin, &column_begin, &numb_rows, &numb_columns,
+                       &data_offset, &data_size, &checksum, file_name) != 9 ||
+                k < 0 || k >= numb_shards || !manifest.file_names[k].empty()) {
+                return 1;
+            }
+
+            // -- the shard is the part of its processor in the distribution
+            Distribution dist_k;
+            CreateDistribution(dist_k, dist.type, dist.numb_rows, dist.numb_columns,
+                               dist.numb_procs_i, dist.numb_procs_j,
+                               k / dist.numb_procs_j, k % dist.numb_procs_j,
+                               dist.block_rows, dist.block_columns);
+            if (numb_rows != LocalNumbRows(dist_k) ||
+                numb_columns != LocalNumbColumns(dist_k) ||
+                row_begin != LocalToGlobalRow(dist_k, 0) ||
+                column_begin != LocalToGlobalColumn(dist_k, 0) ||
+                data_size != numb_rows * numb_columns * (long long) sizeof(double) ||
+                data_offset < (long long) sizeof(iomrg::BinaryHeader)) {
+                return 1;
+            }
+
+            ShardRecord &record = manifest.records[k];
+            record.row_begin = row_begin;
+            record.column_begin = column_begin;
+            record.numb_rows = numb_rows;
+            record.numb_columns = numb_columns;
+            record.data_offset = data_offset;
+            record.data_size = data_size;
+            record.checksum = checksum;
+            manifest.file_names[k] = file_name;
+            numb_found++;
+        }
+
+        return (numb_found == numb_shards) ? 0 : 1;
+    }
+
+    ________________________________________________________________________________
+
+//! @internal read a shard (header, then elements) with readahead
+    int ReadShard(
+            MatrixDense<double, int> &A_local,
+            const ShardRecord &record,
+            const char *file_name,
+            const bool opt_check) {
+        MEMORY_TAG("ReadShard");
+
+        int fd = open(file_name, O_RDONLY);
+        if (fd < 0) {
+            return 1;
+        }
+
+        // -- sequential access, the kernel starts reading the whole shard now
+        posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+        posix_fadvise(fd, record.data_offset, record.data_size, POSIX_FADV_WILLNEED);
+
+        iomrg::BinaryHeader header;
+        if (pread(fd, &header, sizeof(header), 0) != (ssize_t) sizeof(header) ||
+            iomrg::CheckBinaryHeader(header) != 0 ||
+            header.numb_rows != record.numb_rows ||
+            header.numb_columns != record.numb_columns ||
+            header.data_offset != record.data_offset ||
+            header.checksum != record.checksum) {
+            close(fd);
+            return 1;
+        }
+
+        // -- allocation overlaps the readahead
+        A_local.Allocate(record.numb_rows, record.numb_columns);
+        char *data = (char *) A_local.GetCoef();
+        int64_t numb_read = 0;
+        while (numb_read < record.data_size) {
+            size_t size = record.data_size - numb_read;
+            size = (size > ((size_t) 1 << 30)) ? ((size_t) 1 << 30) : size;
+            ssize_t n = pread(fd, data + numb_read, size, record.data_offset + numb_read);
+            if (n < 0 && errno == EINTR) {
+                continue;
+            }
+            if (n <= 0) {
+                break;
+            }
+            numb_read += n;
+        }
+        close(fd);
+
+        if (numb_read != record.data_size) {
+            return 1;
+        }
+        if (opt_check && iomrg::ChecksumBinary(data, record.data_size) != record.checksum) {
+            return 1;
         }
 
         return 0;
@@ -613,4 +3640,207 @@ namespace DataTopology {
 
     ________________________________________________________________________________
 
+//! @internal write the local part of a matrix as a shard of a sharded dataset
+    int WriteMatrixToShards(
+            const MatrixDense<double, int> &A_local,
+            const Distribution &dist,
+            const char *file_group_name,
+            MPI_Comm &mpi_comm) {
+        TRACE_SCOPE("WriteMatrixToShards");
+
+        int rank, nproc;
+        MPI_Comm_rank(mpi_comm, &rank);
+        MPI_Comm_size(mpi_comm, &nproc);
+        const int root = 0;
+
+        if (rank == root) {
+            iomrg::printf(".w. Writing sharded dataset: %s \n", file_group_name);
+        }
+
+        if (dist.numb_procs_i * dist.numb_procs_j != nproc) {
+            return 1;
+        }
+        const int shard_numb = dist.proc_numb_i * dist.numb_procs_j + dist.proc_numb_j;
+
+        // -- the shard
+        ShardRecord record;
+        iomrg::BinaryHeader header;
+        iomrg::InitBinaryHeader(header, A_local.GetNumbRows(), A_local.GetNumbColumns());
+        record.row_begin = LocalToGlobalRow(dist, 0);
+        record.column_begin = LocalToGlobalColumn(dist, 0);
+        record.numb_rows = header.numb_rows;
+        record.numb_columns = header.numb_columns;
+        record.data_offset = header.data_offset;
+        record.data_size = record.numb_rows * record.numb_columns * sizeof(double);
+        record.checksum = iomrg::ChecksumBinary(A_local.GetCoef(), record.data_size);
+
+        std::string file_name = ShardFilename(file_group_name, shard_numb, dist, false);
+        TRACE_BEGIN("io");
+        int error = iomrg::WriteFileBinary(file_name.c_str(), A_local.GetCoef(),
+                                           record.numb_rows, record.numb_columns);
+        TRACE_END();
+
+        // -- root gathers the records and writes the manifest
+        int shard_numbs[nproc];
+        std::vector<ShardRecord> records((rank == root) ? nproc : 0);
+        TRACE_BEGIN("metadata");
+        MPI_Gather(&shard_numb, 1, MPI_INT, shard_numbs, 1, MPI_INT, root, mpi_comm);
+        MPI_Gather(&record, sizeof(ShardRecord), MPI_BYTE, records.data(),
+                   sizeof(ShardRecord), MPI_BYTE, root, mpi_comm);
+
+        if (rank == root) {
+            ShardManifest manifest;
+            manifest.dist = dist;
+            manifest.records.assign(nproc, ShardRecord());
+            manifest.file_names.assign(nproc, std::string());
+            for (int p = 0; p < nproc; p++) {
+                int k = shard_numbs[p];
+                if (k < 0 || k >= nproc || !manifest.file_names[k].empty()) {
+                    error = 1;
+                    break;
+                }
+                manifest.records[k] = records[p];
+                manifest.file_names[k] = ShardFilename(file_group_name, k, dist, true);
+            }
+            if (error == 0) {
+                error = WriteShardManifest(manifest, file_group_name);
+            }
+        }
+        TRACE_END();
+
+        MPI_Allreduce(MPI_IN_PLACE, &error, 1, MPI_INT, MPI_MAX, mpi_comm);
+
+        return error;
+    }
+
+    ________________________________________________________________________________
+
+//! @internal read the local part of a matrix from a sharded dataset
+    int ReadMatrixFromShards(
+            MatrixDense<double, int> &A_local,
+            Distribution &dist,
+            const char *file_group_name,
+            MPI_Comm &mpi_comm,
+            const bool opt_check) {
+        TRACE_SCOPE("ReadMatrixFromShards");
+
+        int rank, nproc;
+        MPI_Comm_rank(mpi_comm, &rank);
+        MPI_Comm_size(mpi_comm, &nproc);
+        const int root = 0;
+
+        if (rank == root) {
+            iomrg::printf(".r. Reading sharded dataset: %s \n", file_group_name);
+        }
+
+        // -- root reads the manifest, everyone gets a copy
+        TRACE_BEGIN("metadata");
+        std::string text;
+        long long text_size = -1;
+        if (rank == root) {
+            std::string file_name = ShardManifestFilename(file_group_name);
+            FILE *file = fopen(file_name.c_str(), "r");
+            if (file != NULL) {
+                fseek(file, 0, SEEK_END);
+                text_size = ftell(file);
+                fseek(file, 0, SEEK_SET);
+                text.resize(text_size > 0 ? text_size : 0);
+                if (text_size > 0 && fread(&text[0], text_size, 1, file) != 1) {
+                    text_size = -1;
+                }
+                fclose(file);
+            }
+        }
+        MPI_Bcast(&text_size, 1, MPI_LONG_LONG, root, mpi_comm);
+        if (text_size < 0) {
+            TRACE_END();
+            return 1;
+        }
+        text.resize(text_size);
+        MPI_Bcast(&text[0], text_size, MPI_CHAR, root, mpi_comm);
+        TRACE_END();
+
+        ShardManifest manifest;
+        if (ParseShardManifest(manifest, text) != 0 ||
+            (int) manifest.records.size() != nproc) {
+            return 1;
+        }
+
+        // -- the processor of rank r owns the shard r
+        const Distribution &dist_m = manifest.dist;
+        CreateDistribution(dist, dist_m.type, dist_m.numb_rows, dist_m.numb_columns,
+                           dist_m.numb_procs_i, dist_m.numb_procs_j,
+                           rank / dist_m.numb_procs_j, rank % dist_m.numb_procs_j,
+                           dist_m.block_rows, dist_m.block_columns);
+
+        // -- shards are next to the manifest
+        std::string file_name = manifest.file_names[rank];
+        std::string group_name(file_group_name);
+        size_t pos = group_name.find_last_of('/');
+        if (pos != std::string::npos) {
+            file_name = group_name.substr(0, pos + 1) + file_name;
+        }
+
+        TRACE_BEGIN("io");
+        int error = ReadShard(A_local, manifest.records[rank], file_name.c_str(), opt_check);
+        TRACE_END();
+        MPI_Allreduce(MPI_IN_PLACE, &error, 1, MPI_INT, MPI_MAX, mpi_comm);
+
+        return error;
+    }
+
+    ________________________________________________________________________________
+
+//! @internal convert csv shards (GetProcFilename names) into a sharded dataset
+    int ConvertShardsFromFileCsv(
+            const char *file_group_name_csv,
+            const char *file_group_type_csv,
+            const char *file_group_name,
+            const int numb_procs_i,
+            const int numb_procs_j,
+            MPI_Comm &mpi_comm) {
+
+        int rank, nproc;
+        MPI_Comm_rank(mpi_comm, &rank);
+        MPI_Comm_size(mpi_comm, &nproc);
+
+        // -- band-row names have no grid (numb_procs_j = 0)
+        const int numb_procs_grid_j = (numb_procs_j == 0) ? 1 : numb_procs_j;
+        if (numb_procs_i * numb_procs_grid_j != nproc) {
+            return 1;
+        }
+        const int proc_numb_i = rank / numb_procs_grid_j;
+        const int proc_numb_j = rank % numb_procs_grid_j;
+
+        MatrixDense<double, int> A_local;
+        std::string file_name = GetProcFilename(file_group_name_csv, file_group_type_csv,
+                                                rank, numb_procs_i, numb_procs_j);
+        int error = (A_local.ReadFromFileCsv(file_name.c_str()) != 0);
+
+        // -- global sizes: rows along a column of processors, columns along a row
+        int sizes[2];
+        sizes[0] = (proc_numb_j == 0) ? A_local.GetNumbRows() : 0;
+        sizes[1] = (proc_numb_i == 0) ? A_local.GetNumbColumns() : 0;
+        MPI_Allreduce(MPI_IN_PLACE, sizes, 2, MPI_INT, MPI_SUM, mpi_comm);
+
+        int type = (numb_procs_j == 0) ? distribution::c_BAND_ROW : distribution::c_BLOCK;
+        Distribution dist;
+        CreateDistribution(dist, type, sizes[0], sizes[1], numb_procs_i, numb_procs_grid_j,
+                           proc_numb_i, proc_numb_j);
+
+        // -- the csv shards must be the bands of the distribution
+        if (A_local.GetNumbRows() != LocalNumbRows(dist) ||
+            A_local.GetNumbColumns() != LocalNumbColumns(dist)) {
+            error = 1;
+        }
+        MPI_Allreduce(MPI_IN_PLACE, &error, 1, MPI_INT, MPI_MAX, mpi_comm);
+        if (error != 0) {
+            return 1;
+        }
+
+        return WriteMatrixToShards(A_local, dist, file_group_name, mpi_comm);
+    }
+
+    ________________________________________________________________________________
+
 } // namespace DataTopology {
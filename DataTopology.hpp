@@ -12,11 +12,16 @@
 
 // basic packages
 #include <mpi.h>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
 
 // project packages
 #include "dllmrg.hpp"
 #include "Vector.hpp"
 #include "MatrixDense.hpp"
+#include "Tune.hpp"
 
 // third-party packages
 
@@ -62,17 +67,469 @@ int BandTopology (
         int numb_procs,
         int shift = 1 ) ;
 
+//! @brief weighted band list start and position
+//! @param [in,out] band_list_start = band list start position
+//! @param [in,out] band_list_size = band list size
+//! @param [in] size = global size
+//! @param [in] weights = weight of each processor (numb_procs = weights size)
+//! @param [in] shift = shift start and size
+//! @remarks band sizes are proportional to the weights (even if all weights are 0)
+//! @return error code
+int BandTopology (
+        int*& band_list_start,
+        int*& band_list_size,
+        int size,
+        const Vector<double,int>& weights,
+        int shift = 1 ) ;
+
+//! @brief band weights of the processors (relative speed)
+//! @param [in,out] weights = weight of each processor (sum to numb_procs)
+//! @param [in] mpi_comm = MPI communicator
+//! @param [in] file_name = weights file, loaded if it exists and matches the
+//         number of processors, written after measuring otherwise (NULL: no file)
+//! @param [in] size = size of the GEMV micro-benchmark
+//! @param [in] numb_reps = number of repetitions of the micro-benchmark
+//! @remarks all processors run the micro-benchmark at the same time,
+//           the weight of a processor is its GEMV speed
+//! @return error code
+int CalibrateBandWeights (
+        Vector<double,int>& weights,
+        MPI_Comm& mpi_comm,
+        const char* file_name = NULL,
+        int size = 1000,
+        int numb_reps = 10 ) ;
+
+// -----------------------------------------------------------------------------
+// -- Context (communicators and scratch buffers cached per communicator)
+// -----------------------------------------------------------------------------
+
+//! @struct ContextGrid
+//! @brief communicators of a processor grid
+struct ContextGrid {
+  //! grid communicator (cartesian)
+  MPI_Comm mpi_comm_cart;
+  //! grid rows communicator
+  MPI_Comm mpi_comm_rows;
+  //! grid columns communicator
+  MPI_Comm mpi_comm_columns;
+} ; // struct ContextGrid {
+
+//! @struct ContextTune
+//! @brief parameters agreed on a communicator (see Tune::Agree)
+struct ContextTune {
+  //! generation of the parameters in use when agreed (see Tune::Set, -1: none)
+  int generation = -1;
+  //! parameters agreed
+  Tune::Parameters params;
+  //! error code of the agreement (1: parameters differed, defaults used)
+  int error = 0;
+} ; // struct ContextTune {
+
+//! @struct Context
+//! @brief communicators and scratch buffers cached on an MPI communicator
+//! @remarks owned by the library: created on first use, released when the
+//           communicator is freed, by FreeContext, or at MPI_Finalize;
+//           communicators of a context must not be freed by the caller
+struct Context {
+  //! MPI communicator (not owned)
+  MPI_Comm mpi_comm;
+  //! node communicator (MPI_COMM_NULL until first use)
+  MPI_Comm mpi_comm_node;
+  //! node number
+  int node_numb;
+  //! number of nodes
+  int numb_nodes;
+  //! grids by dimensions (numb_procs_i, numb_procs_j)
+  std::map< std::pair<int,int>, ContextGrid > grids;
+  //! scratch buffers by slot
+  std::map< int, std::vector<double> > scratch;
+  //! memory tag of the scratch buffers by slot (see Memory::Allocated)
+  std::map< int, const char* > scratch_tags;
+  //! parameters agreed by second communicator (MPI_COMM_NULL: none)
+  std::map< MPI_Comm, ContextTune > tunes;
+} ; // struct Context {
+
+//! @brief context of an MPI communicator
+//! @param [in,out] context = context (created on first use)
+//! @param [in] mpi_comm = MPI communicator
+//! @return error code
+int GetContext (
+        Context*& context,
+        MPI_Comm& mpi_comm ) ;
+
+//! @brief scratch buffer of the context of an MPI communicator
+//! @param [in,out] buffer = buffer of at least numb_elements elements
+//! @param [in] numb_elements = number of elements
+//! @param [in] mpi_comm = MPI communicator
+//! @param [in] slot = slot (independent buffers of a same communicator)
+//! @remarks the buffer only grows; it is valid until the next call with the
+//           same communicator and slot; its bytes are counted under the tag
+//           DataTopology::ScratchBuffer, whatever the tag of the caller
+//! @return error code
+int ScratchBuffer (
+        double*& buffer,
+        size_t numb_elements,
+        MPI_Comm& mpi_comm,
+        int slot = 0 ) ;
+
+//! @brief release the context of an MPI communicator (communicators and buffers)
+//! @param [in] mpi_comm = MPI communicator
+//! @remarks collective on mpi_comm
+//! @return error code
+int FreeContext (
+        MPI_Comm& mpi_comm ) ;
+
+//! @brief release all contexts, in reverse order of creation
+//! @remarks collective, called by MPI_Finalize
+//! @return error code
+int FreeContexts ( ) ;
+
+//! @struct operation
+//! @brief distributed operation (choice of the processor grid)
+struct operation {
+
+  //! @enum operation_enum
+  enum operation_enum {
+    //! matrix-vector product y := A * x
+    c_GEMV = 0,
+    //! matrix-matrix product C := A * B (SUMMA)
+    c_GEMM = 1
+  }  ; // enum operation_enum {
+
+} ; // struct operation {
+
+//! @struct NetworkModel
+//! @brief alpha-beta model of the network: a message of b bytes takes
+//         alpha + b * beta seconds
+struct NetworkModel {
+  //! latency (s)
+  double alpha;
+  //! inverse bandwidth (s / byte)
+  double beta;
+} ; // struct NetworkModel {
+
+//! @brief predicted communication time of an operation on a processor grid
+//! @param [in] numb_procs_i = number of processors (i-)
+//! @param [in] numb_procs_j = number of processors (j-)
+//! @param [in] numb_rows = global number of rows of A (C for GEMM)
+//! @param [in] numb_columns = global number of columns of A (C for GEMM)
+//! @param [in] numb_inner = inner dimension of GEMM (0: numb_columns)
+//! @param [in] operation = operation (operation::operation_enum)
+//! @param [in] model = network model
+//! @remarks GEMV: broadcast of x along the processor columns and sum of the
+//           partial y along the processor rows; GEMM: broadcast of the panels
+//           of A along the processor rows and of B along the processor columns
+//! @return time (s)
+double GridCost (
+        int numb_procs_i,
+        int numb_procs_j,
+        int numb_rows,
+        int numb_columns,
+        int numb_inner,
+        int operation,
+        const NetworkModel& model ) ;
+
+//! @brief processor grid minimizing the predicted communication time
+//! @param [in,out] numb_procs_i = number of processors (i-)
+//! @param [in,out] numb_procs_j = number of processors (j-)
+//! @param [in] numb_procs = number of processors
+//! @param [in] numb_rows = global number of rows of A (C for GEMM)
+//! @param [in] numb_columns = global number of columns of A (C for GEMM)
+//! @param [in] operation = operation (operation::operation_enum)
+//! @param [in] model = network model (default: 1 us, 10 GB/s)
+//! @param [in] numb_inner = inner dimension of GEMM (0: numb_columns)
+//! @remarks every factorization numb_procs_i x numb_procs_j of numb_procs is
+//           evaluated; ties go to the squarest grid, numb_procs_i >= numb_procs_j
+//! @return error code
+int GridDims (
+        int& numb_procs_i,
+        int& numb_procs_j,
+        int numb_procs,
+        int numb_rows,
+        int numb_columns,
+        int operation = operation::c_GEMV,
+        const NetworkModel& model = NetworkModel{ 1.e-6, 1.e-10 },
+        int numb_inner = 0 ) ;
+
 //! @brief creation of two-dimensional grid communicator and communicators
 //         for each row and each column of the grid
 //! @param [in,out] mpi_comm_rows = grid rows communicator
 //! @param [in,out] mpi_comm_columns = grid columns communicator
 //! @param [in] mpi_comm = MPI communicator
+//! @remarks the shape of the matrix is unknown: the grid is the squarest one
+//           (mathmrg::CreateDims)
+//! @remarks the communicators are cached in the context of mpi_comm (one
+//           grid per dimensions) and must not be freed by the caller
+//! @remarks processors are placed explicitly: sorted by node (MPI_Comm_split_type),
+//           the grid is filled row by row, so that a row (a column for a
+//           numb_procs x 1 grid) spans as few nodes as possible (GridNodeEdges)
+//! @return error code
+int GridCartesianComm (
+        MPI_Comm& mpi_comm_rows,
+        MPI_Comm& mpi_comm_columns,
+        MPI_Comm& mpi_comm ) ;
+
+//! @brief creation of two-dimensional grid communicator and communicators
+//         for each row and each column of the grid, the grid minimizing the
+//         communication of an operation on a matrix (GridDims)
+//! @param [in,out] mpi_comm_rows = grid rows communicator
+//! @param [in,out] mpi_comm_columns = grid columns communicator
+//! @param [in] mpi_comm = MPI communicator
+//! @param [in] numb_rows = global number of rows of A (C for GEMM)
+//! @param [in] numb_columns = global number of columns of A (C for GEMM)
+//! @param [in] operation = operation (operation::operation_enum)
+//! @param [in] model = network model (default: 1 us, 10 GB/s)
+//! @param [in] numb_inner = inner dimension of GEMM (0: numb_columns)
 //! @return error code
 int GridCartesianComm (
         MPI_Comm& mpi_comm_rows,
         MPI_Comm& mpi_comm_columns,
+        MPI_Comm& mpi_comm,
+        int numb_rows,
+        int numb_columns,
+        int operation = operation::c_GEMV,
+        const NetworkModel& model = NetworkModel{ 1.e-6, 1.e-10 },
+        int numb_inner = 0 ) ;
+
+//! @brief communicator of the processors sharing a node
+//! @param [in,out] mpi_comm_node = node communicator (MPI_COMM_TYPE_SHARED),
+//         cached in the context of mpi_comm
+//! @param [in,out] node_numb = node number (nodes numbered by their lowest rank)
+//! @param [in,out] numb_nodes = number of nodes
+//! @param [in] mpi_comm = MPI communicator
+//! @return error code
+int NodeComm (
+        MPI_Comm& mpi_comm_node,
+        int& node_numb,
+        int& numb_nodes,
+        MPI_Comm& mpi_comm ) ;
+
+//! @brief intra- and inter-node edges of the rows and columns of a grid
+//! @param [in,out] numb_edges_intra_rows = pairs of a grid row on the same node
+//! @param [in,out] numb_edges_inter_rows = pairs of a grid row on two nodes
+//! @param [in,out] numb_edges_intra_columns = pairs of a grid column on the same node
+//! @param [in,out] numb_edges_inter_columns = pairs of a grid column on two nodes
+//! @param [in] mpi_comm_rows = grid rows communicator
+//! @param [in] mpi_comm_columns = grid columns communicator
+//! @remarks collective on the grid, sums over all rows (columns) of the grid
+//! @return error code (1 if the communicators do not belong to a grid)
+int GridNodeEdges (
+        int& numb_edges_intra_rows,
+        int& numb_edges_inter_rows,
+        int& numb_edges_intra_columns,
+        int& numb_edges_inter_columns,
+        MPI_Comm& mpi_comm_rows,
+        MPI_Comm& mpi_comm_columns ) ;
+
+//! @brief get the two-dimensional grid communicator attached to the grid rows
+//         (or columns) communicator by GridCartesianComm
+//! @param [in,out] mpi_comm_grid = grid communicator (cartesian)
+//! @param [in] mpi_comm_rows = grid rows (or columns) communicator
+//! @return error code (1 if the communicator does not belong to a grid)
+int GridComm (
+        MPI_Comm& mpi_comm_grid,
+        MPI_Comm& mpi_comm_rows ) ;
+
+//! @brief rank in the grid communicator of a processor of the communicator
+//         the grid was created from (GridCartesianComm)
+//! @param [in,out] grid_rank = rank in the grid communicator (GridComm)
+//! @param [in] rank = rank in the communicator given to GridCartesianComm
+//! @param [in] mpi_comm_rows = grid rows (or columns) communicator
+//! @remarks the grid follows the placement of the processors on the nodes
+//           (NodePlacementComm): only rank 0 keeps its rank in the grid
+//! @return error code (1 if the communicator does not belong to a grid)
+int GridRank (
+        int& grid_rank,
+        int rank,
+        MPI_Comm& mpi_comm_rows ) ;
+
+// -----------------------------------------------------------------------------
+// -- block-cyclic distribution - topology
+// -----------------------------------------------------------------------------
+
+//! @brief number of local indices owned by a processor (block-cyclic)
+//! @param [in] proc_numb = processor number
+//! @param [in] numb_procs = number of processors
+//! @param [in] block_size = size of a block
+//! @param [in] size = global size
+//! @return number of local indices (numroc)
+int CyclicSize (
+        int proc_numb,
+        int numb_procs,
+        int block_size,
+        int size ) ;
+
+//! @brief local to global index (block-cyclic)
+//! @param [in] idx_local = local index
+//! @param [in] proc_numb = processor number
+//! @param [in] numb_procs = number of processors
+//! @param [in] block_size = size of a block
+//! @return global index
+int CyclicLocalToGlobal (
+        int idx_local,
+        int proc_numb,
+        int numb_procs,
+        int block_size ) ;
+
+//! @brief global to local index (block-cyclic)
+//! @param [in] idx_global = global index
+//! @param [in] numb_procs = number of processors
+//! @param [in] block_size = size of a block
+//! @return local index on the owner processor
+int CyclicGlobalToLocal (
+        int idx_global,
+        int numb_procs,
+        int block_size ) ;
+
+//! @brief owner processor of a global index (block-cyclic)
+//! @param [in] idx_global = global index
+//! @param [in] numb_procs = number of processors
+//! @param [in] block_size = size of a block
+//! @return processor number
+int CyclicGlobalToProc (
+        int idx_global,
+        int numb_procs,
+        int block_size ) ;
+
+// -----------------------------------------------------------------------------
+// -- distribution
+// -----------------------------------------------------------------------------
+
+//! @struct distribution
+//! @brief manage distribution type
+struct distribution {
+  enum distribution_enum {
+    //! band of rows
+    c_BAND_ROW = 0,
+    //! band of columns
+    c_BAND_COLUMN = 1,
+    //! checkerboard blocks
+    c_BLOCK = 2,
+    //! 2d block-cyclic
+    c_BLOCK_CYCLIC = 3
+  }  ; // enum distribution_enum {
+
+} ; // struct distribution {
+
+//! @struct Distribution
+//! @brief layout of a distributed matrix (or vector) seen from a processor
+//! @remarks band-row is a numb_procs x 1 grid, band-column a 1 x numb_procs grid
+//! @remarks a dimension with one processor is not distributed (replicated)
+struct Distribution {
+  //! distribution type (distribution::distribution_enum)
+  int type;
+  //! global number of rows
+  int numb_rows;
+  //! global number of columns
+  int numb_columns;
+  //! number of processors (i-)
+  int numb_procs_i;
+  //! number of processors (j-)
+  int numb_procs_j;
+  //! processor number (i-)
+  int proc_numb_i;
+  //! processor number (j-)
+  int proc_numb_j;
+  //! number of rows of a block (block-cyclic)
+  int block_rows;
+  //! number of columns of a block (block-cyclic)
+  int block_columns;
+} ; // struct Distribution {
+
+//! @brief create a distribution from a processor grid
+//! @param [in,out] dist = distribution
+//! @param [in] type = distribution type
+//! @param [in] numb_rows = global number of rows
+//! @param [in] numb_columns = global number of columns
+//! @param [in] numb_procs_i = number of processors (i-)
+//! @param [in] numb_procs_j = number of processors (j-)
+//! @param [in] proc_numb_i = processor number (i-)
+//! @param [in] proc_numb_j = processor number (j-)
+//! @param [in] block_rows = number of rows of a block (block-cyclic)
+//! @param [in] block_columns = number of columns of a block (block-cyclic)
+//! @return error code
+int CreateDistribution (
+        Distribution& dist,
+        int type,
+        int numb_rows,
+        int numb_columns,
+        int numb_procs_i,
+        int numb_procs_j,
+        int proc_numb_i,
+        int proc_numb_j,
+        int block_rows = 1,
+        int block_columns = 1 ) ;
+
+//! @brief create a band distribution (band-row or band-column)
+//! @param [in,out] dist = distribution
+//! @param [in] type = distribution type
+//! @param [in] numb_rows = global number of rows
+//! @param [in] numb_columns = global number of columns
+//! @param [in] mpi_comm = MPI communicator
+//! @return error code
+int CreateDistribution (
+        Distribution& dist,
+        int type,
+        int numb_rows,
+        int numb_columns,
         MPI_Comm& mpi_comm ) ;
 
+//! @brief create a grid distribution (block or block-cyclic)
+//! @param [in,out] dist = distribution
+//! @param [in] type = distribution type
+//! @param [in] numb_rows = global number of rows
+//! @param [in] numb_columns = global number of columns
+//! @param [in] mpi_comm_rows = grid rows communicator
+//! @param [in] mpi_comm_columns = grid columns communicator
+//! @param [in] block_rows = number of rows of a block (block-cyclic)
+//! @param [in] block_columns = number of columns of a block (block-cyclic)
+//! @return error code
+int CreateDistribution (
+        Distribution& dist,
+        int type,
+        int numb_rows,
+        int numb_columns,
+        MPI_Comm& mpi_comm_rows,
+        MPI_Comm& mpi_comm_columns,
+        int block_rows = 1,
+        int block_columns = 1 ) ;
+
+//! @brief local number of rows
+//! @param [in] dist = distribution
+//! @return number of rows owned by the processor
+int LocalNumbRows (
+        const Distribution& dist ) ;
+
+//! @brief local number of columns
+//! @param [in] dist = distribution
+//! @return number of columns owned by the processor
+int LocalNumbColumns (
+        const Distribution& dist ) ;
+
+//! @brief local to global row index
+//! @param [in] dist = distribution
+//! @param [in] idx_local = local row index
+//! @return global row index
+int LocalToGlobalRow (
+        const Distribution& dist,
+        int idx_local ) ;
+
+//! @brief local to global column index
+//! @param [in] dist = distribution
+//! @param [in] idy_local = local column index
+//! @return global column index
+int LocalToGlobalColumn (
+        const Distribution& dist,
+        int idy_local ) ;
+
+//! @brief datatype selecting the local part inside the global row-major matrix
+//! @param [in,out] mpi_type = committed datatype (to be freed by the caller)
+//! @param [in] dist = distribution
+//! @return error code
+int DistributionType (
+        MPI_Datatype& mpi_type,
+        const Distribution& dist ) ;
+
 // -----------------------------------------------------------------------------
 // -- Vector : BAND
 // -----------------------------------------------------------------------------
@@ -89,6 +546,20 @@ int DistributeVectorBand (
         int root,
         MPI_Comm& mpi_comm ) ;
 
+//! @brief distribute vector upon processors (weighted band)
+//! @param [in,out] x_local = local vector
+//! @param [in] x = global vector
+//! @param [in] root = root processor
+//! @param [in] mpi_comm = MPI communicator
+//! @param [in] weights = weight of each processor (see CalibrateBandWeights)
+//! @return error code
+int DistributeVectorBand (
+        Vector<double,int>& x_local,
+        const Vector<double,int>& x,
+        int root,
+        MPI_Comm& mpi_comm,
+        const Vector<double,int>& weights ) ;
+
 //! @brief assemble vector upon processors (band)
 //! @param [in,out] x_global = global vector
 //! @param [in] x = local vector
@@ -129,6 +600,22 @@ int DistributeMatrixBandRow (
         int root,
         MPI_Comm& mpi_comm ) ;
 
+//! @brief distribute matrix upon processors (weighted band row)
+//! @param [in,out] A_local = local matrix
+//! @param [in] A = global matrix
+//! @param [in] root = root processor
+//! @param [in] mpi_comm = MPI communicator
+//! @param [in] weights = weight of each processor (see CalibrateBandWeights)
+//! @remarks MatrixVectorProductBandRow and AssembleMatrixBandRow follow the
+//           local sizes, so they work unchanged on weighted bands
+//! @return error code
+int DistributeMatrixBandRow (
+        MatrixDense<double,int>& A_local,
+        const MatrixDense<double,int>& A,
+        int root,
+        MPI_Comm& mpi_comm,
+        const Vector<double,int>& weights ) ;
+
 //! @brief assemble matrix upon processors (band row)
 //! @param [in,out] A_global = global matrix
 //! @param [in] A = local matrix
@@ -153,6 +640,121 @@ int BuildMatrixBandRow (
         const int numb_procs,
         const int proc_numb ) ;
 
+// -----------------------------------------------------------------------------
+// -- Non-blocking BAND (request handles)
+// -----------------------------------------------------------------------------
+
+//! @struct Request
+//! @brief handle of a non-blocking distribute or assemble
+//! @remarks a band is split in numb_chunks chunks of rows, one MPI request
+//           per chunk, so the first rows can be used while the next arrive
+//! @remarks counts and displacements must live until completion (MPI),
+//           they are released by TestRequest or WaitRequest
+//! @remarks a request is reused once completed; a non-blocking call given
+//           a request still active returns 1
+struct Request {
+  //! number of chunks (MPI requests)
+  int numb_chunks = 0;
+  //! MPI request of each chunk
+  MPI_Request* mpi_requests = NULL;
+  //! counts of each chunk (numb_chunks x numb_procs)
+  int* counts = NULL;
+  //! displacements of each chunk (numb_chunks x numb_procs)
+  int* shifts = NULL;
+  //! first local row of each chunk (numb_chunks + 1)
+  int* chunk_rows = NULL;
+} ; // struct Request {
+
+//! @brief distribute vector upon processors (band, non-blocking)
+//! @param [in,out] x_local = local vector (allocated on return)
+//! @param [in] x = global vector (not modified until completion)
+//! @param [in] root = root processor
+//! @param [in] mpi_comm = MPI communicator
+//! @param [in,out] request = request handle
+//! @param [in] numb_chunks = number of chunks of each band
+//! @remarks the size is broadcast (blocking) to allocate x_local
+//! @return error code
+int IDistributeVectorBand (
+        Vector<double,int>& x_local,
+        const Vector<double,int>& x,
+        int root,
+        MPI_Comm& mpi_comm,
+        Request& request,
+        int numb_chunks = 1 ) ;
+
+//! @brief distribute matrix upon processors (band row, non-blocking)
+//! @param [in,out] A_local = local matrix (allocated on return)
+//! @param [in] A = global matrix (not modified until completion)
+//! @param [in] root = root processor
+//! @param [in] mpi_comm = MPI communicator
+//! @param [in,out] request = request handle
+//! @param [in] numb_chunks = number of chunks (of rows) of each band
+//! @remarks the sizes are broadcast (blocking) to allocate A_local
+//! @return error code
+int IDistributeMatrixBandRow (
+        MatrixDense<double,int>& A_local,
+        const MatrixDense<double,int>& A,
+        int root,
+        MPI_Comm& mpi_comm,
+        Request& request,
+        int numb_chunks = 1 ) ;
+
+//! @brief assemble vector upon processors (band, non-blocking)
+//! @param [in,out] x_global = global vector (allocated on root on return)
+//! @param [in] x = local vector (not modified until completion)
+//! @param [in] root = root processor
+//! @param [in] mpi_comm = MPI communicator
+//! @param [in,out] request = request handle
+//! @remarks the sizes are gathered (blocking) to allocate x_global
+//! @return error code
+int IAssembleVectorBand (
+        Vector<double,int>& x_global,
+        const Vector<double,int>& x,
+        int root,
+        MPI_Comm& mpi_comm,
+        Request& request ) ;
+
+//! @brief test the completion of all chunks of a request
+//! @param [in,out] request = request handle (released when complete)
+//! @param [in,out] flag = true if complete
+//! @return error code
+int TestRequest (
+        Request& request,
+        bool& flag ) ;
+
+//! @brief wait the completion of all chunks of a request
+//! @param [in,out] request = request handle (released)
+//! @return error code
+int WaitRequest (
+        Request& request ) ;
+
+//! @brief test the completion of a chunk of a request
+//! @param [in,out] request = request handle
+//! @param [in] chunk_numb = chunk number
+//! @param [in,out] flag = true if the chunk is complete
+//! @param [in,out] row_begin = first local row of the chunk
+//! @param [in,out] numb_rows = number of local rows of the chunk
+//! @return error code
+int TestRequestChunk (
+        Request& request,
+        int chunk_numb,
+        bool& flag,
+        int& row_begin,
+        int& numb_rows ) ;
+
+//! @brief wait the completion of a chunk of a request
+//! @param [in,out] request = request handle
+//! @param [in] chunk_numb = chunk number
+//! @param [in,out] row_begin = first local row of the chunk
+//! @param [in,out] numb_rows = number of local rows of the chunk
+//! @remarks WaitRequest still releases the request after the last chunk
+//! @return error code
+int WaitRequestChunk (
+        Request& request,
+        int chunk_numb,
+        int& row_begin,
+        int& numb_rows ) ;
+
 // -----------------------------------------------------------------------------
 // -- Matrix: BAND-COLUMN
 // -----------------------------------------------------------------------------
@@ -238,6 +840,7 @@ int BuildVectorBlock (
 //! @param [in] mpi_comm_rows = grid rows communicator
 //! @param [in] mpi_comm_columns = grid columns communicator
 //! @remarks checkerboard matrix decomposition
+//! @remarks root is a rank of the communicator given to GridCartesianComm
 //! @return error code
 int DistributeMatrixBlock (
         MatrixDense<double,int>& A_local,
@@ -253,6 +856,7 @@ int DistributeMatrixBlock (
 //! @param [in] mpi_comm_rows = grid rows communicator
 //! @param [in] mpi_comm_columns = grid columns communicator
 //! @remarks checkerboard matrix decomposition
+//! @remarks root is a rank of the communicator given to GridCartesianComm
 //! @return error code
 int AssembleMatrixBlock (
         MatrixDense<double,int>& A_global,
@@ -280,6 +884,268 @@ int BuildMatrixMatrixBlock (
         const int proc_numb_i,
         const int proc_numb_j ) ;
 
+// -----------------------------------------------------------------------------
+// -- Vector : BLOCK-CYCLIC
+// -----------------------------------------------------------------------------
+
+//! @brief distribute vector upon processors (block-cyclic)
+//! @param [in,out] x_local = local vector
+//! @param [in] x = global vector
+//! @param [in] block_size = size of a block
+//! @param [in] root = root processor (communicator given to GridCartesianComm)
+//! @param [in] mpi_comm_rows = grid rows communicator
+//! @param [in] mpi_comm_columns = grid columns communicator
+//! @remarks x is cyclic over the processor columns (as the columns of A)
+//           and replicated over the processor rows
+//! @return error code
+int DistributeVectorBlockCyclic (
+        Vector<double,int>& x_local,
+        const Vector<double,int>& x,
+        int block_size,
+        int root,
+        MPI_Comm& mpi_comm_rows,
+        MPI_Comm& mpi_comm_columns ) ;
+
+//! @brief assemble vector upon processors (block-cyclic)
+//! @param [in,out] y_global = global vector
+//! @param [in] y = local vector
+//! @param [in] block_size = size of a block
+//! @param [in] root = root processor (communicator given to GridCartesianComm)
+//! @param [in] mpi_comm_rows = grid rows communicator
+//! @param [in] mpi_comm_columns = grid columns communicator
+//! @remarks y is cyclic over the processor rows (as the rows of A)
+//           and replicated over the processor columns
+//! @return error code
+int AssembleVectorBlockCyclic (
+        Vector<double,int>& y_global,
+        const Vector<double,int>& y,
+        int block_size,
+        int root,
+        MPI_Comm& mpi_comm_rows,
+        MPI_Comm& mpi_comm_columns ) ;
+
+// -----------------------------------------------------------------------------
+// -- Matrix: BLOCK-CYCLIC
+// -----------------------------------------------------------------------------
+
+//! @brief distribute matrix upon processors (block-cyclic)
+//! @param [in,out] A_local = local matrix
+//! @param [in] A = global matrix
+//! @param [in] block_rows = number of rows of a block (MB)
+//! @param [in] block_columns = number of columns of a block (NB)
+//! @param [in] root = root processor (communicator given to GridCartesianComm)
+//! @param [in] mpi_comm_rows = grid rows communicator
+//! @param [in] mpi_comm_columns = grid columns communicator
+//! @remarks ScaLAPACK-like 2d block-cyclic matrix decomposition
+//! @return error code
+int DistributeMatrixBlockCyclic (
+        MatrixDense<double,int>& A_local,
+        const MatrixDense<double,int>& A,
+        int block_rows,
+        int block_columns,
+        int root,
+        MPI_Comm& mpi_comm_rows,
+        MPI_Comm& mpi_comm_columns ) ;
+
+//! @brief assemble matrix upon processors (block-cyclic)
+//! @param [in,out] A_global = global matrix
+//! @param [in] A = local matrix
+//! @param [in] block_rows = number of rows of a block (MB)
+//! @param [in] block_columns = number of columns of a block (NB)
+//! @param [in] root = root processor (communicator given to GridCartesianComm)
+//! @param [in] mpi_comm_rows = grid rows communicator
+//! @param [in] mpi_comm_columns = grid columns communicator
+//! @remarks ScaLAPACK-like 2d block-cyclic matrix decomposition
+//! @return error code
+int AssembleMatrixBlockCyclic (
+        MatrixDense<double,int>& A_global,
+        const MatrixDense<double,int>& A,
+        int block_rows,
+        int block_columns,
+        int root,
+        MPI_Comm& mpi_comm_rows,
+        MPI_Comm& mpi_comm_columns ) ;
+
+// -----------------------------------------------------------------------------
+// -- Parallel construction (no root, no scatter)
+// -----------------------------------------------------------------------------
+
+//! @brief element generator: value of the global element (idx, idy)
+//! @remarks data = user context given to CreateMatrix
+typedef double (*ElementGenerator) (
+        int idx,
+        int idy,
+        void* data ) ;
+
+//! @brief row-block generator: fill the global rows [row_begin, row_begin +
+//         numb_rows) restricted to the global columns [column_begin,
+//         column_begin + numb_columns) into coef (row-major, leading dimension ld)
+//! @remarks data = user context given to CreateMatrix
+//! @return error code
+typedef int (*RowBlockGenerator) (
+        double* coef,
+        int ld,
+        int row_begin,
+        int numb_rows,
+        int column_begin,
+        int numb_columns,
+        void* data ) ;
+
+//! @brief vector generator: value of the global element idx
+//! @remarks data = user context given to CreateVector
+typedef double (*VectorGenerator) (
+        int idx,
+        void* data ) ;
+
+//! @brief build the local part of a distributed matrix in place
+//! @param [in,out] A_local = local matrix
+//! @param [in] dist = distribution
+//! @param [in] generator = element generator
+//! @param [in] data = user context of the generator
+//! @return error code
+int CreateMatrix (
+        MatrixDense<double,int>& A_local,
+        const Distribution& dist,
+        ElementGenerator generator,
+        void* data = NULL ) ;
+
+//! @brief build the local part of a distributed matrix in place
+//! @param [in,out] A_local = local matrix
+//! @param [in] dist = distribution
+//! @param [in] generator = row-block generator
+//! @param [in] data = user context of the generator
+//! @remarks one call per contiguous block of global rows and columns
+//! @return error code
+int CreateMatrix (
+        MatrixDense<double,int>& A_local,
+        const Distribution& dist,
+        RowBlockGenerator generator,
+        void* data = NULL ) ;
+
+//! @brief build the local part of a distributed vector in place
+//! @param [in,out] x_local = local vector
+//! @param [in] dist = distribution of a column (n x 1) or row (1 x n) vector
+//! @param [in] generator = vector generator
+//! @param [in] data = user context of the generator
+//! @return error code
+int CreateVector (
+        Vector<double,int>& x_local,
+        const Distribution& dist,
+        VectorGenerator generator,
+        void* data = NULL ) ;
+
+// -----------------------------------------------------------------------------
+// -- Redistribution (all-to-all, no root)
+// -----------------------------------------------------------------------------
+
+//! @brief redistribute a matrix from a distribution to another one
+//! @param [in,out] A_dst = local matrix in the destination distribution
+//! @param [in] dist_dst = destination distribution
+//! @param [in] A_src = local matrix in the source distribution
+//! @param [in] dist_src = source distribution
+//! @param [in] mpi_comm = MPI communicator of all processors of both distributions
+//! @remarks a single MPI_Alltoallw, each pair of processors exchanges the
+//           overlap of their parts (no packing, no root)
+//! @return error code
+int RedistributeMatrix (
+        MatrixDense<double,int>& A_dst,
+        const Distribution& dist_dst,
+        const MatrixDense<double,int>& A_src,
+        const Distribution& dist_src,
+        MPI_Comm& mpi_comm ) ;
+
+//! @brief redistribute a vector from a distribution to another one
+//! @param [in,out] x_dst = local vector in the destination distribution
+//! @param [in] dist_dst = destination distribution (n x 1 or 1 x n)
+//! @param [in] x_src = local vector in the source distribution
+//! @param [in] dist_src = source distribution (n x 1 or 1 x n)
+//! @param [in] mpi_comm = MPI communicator of all processors of both distributions
+//! @remarks column and row vectors may be mixed (e.g. band-row to band-column)
+//! @return error code
+int RedistributeVector (
+        Vector<double,int>& x_dst,
+        const Distribution& dist_dst,
+        const Vector<double,int>& x_src,
+        const Distribution& dist_src,
+        MPI_Comm& mpi_comm ) ;
+
+// -----------------------------------------------------------------------------
+// -- Parallel IO (MPI-IO, binary global files)
+// -----------------------------------------------------------------------------
+
+//! @brief read the local part of a matrix from a binary global file
+//! @param [in,out] A_local = local matrix
+//! @param [in,out] dist = distribution (global sizes are taken from the file)
+//! @param [in] file_name = name of the file
+//! @param [in] mpi_comm = MPI communicator of all processors of the distribution
+//! @remarks collective, each processor reads its own part (iomrg::BinaryHeader)
+//! @return error code
+int ReadMatrixFromFileBinary (
+        MatrixDense<double,int>& A_local,
+        Distribution& dist,
+        const char* file_name,
+        MPI_Comm& mpi_comm ) ;
+
+//! @brief write the local part of a matrix into a binary global file
+//! @param [in] A_local = local matrix
+//! @param [in] dist = distribution
+//! @param [in] file_name = name of the file
+//! @param [in] mpi_comm = MPI communicator of all processors of the distribution
+//! @remarks collective, processors sharing a part write identical data
+//! @return error code
+int WriteMatrixToFileBinary (
+        const MatrixDense<double,int>& A_local,
+        const Distribution& dist,
+        const char* file_name,
+        MPI_Comm& mpi_comm ) ;
+
+//! @brief read the local part of a vector from a binary global file
+//! @param [in,out] x_local = local vector
+//! @param [in,out] dist = distribution (global size is taken from the file)
+//! @param [in] file_name = name of the file
+//! @param [in] mpi_comm = MPI communicator of all processors of the distribution
+//! @remarks dist is a row vector (1 x n) if dist.numb_rows == 1 on input,
+//           otherwise a column vector (n x 1)
+//! @return error code
+int ReadVectorFromFileBinary (
+        Vector<double,int>& x_local,
+        Distribution& dist,
+        const char* file_name,
+        MPI_Comm& mpi_comm ) ;
+
+//! @brief write the local part of a vector into a binary global file
+//! @param [in] x_local = local vector
+//! @param [in] dist = distribution of a column (n x 1) or row (1 x n) vector
+//! @param [in] file_name = name of the file
+//! @param [in] mpi_comm = MPI communicator of all processors of the distribution
+//! @return error code
+int WriteVectorToFileBinary (
+        const Vector<double,int>& x_local,
+        const Distribution& dist,
+        const char* file_name,
+        MPI_Comm& mpi_comm ) ;
+
+// -----------------------------------------------------------------------------
+// -- Out-of-core (root streams a binary global file)
+// -----------------------------------------------------------------------------
+
+//! @brief distribute a matrix (band row) streamed by root from a binary file
+//! @param [in,out] A_local = local matrix
+//! @param [in] file_name = name of the file (iomrg::BinaryHeader)
+//! @param [in] root = root processor
+//! @param [in] mpi_comm = MPI communicator
+//! @param [in] buffer_size = memory of root for the file (bytes), whatever
+//         the size of the matrix (at least two rows)
+//! @remarks root reads chunks of rows into two buffers: the next chunk is read
+//           (MPI_File_iread_at) while the current one is sent to its owners
+//! @return error code
+int StreamMatrixBandRowFromFile (
+        MatrixDense<double,int>& A_local,
+        const char* file_name,
+        int root,
+        MPI_Comm& mpi_comm,
+        size_t buffer_size = 64 << 20 ) ;
+
 // -----------------------------------------------------------------------------
 // -- Read Local
 // -----------------------------------------------------------------------------
@@ -290,8 +1156,8 @@ int BuildMatrixMatrixBlock (
 //! @param [in] proc_numb = processor number
 //! @param [in] numb_procs_i = number of processors (i-)
 //! @param [in] numb_procs_j = number of processors (j-)
-//! @return error code
-const char* GetProcFilename (
+//! @return file name (e.g. A_9_3x3_001.csv)
+std::string GetProcFilename (
         const char* file_group_name,
         const char* file_group_type,
         const int proc_numb,
@@ -328,6 +1194,62 @@ int ReadLocalMatrixFromFile (
         const int proc_numb,
         const bool opt_image_matrix = false ) ;
 
+// -----------------------------------------------------------------------------
+// -- Sharded dataset (one binary shard per processor, manifest)
+// -----------------------------------------------------------------------------
+
+//! @brief write the local part of a matrix as a shard of a sharded dataset
+//! @param [in] A_local = local matrix
+//! @param [in] dist = distribution (numb_procs_i x numb_procs_j processors)
+//! @param [in] file_group_name = file groupname
+//! @param [in] mpi_comm = MPI communicator of all processors of the distribution
+//! @remarks collective, each processor writes its shard (iomrg::BinaryHeader)
+//           file_group_name_P_IxJ_NNN.bin, root writes file_group_name.manifest:
+//           global sizes, distribution, offset and checksum of every shard
+//! @return error code
+int WriteMatrixToShards (
+        const MatrixDense<double,int>& A_local,
+        const Distribution& dist,
+        const char* file_group_name,
+        MPI_Comm& mpi_comm ) ;
+
+//! @brief read the local part of a matrix from a sharded dataset
+//! @param [in,out] A_local = local matrix
+//! @param [in,out] dist = distribution (taken from the manifest), the processor
+//         of rank r in mpi_comm owns the shard r = proc_numb_i * numb_procs_j + proc_numb_j
+//! @param [in] file_group_name = file groupname
+//! @param [in] mpi_comm = MPI communicator of numb_procs_i x numb_procs_j processors
+//! @param [in] opt_check = verify the checksum of the elements
+//! @remarks collective, the manifest is read by root, broadcast and validated;
+//           every processor then reads its own shard with an asynchronous
+//           readahead (posix_fadvise), so that all shards load in parallel
+//! @return error code
+int ReadMatrixFromShards (
+        MatrixDense<double,int>& A_local,
+        Distribution& dist,
+        const char* file_group_name,
+        MPI_Comm& mpi_comm,
+        const bool opt_check = true ) ;
+
+//! @brief convert csv shards (GetProcFilename names) into a sharded dataset
+//! @param [in] file_group_name_csv = file groupname of the csv shards
+//! @param [in] file_group_type_csv = file grouptype of the csv shards
+//! @param [in] file_group_name = file groupname of the sharded dataset
+//! @param [in] numb_procs_i = number of processors (i-)
+//! @param [in] numb_procs_j = number of processors (j-), 0 for band-row names
+//! @param [in] mpi_comm = MPI communicator of all processors of the csv shards
+//! @remarks the distribution is band-row (numb_procs_j = 0) or block (a 1 x P
+//           grid is a band-column); global sizes are the sums of the sizes of
+//           the shards
+//! @return error code
+int ConvertShardsFromFileCsv (
+        const char* file_group_name_csv,
+        const char* file_group_type_csv,
+        const char* file_group_name,
+        const int numb_procs_i,
+        const int numb_procs_j,
+        MPI_Comm& mpi_comm ) ;
+
 } // namespace DataTopology {
 
 
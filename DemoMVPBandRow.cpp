@@ -8,9 +8,38 @@
 #include "MatrixDense.hpp"
 #include "DataTopology.hpp"
 #include "BlasMpi.hpp"
+#include "Trace.hpp"
+#include "PerfCounter.hpp"
+#include "Memory.hpp"
 
 // third-party packages
 
+//! @brief generate the element (idx, idy) of A
+//! @param [in] idx = global row index
+//! @param [in] idy = global column index
+//! @param [in] data = size of problem (int*)
+//! @return A(idx,idy) = idx * size + idy
+double GenerateMatrix (
+        int idx,
+        int idy,
+        void* data ) {
+
+  const int size = *static_cast<const int*>(data);
+
+  return idx * size + idy;
+}
+
+//! @brief generate the element idx of x
+//! @param [in] idx = global index
+//! @param [in] data = unused
+//! @return x(idx) = 1
+double GenerateVector (
+        int idx,
+        void* data ) {
+
+  return 1;
+}
+
 int main (
         int argc,
         char** argv ) {
@@ -36,6 +65,9 @@ int main (
   iomrg::g_log_numb_procs = numb_procs;
   iomrg::g_log_proc_numb = proc_numb;
 
+  // -- origin of the timed regions (compiled with cmake -DTD1_TRACE=ON)
+  Trace::Initialize( mpi_comm );
+
   // ---------------------------------------------------------------------------
   // -- pre-processing
   // ---------------------------------------------------------------------------
@@ -44,15 +76,24 @@ int main (
   const int size = (argv[1]!=NULL) ? atoi(argv[1]) : 5;
   // -- root processor (default: 0)
   const int proc_root = argv[2]!=NULL ? atoi(argv[2]) : 0;
+  // -- build local parts in place, without root nor scatter (default: 0)
+  const bool opt_generate = (argv[2]!=NULL && argv[3]!=NULL) ? atoi(argv[3]) != 0 : false;
+  // -- bands weighted by the speed of the processors (default: 0)
+  const bool opt_weights = (argc > 4) ? atoi(argv[4]) != 0 : false;
+  // -- weights file, loaded if present, written after calibration otherwise
+  const char* weights_file_name = (argc > 5) ? argv[5] : NULL;
   if( proc_numb == proc_root ) {
-    iomrg::printf("-- problem size: %d [proc_root: %d] \n\n", size, proc_root);
+    iomrg::printf("-- problem size: %d [proc_root: %d] [generate: %d] [weights: %d] \n\n",
+                  size, proc_root, opt_generate, opt_weights);
   }
 
   // -- allocate and initialize Matrix and Vector
   MatrixDense<double,int> A_global;
   Vector<double,int> x_global;
 
-  if ( proc_numb == proc_root ) {
+  if ( proc_numb == proc_root && !opt_generate ) {
+    // -- global data: root only, counted apart from the local parts
+    MEMORY_TAG( "global (root)" );
     // -- allocate and fill A
     A_global.Allocate( size, size );
     for( int i = 0; i < size; i++ ) {
@@ -70,13 +111,36 @@ int main (
   // -- try to wait all processors
   MPI_Barrier( mpi_comm );
 
-  // -- distribute matrix band-row
   MatrixDense<double,int> A_local;
-  DataTopology::DistributeMatrixBandRow( A_local, A_global, proc_root, mpi_comm );
-
-  // -- distribute vector
   Vector<double,int> x_local;
-  DataTopology::DistributeVectorBand( x_local, x_global, proc_root, mpi_comm );
+  if ( opt_generate ) {
+    // -- each processor builds its own band
+    DataTopology::Distribution dist_A;
+    DataTopology::CreateDistribution( dist_A, DataTopology::distribution::c_BAND_ROW,
+                                      size, size, mpi_comm );
+    DataTopology::Distribution dist_x;
+    DataTopology::CreateDistribution( dist_x, DataTopology::distribution::c_BAND_ROW,
+                                      size, 1, mpi_comm );
+    int size_data = size;
+    DataTopology::CreateMatrix( A_local, dist_A, GenerateMatrix, &size_data );
+    DataTopology::CreateVector( x_local, dist_x, GenerateVector );
+  } else if ( opt_weights ) {
+    // -- calibrate (or load) the weights, then distribute weighted bands
+    Vector<double,int> weights;
+    DataTopology::CalibrateBandWeights( weights, mpi_comm, weights_file_name );
+    if ( proc_numb == proc_root ) {
+      iomrg::printf( ">>> band weights \n" );
+      weights.WriteToStdout( );
+    }
+    DataTopology::DistributeMatrixBandRow( A_local, A_global, proc_root, mpi_comm, weights );
+    DataTopology::DistributeVectorBand( x_local, x_global, proc_root, mpi_comm, weights );
+  } else {
+    // -- distribute matrix band-row
+    DataTopology::DistributeMatrixBandRow( A_local, A_global, proc_root, mpi_comm );
+
+    // -- distribute vector
+    DataTopology::DistributeVectorBand( x_local, x_global, proc_root, mpi_comm );
+  }
 
 
   // ---------------------------------------------------------------------------
@@ -97,10 +161,12 @@ int main (
 
   // -- print
   if ( proc_numb == proc_root && size < 20 ) {
-    iomrg::printf( ">>> print A \n" );
-    A_global.WriteToStdout( );
-    iomrg::printf( ">>> print x \n" );
-    x_global.WriteToStdout( );
+    if ( !opt_generate ) {
+      iomrg::printf( ">>> print A \n" );
+      A_global.WriteToStdout( );
+      iomrg::printf( ">>> print x \n" );
+      x_global.WriteToStdout( );
+    }
     iomrg::printf( ">>> print y \n" );
     y_global.WriteToStdout( );
   }
@@ -114,6 +180,18 @@ int main (
   // -- finalize MPI
   // ---------------------------------------------------------------------------
 
+  // -- timed regions over the processors, Chrome trace into $TD1_TRACE_FILE
+  Trace::Finalize( mpi_comm, getenv( "TD1_TRACE_FILE" ) );
+
+  // -- hardware counters of the kernels per processor (cmake -DTD1_PERF=ON)
+  PerfCounter::Report( mpi_comm );
+
+  // -- current and peak bytes per processor, by allocation site, if
+  //    $TD1_MEMORY_REPORT is set
+  if ( getenv( "TD1_MEMORY_REPORT" ) != NULL ) {
+    Memory::Report( mpi_comm );
+  }
+
   // -- finalizes MPI
   MPI_Finalize( );
 
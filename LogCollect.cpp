@@ -0,0 +1,245 @@
+/*!
+*  @file LogCollect.cpp
+*  @internal source of LogCollect (log lines of all processors merged on one)
+*  @author Abal-Kassim Cheik Ahamed, Frédéric Magoulès, Sonia Toubaline
+*  @date Tue Nov 24 16:16:48 CET 2015
+*  @version 1.0
+*  @remarks
+*/
+
+// basic packages
+#include <string.h>
+#include <algorithm>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+// project packages
+#include "LogCollect.hpp"
+
+// third-party packages
+
+
+//! @namespace LogCollect
+namespace LogCollect {
+
+    ________________________________________________________________________________
+
+//! @internal line printed by a set of processors
+    struct Entry {
+        //! position of the line on the lowest processor
+        int position;
+        //! lowest processor
+        int rank_min;
+        //! ranges [first, last] of processors, sorted and disjoint
+        std::vector<std::pair<int, int> > ranges;
+    };
+
+//! @internal entries by (text, occurrence of the text on a processor)
+    typedef std::map<std::pair<std::string, int>, Entry> Entries;
+
+    ________________________________________________________________________________
+
+//! @internal union of two sorted lists of ranges (adjacent ranges joined)
+    int MergeRanges(
+            std::vector<std::pair<int, int> > &ranges,
+            const std::vector<std::pair<int, int> > &others) {
+
+        std::vector<std::pair<int, int> > all(ranges);
+        all.insert(all.end(), others.begin(), others.end());
+        std::sort(all.begin(), all.end());
+
+        ranges.clear();
+        for (size_t k = 0; k < all.size(); k++) {
+            if (!ranges.empty() && all[k].first <= ranges.back().second + 1) {
+                ranges.back().second = std::max(ranges.back().second, all[k].second);
+            } else {
+                ranges.push_back(all[k]);
+            }
+        }
+
+        return 0;
+    }
+
+    ________________________________________________________________________________
+
+//! @internal merge an entry into the entries
+    int MergeEntry(
+            Entries &entries,
+            const std::pair<std::string, int> &key,
+            const Entry &entry) {
+
+        Entries::iterator it = entries.find(key);
+        if (it == entries.end()) {
+            entries[key] = entry;
+            return 0;
+        }
+
+        Entry &merged = it->second;
+        if (entry.rank_min < merged.rank_min) {
+            merged.rank_min = entry.rank_min;
+            merged.position = entry.position;
+        }
+        MergeRanges(merged.ranges, entry.ranges);
+
+        return 0;
+    }
+
+    ________________________________________________________________________________
+
+//! @internal serialize entries: counts as int, texts with their size, ranges as
+//            pairs of int (first, second)
+    int Pack(
+            std::string &buffer,
+            const Entries &entries) {
+
+        buffer.clear();
+        Entries::const_iterator it;
+        for (it = entries.begin(); it != entries.end(); ++it) {
+            const std::string &text = it->first.first;
+            const Entry &entry = it->second;
+            int header[5] = {(int) text.size(), it->first.second, entry.position,
+                             entry.rank_min, (int) entry.ranges.size()};
+            buffer.append((const char *) header, sizeof(header));
+            buffer.append(text);
+            std::vector<int> ranges(2 * entry.ranges.size());
+            for (size_t k = 0; k < entry.ranges.size(); k++) {
+                ranges[2 * k] = entry.ranges[k].first;
+                ranges[2 * k + 1] = entry.ranges[k].second;
+            }
+            buffer.append((const char *) ranges.data(), ranges.size() * sizeof(int));
+        }
+
+        return 0;
+    }
+
+    ________________________________________________________________________________
+
+//! @internal deserialize entries and merge them
+    int UnpackMerge(
+            Entries &entries,
+            const std::string &buffer) {
+
+        size_t pos = 0;
+        while (pos < buffer.size()) {
+            int header[5];
+            memcpy(header, buffer.data() + pos, sizeof(header));
+            pos += sizeof(header);
+            std::pair<std::string, int> key(buffer.substr(pos, header[0]), header[1]);
+            pos += header[0];
+
+            Entry entry;
+            entry.position = header[2];
+            entry.rank_min = header[3];
+            std::vector<int> ranges(2 * header[4]);
+            memcpy(ranges.data(), buffer.data() + pos, ranges.size() * sizeof(int));
+            pos += ranges.size() * sizeof(int);
+            entry.ranges.resize(header[4]);
+            for (int k = 0; k < header[4]; k++) {
+                entry.ranges[k].first = ranges[2 * k];
+                entry.ranges[k].second = ranges[2 * k + 1];
+            }
+
+            MergeEntry(entries, key, entry);
+        }
+
+        return 0;
+    }
+
+    ________________________________________________________________________________
+
+//! @internal order of the lines: position on the lowest processor
+    bool CompareEntries(
+            const std::pair<const std::pair<std::string, int>, Entry> *a,
+            const std::pair<const std::pair<std::string, int>, Entry> *b) {
+
+        if (a->second.position != b->second.position) {
+            return a->second.position < b->second.position;
+        }
+        return a->second.rank_min < b->second.rank_min;
+    }
+
+    ________________________________________________________________________________
+
+//! @internal merge the lines kept by all processors and write them on root
+    int Sync(
+            MPI_Comm &mpi_comm,
+            int root,
+            FILE *stream) {
+
+        int rank, nproc;
+        MPI_Comm_rank(mpi_comm, &rank);
+        MPI_Comm_size(mpi_comm, &nproc);
+        const int tag = 0;
+
+        // -- local lines, the k-th occurrence of a text is a distinct entry
+        std::vector<std::string> lines;
+        iomrg::TakeLogCollected(lines);
+        Entries entries;
+        std::map<std::string, int> numb_occurrences;
+        for (int l = 0; l < (int) lines.size(); l++) {
+            Entry entry;
+            entry.position = l;
+            entry.rank_min = rank;
+            entry.ranges.push_back(std::make_pair(rank, rank));
+            MergeEntry(entries, std::make_pair(lines[l], numb_occurrences[lines[l]]++), entry);
+        }
+
+        // -- binomial tree rooted at root: receive from the children, send to the parent
+        int rank_rel = (rank - root + nproc) % nproc;
+        std::string buffer;
+        for (int step = 1; step < nproc; step *= 2) {
+            if (rank_rel & step) {
+                Pack(buffer, entries);
+                MPI_Send(buffer.data(), (int) buffer.size(), MPI_CHAR,
+                         (rank_rel - step + root) % nproc, tag, mpi_comm);
+                return 0;
+            }
+            if (rank_rel + step < nproc) {
+                int source = (rank_rel + step + root) % nproc;
+                MPI_Status status;
+                int size;
+                MPI_Probe(source, tag, mpi_comm, &status);
+                MPI_Get_count(&status, MPI_CHAR, &size);
+                buffer.resize(size);
+                MPI_Recv(&buffer[0], size, MPI_CHAR, source, tag, mpi_comm, MPI_STATUS_IGNORE);
+                UnpackMerge(entries, buffer);
+            }
+        }
+
+        // -- root writes the lines, prefixed by the ranges of processors
+        std::vector<const std::pair<const std::pair<std::string, int>, Entry> *> sorted;
+        Entries::const_iterator it;
+        for (it = entries.begin(); it != entries.end(); ++it) {
+            sorted.push_back(&*it);
+        }
+        std::stable_sort(sorted.begin(), sorted.end(), CompareEntries);
+
+        std::string text;
+        char range[32];
+        for (size_t k = 0; k < sorted.size(); k++) {
+            const std::vector<std::pair<int, int> > &ranges = sorted[k]->second.ranges;
+            text += "[";
+            for (size_t r = 0; r < ranges.size(); r++) {
+                if (ranges[r].first == ranges[r].second) {
+                    snprintf(range, sizeof(range), "%s%d", (r > 0) ? "," : "", ranges[r].first);
+                } else {
+                    snprintf(range, sizeof(range), "%s%d-%d", (r > 0) ? "," : "",
+                             ranges[r].first, ranges[r].second);
+                }
+                text += range;
+            }
+            text += "] ";
+            text += sorted[k]->first.first;
+            text += "\n";
+        }
+        fwrite(text.data(), 1, text.size(), stream);
+        fflush(stream);
+
+        return 0;
+    }
+
+    ________________________________________________________________________________
+
+} // namespace LogCollect {
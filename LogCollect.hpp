@@ -0,0 +1,46 @@
+/*!
+*  @file LogCollect.hpp
+*  @brief header of LogCollect (log lines of all processors merged on one)
+*  @author Abal-Kassim Cheik Ahamed, Frédéric Magoulès, Sonia Toubaline
+*  @date Tue Nov 24 16:16:48 CET 2015
+*  @version 1.0
+*  @remarks with iomrg::g_log_collect, iomrg::printf keeps the lines on each
+*           processor; Sync merges them at the sync points chosen by the code
+*/
+
+#ifndef GUARD_LOGCOLLECT_HPP_
+#define GUARD_LOGCOLLECT_HPP_
+
+// basic packages
+#include <stdio.h>
+#include <mpi.h>
+
+// project packages
+#include "dllmrg.hpp"
+
+// third-party packages
+
+
+//! @namespace LogCollect
+namespace LogCollect {
+
+//! @brief merge the lines kept by all processors and write them on root
+//! @param [in] mpi_comm = MPI communicator
+//! @param [in] root = processor writing the lines
+//! @param [in] stream = stream of root (default: stdout)
+//! @remarks collective; the lines go up a binomial tree, identical lines of
+//           several processors are written once, prefixed by the ranges of
+//           their processors: "[0-511,768] .r. Reading csv file ..."
+//! @remarks the k-th occurrence of a line on a processor is merged with the
+//           k-th occurrence on the others; lines are ordered by their
+//           position on the lowest processor printing them
+//! @return error code
+int Sync (
+        MPI_Comm& mpi_comm,
+        int root = 0,
+        FILE* stream = stdout ) ;
+
+} // namespace LogCollect {
+
+
+#endif // GUARD_LOGCOLLECT_HPP_
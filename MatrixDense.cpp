@@ -10,11 +10,14 @@
 // C++ packages
 #include <stdio.h>
 #include <string.h>
+#include <algorithm>
 #include <iostream>
 #include <fstream>
 
 // MRG packages
 #include "MatrixDense.hpp"
+#include "PerfCounter.hpp"
+#include "Memory.hpp"
 
 // MRG third-party packages
 
@@ -30,6 +33,11 @@ MatrixDense<T, U>::MatrixDense ( void ) {
   m_numb_columns = 0;
   // set pointer to NULL
   m_coef = NULL;
+  // not mapped
+  m_map_base = NULL;
+  m_map_size = 0;
+  // nothing allocated
+  m_tag = NULL;
 
 }
 
@@ -47,6 +55,10 @@ MatrixDense<T, U>::MatrixDense (
   m_numb_columns = numb_columns;
   // allocate elements array
   m_coef = new T[m_numb_rows * m_numb_columns];
+  m_tag = Memory::Allocated( sizeof( T ) * m_numb_rows * m_numb_columns, "MatrixDense" );
+  // not mapped
+  m_map_base = NULL;
+  m_map_size = 0;
 
 }
 
@@ -56,12 +68,7 @@ ________________________________________________________________________________
 template <class T, class U>
 MatrixDense<T, U>::~MatrixDense ( void ) {
 
-  if ( m_coef != NULL ) {
-    m_numb_rows = 0;
-    m_numb_columns = 0;
-    delete [] m_coef;
-    m_coef = NULL;
-  }
+  this->Deallocate( );
 
 }
 
@@ -139,6 +146,7 @@ int MatrixDense<T, U>::Allocate (
   m_numb_columns = numb_columns;
   // allocate elements array
   m_coef = new T[m_numb_rows * m_numb_columns];
+  m_tag = Memory::Allocated( sizeof( T ) * m_numb_rows * m_numb_columns, "MatrixDense" );
 
   return 0;
 }
@@ -149,7 +157,16 @@ ________________________________________________________________________________
 template <class T, class U>
 int MatrixDense<T, U>::Deallocate ( void ) {
 
-  if ( m_coef != NULL ) {
+  if ( m_map_base != NULL ) {
+    // -- elements belong to the mapped file
+    m_numb_rows = 0;
+    m_numb_columns = 0;
+    iomrg::UnmapFileBinary( m_map_base, m_map_size );
+    m_map_base = NULL;
+    m_map_size = 0;
+    m_coef = NULL;
+  } else if ( m_coef != NULL ) {
+    Memory::Freed( sizeof( T ) * m_numb_rows * m_numb_columns, m_tag );
     m_numb_rows = 0;
     m_numb_columns = 0;
     delete [] m_coef;
@@ -161,11 +178,58 @@ int MatrixDense<T, U>::Deallocate ( void ) {
 
 ________________________________________________________________________________
 
+//! @internal dot product of a row with UNROLL independent accumulators
+template <int UNROLL, class T, class U>
+T DotUnrolled (
+        const T* a,
+        const T* b,
+        U size ) {
+
+  T res[UNROLL];
+  for ( int u = 0; u < UNROLL; u++ ) {
+    res[u] = T(0);
+  }
+  U j = 0;
+  for ( ; j + UNROLL <= size; j += UNROLL ) {
+    for ( int u = 0; u < UNROLL; u++ ) {
+      res[u] += a[j+u] * b[j+u];
+    }
+  }
+  for ( ; j < size; j++ ) {
+    res[0] += a[j] * b[j];
+  }
+  for ( int u = 1; u < UNROLL; u++ ) {
+    res[0] += res[u];
+  }
+
+  return res[0];
+}
+
+________________________________________________________________________________
+
 //! @internal performs the MatrixDense-vector product y := A * x
+//! @remarks unroll accumulators per row
 template <class T, class U>
 int MatrixDense<T, U>::MatrixVectorProduct (
         Vector<T,U>& y,
-        const Vector<T,U>& x ) const {
+        const Vector<T,U>& x,
+        int unroll ) const {
+
+  PERF_SCOPE( "MatrixDense::MatrixVectorProduct",
+              2. * m_numb_rows * m_numb_columns,
+              sizeof( T ) * ( (double) m_numb_rows * m_numb_columns + m_numb_rows + m_numb_columns ) );
+  if ( unroll > 1 ) {
+    const T* x_coef = x.GetCoef( );
+    for ( U i = 0; i < m_numb_rows; i++ ) {
+      const T* A_i = this->GetCoef( i );
+      switch ( unroll ) {
+        case 2: y(i) = DotUnrolled<2>( A_i, x_coef, m_numb_columns ); break;
+        case 4: y(i) = DotUnrolled<4>( A_i, x_coef, m_numb_columns ); break;
+        default: y(i) = DotUnrolled<8>( A_i, x_coef, m_numb_columns ); break;
+      }
+    }
+    return 0;
+  }
 
   for ( U i = 0; i < m_numb_rows; i++ ) {
     T res = T(0);
@@ -184,9 +248,49 @@ ________________________________________________________________________________
 template <class T, class U>
 int MatrixDense<T, U>::MatrixMatrixProduct (
         MatrixDense<T,U>& A,
-        const MatrixDense<T,U>& B ) const {
+        const MatrixDense<T,U>& B,
+        U tile ) const {
 
   // this: m x p, B: p x n  => A: m x n
+  PERF_SCOPE( "MatrixDense::MatrixMatrixProduct",
+              2. * this->GetNumbRows( ) * this->GetNumbColumns( ) * B.GetNumbColumns( ),
+              sizeof( T ) * ( (double) this->GetNumbRows( ) * this->GetNumbColumns( ) +
+                              (double) B.GetNumbRows( ) * B.GetNumbColumns( ) +
+                              (double) this->GetNumbRows( ) * B.GetNumbColumns( ) ) );
+  if ( tile > 0 ) {
+    const U numb_rows = this->GetNumbRows( );
+    const U numb_columns = B.GetNumbColumns( );
+    const U numb_inner = this->GetNumbColumns( );
+    for ( U i = 0; i < numb_rows; i++ ) {
+      T* A_i = A.GetCoef( i );
+      for ( U j = 0; j < numb_columns; j++ ) {
+        A_i[j] = T(0);
+      }
+    }
+    // -- tiles of i, k and j; for each element the k order is unchanged
+    for ( U ii = 0; ii < numb_rows; ii += tile ) {
+      U i_end = std::min( ii + tile, numb_rows );
+      for ( U kk = 0; kk < numb_inner; kk += tile ) {
+        U k_end = std::min( kk + tile, numb_inner );
+        for ( U jj = 0; jj < numb_columns; jj += tile ) {
+          U j_end = std::min( jj + tile, numb_columns );
+          for ( U i = ii; i < i_end; i++ ) {
+            T* A_i = A.GetCoef( i );
+            const T* this_i = this->GetCoef( i );
+            for ( U k = kk; k < k_end; k++ ) {
+              const T a_ik = this_i[k];
+              const T* B_k = B.GetCoef( k );
+              for ( U j = jj; j < j_end; j++ ) {
+                A_i[j] += a_ik * B_k[j];
+              }
+            }
+          }
+        }
+      }
+    }
+    return 0;
+  }
+
   for ( U i = 0; i < this->GetNumbRows( ); i++ ) {
     for ( U j = 0; j < B.GetNumbColumns( ); j++ ) {
       A(i,j) = T(0);
@@ -209,6 +313,8 @@ MatrixDense<T,U>& MatrixDense<T,U>::operator= (
 
   // if current object is different with the copy object
   if( this != &copy_m ) {
+    PERF_SCOPE( "MatrixDense::operator=", 0.,
+                2. * sizeof( T ) * m_numb_rows * m_numb_columns );
     // copy elements;
     for ( U i = 0; i < m_numb_rows; i++ ) {
       for ( U j = 0; j < m_numb_columns; j++ ) {
@@ -273,37 +379,43 @@ int MatrixDense<T, U>::ReadFromFileCsv (
 
   iomrg::printf( ".r. Reading csv file (dense): %s \n", file_name );
 
-  // -- open file
-  std::ifstream file(file_name, std::ios::in);
-
-  // read mrg information
-  std::string current_line;
+  // -- map file
+  const char* text = NULL;
+  size_t text_size = 0;
+  if ( iomrg::MapFileText( text, text_size, file_name ) != 0 ) {
+    return 1;
+  }
+  const char* text_end = text + text_size;
 
-  // -- read new line
-  std::getline( file, current_line );
-  std::stringstream ss_current_line(current_line);
-  // first line
-  U numb_rows;
-  U numb_columns;
-  ss_current_line >> numb_rows >> numb_columns;
+  // -- read first line
+  const char* line_end = static_cast<const char*>( memchr( text, '\n', text_size ) );
+  if ( line_end == NULL ) {
+    line_end = text_end;
+  }
+  U dims[2];
+  if ( iomrg::ParseCsv( dims, 2, text, line_end, 1 ) != 0 ) {
+    iomrg::UnmapFileText( text, text_size );
+    return 1;
+  }
+  // if already allocated, deallocate first
+  this->Deallocate( );
   // update number of rows
-  m_numb_rows = numb_rows;
+  m_numb_rows = dims[0];
   // update number of columns
-  m_numb_columns = numb_columns;
+  m_numb_columns = dims[1];
 
   // -- read elements
   // allocate elements array
   m_coef = new T[m_numb_rows * m_numb_columns];
+  m_tag = Memory::Allocated( sizeof( T ) * m_numb_rows * m_numb_columns, "MatrixDense" );
+  // read elements (chunks of lines parsed by threads)
+  int error = iomrg::ParseCsv( m_coef, (size_t) m_numb_rows * m_numb_columns,
+                               line_end, text_end );
 
-  // read elements
-  for (U i = 0; i < m_numb_rows * m_numb_columns; i++) {
-    file >> m_coef[i];
-  }
-
-  // -- close file
-  file.close();
+  // -- unmap file
+  iomrg::UnmapFileText( text, text_size );
 
-  return 0;
+  return error;
 }
 
 ________________________________________________________________________________
@@ -313,34 +425,18 @@ template <class T, class U>
 int MatrixDense<T, U>::WriteToFileCsv (
         const char* file_name,
         const char separator_column,
-        const char separator_row ) const {
+        const char separator_row,
+        const int precision ) const {
 
   iomrg::printf( ".w. Writing csv file (dense): %s \n", file_name );
 
-  // -- open file
-  std::ofstream file(file_name, std::ios::out | std::ios::trunc);
-
-  // -- write dimensions
-  file << m_numb_rows << " " << m_numb_columns << std::endl;
-  // -- write elements
-  for ( U i = 0; i < m_numb_rows; i++ ) {
-    if ( separator_column != '\0' ) {
-      for ( U j = 0; j < m_numb_columns - 1; j++ ) {
-        file << m_coef[this->GetOffset(i, j)] << separator_column;
-      }
-    } else {
-      for ( U j = 0; j < m_numb_columns - 1; j++ ) {
-        file << m_coef[this->GetOffset(i, j)];
-      }
-    }
-    T last_coef = m_coef[this->GetOffset(i, m_numb_columns-1)];
-    file << last_coef << separator_row;
-  }
-
-  // -- close file
-  file.close();
-
-  return 0;
+  // -- dimensions
+  std::string header = std::to_string( m_numb_rows ) + " " +
+                       std::to_string( m_numb_columns );
+  // -- write elements (blocks formatted by threads)
+  return iomrg::WriteFileCsv( file_name, header.c_str( ), m_coef,
+                              m_numb_rows, m_numb_columns,
+                              separator_column, separator_row, precision );
 }
 
 ________________________________________________________________________________
@@ -365,6 +461,8 @@ int MatrixDense<T, U>::ReadImageMatrixFromFileCsv (
   U numb_rows;
   U numb_columns;
   ss_current_line >> numb_rows >> numb_columns;
+  // if already allocated, deallocate first
+  this->Deallocate( );
   // update number of rows
   m_numb_rows = numb_rows;
   // update number of columns
@@ -373,6 +471,7 @@ int MatrixDense<T, U>::ReadImageMatrixFromFileCsv (
   // -- read elements
   // allocate elements array
   m_coef = new T[m_numb_rows * m_numb_columns];
+  m_tag = Memory::Allocated( sizeof( T ) * m_numb_rows * m_numb_columns, "MatrixDense" );
 
   // read elements
   for (U i = 0; i < m_numb_rows; i++) {
@@ -394,6 +493,52 @@ int MatrixDense<T, U>::ReadImageMatrixFromFileCsv (
 
 ________________________________________________________________________________
 
+//! @internal write matrix into a binary file
+template <class T, class U>
+int MatrixDense<T, U>::WriteToFileBinary (
+        const char* file_name ) const {
+
+  iomrg::printf( ".w. Writing binary file (dense): %s \n", file_name );
+
+  return iomrg::WriteFileBinary( file_name, m_coef, m_numb_rows, m_numb_columns );
+}
+
+________________________________________________________________________________
+
+//! @internal map matrix from a binary file, without copy nor parsing
+template <class T, class U>
+int MatrixDense<T, U>::MapFromFileBinary (
+        const char* file_name,
+        const int opt_map,
+        const bool opt_check ) {
+
+  iomrg::printf( ".r. Mapping binary file (dense): %s \n", file_name );
+
+  // if already allocated, deallocate first
+  this->Deallocate( );
+
+  void* map_base = NULL;
+  size_t map_size = 0;
+  iomrg::BinaryHeader header;
+  if ( iomrg::MapFileBinary( map_base, map_size, header, file_name,
+                             opt_map, opt_check ) != 0 ) {
+    return 1;
+  }
+
+  m_map_base = map_base;
+  m_map_size = map_size;
+  // set number of rows
+  m_numb_rows = header.numb_rows;
+  // set number of columns
+  m_numb_columns = header.numb_columns;
+  // elements are read in place
+  m_coef = reinterpret_cast<T*>( static_cast<char*>(map_base) + header.data_offset );
+
+  return 0;
+}
+
+________________________________________________________________________________
+
 //! instantiate the class
 INSTANTIATE_CLASS(MatrixDense)
 
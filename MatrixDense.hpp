@@ -36,6 +36,12 @@ class MatrixDense {
     U m_numb_columns;
     //! elements of the matrix
     T* m_coef;
+    //! address of the mapped file (NULL if elements are allocated)
+    void* m_map_base;
+    //! size of the mapped file
+    size_t m_map_size;
+    //! allocation-site tag of the elements (see Memory)
+    const char* m_tag;
 
   public:
 
@@ -119,18 +125,24 @@ class MatrixDense {
     //! @brief perform the matrix-vector product y := A * x
     //! @param [in,out] y = output vector
     //! @param [in] x = input vector
+    //! @param [in] unroll = accumulators per row (1, 2, 4 or 8), e.g.
+    //           Tune::Parameters::mvp_unroll
     //! @return error code
     int MatrixVectorProduct (
         Vector<T,U>& y,
-        const Vector<T,U>& x ) const ;
+        const Vector<T,U>& x,
+        int unroll = 1 ) const ;
 
     //! @brief perform the matrix-matrix product A := A * B
     //! @param [in,out] A = output matrix
     //! @param [in] B = input matrix
+    //! @param [in] tile = tile size (0: no tiling), e.g.
+    //           Tune::Parameters::mmp_tile
     //! @return error code
     int MatrixMatrixProduct (
         MatrixDense<T,U>& A,
-        const MatrixDense<T,U>& B ) const ;
+        const MatrixDense<T,U>& B,
+        U tile = 0 ) const ;
 
   public:
 
@@ -188,12 +200,15 @@ class MatrixDense {
 
     //! @brief write matrix into a csv file
     //! @param [in] file_name = name of the file
-    //! @param [in] separator = format separator
+    //! @param [in] separator_column = format separator between columns
+    //! @param [in] separator_row = format separator between rows
+    //! @param [in] precision = significant digits (0 = shortest round-trip)
     //! @return error code
     int WriteToFileCsv (
         const char* file_name,
         const char separator_column = ' ',
-        const char separator_row = '\n' ) const ;
+        const char separator_row = '\n',
+        const int precision = 0 ) const ;
 
     //! @brief read an image matrix from a csv file
     //! @param [in] file_name = name of the file
@@ -205,6 +220,24 @@ class MatrixDense {
     int ReadImageMatrixFromFileCsv (
         const char* file_name ) ;
 
+    //! @brief write matrix into a binary file (iomrg::BinaryHeader)
+    //! @param [in] file_name = name of the file
+    //! @return error code
+    int WriteToFileBinary (
+        const char* file_name ) const ;
+
+    //! @brief map matrix from a binary file, without copy nor parsing
+    //! @param [in] file_name = name of the file
+    //! @param [in] opt_map = paging policy (iomrg::binary::map_enum)
+    //! @param [in] opt_check = verify the checksum (touches every page)
+    //! @remarks elements point into a private mapping (copy on write),
+    //           released by Deallocate
+    //! @return error code
+    int MapFromFileBinary (
+        const char* file_name,
+        const int opt_map = iomrg::binary::c_MAP_LAZY,
+        const bool opt_check = false ) ;
+
 
 } ; // class MatrixDense {
 
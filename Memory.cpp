@@ -0,0 +1,285 @@
+/*!
+*  @file Memory.cpp
+*  @internal source of Memory (bytes allocated per processor, by allocation site)
+*  @author Abal-Kassim Cheik Ahamed, Frédéric Magoulès, Sonia Toubaline
+*  @date Tue Nov 24 16:16:48 CET 2015
+*  @version 1.0
+*  @remarks
+*/
+
+// basic packages
+#include <stdio.h>
+#include <string.h>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+// project packages
+#include "Memory.hpp"
+
+// third-party packages
+
+
+//! @namespace Memory
+namespace Memory {
+
+    ________________________________________________________________________________
+
+//! @internal usage of the processor and of each tag
+    struct State {
+        std::mutex mutex;
+        Usage all;
+        std::map<std::string, Usage> tags;
+
+        State() {
+            memset(&all, 0, sizeof(all));
+        }
+    };
+
+//! @internal state of the processor, never destroyed: objects with static
+//            storage may be released after the other statics
+    State &GetState() {
+
+        static State *state = new State();
+
+        return *state;
+    }
+
+//! @internal innermost tag of the thread
+    thread_local const char *t_tag = NULL;
+
+    ________________________________________________________________________________
+
+//! @internal add bytes to a usage, update its high-water mark
+    void Add(
+            Usage &usage,
+            long long bytes) {
+
+        usage.current += bytes;
+        if (usage.current > usage.peak) {
+            usage.peak = usage.current;
+        }
+    }
+
+    ________________________________________________________________________________
+
+//! @internal count an allocation
+    const char *Allocated(
+            size_t bytes,
+            const char *default_tag) {
+
+        const char *tag = (t_tag != NULL) ? t_tag : default_tag;
+        if (bytes == 0) {
+            return tag;
+        }
+
+        State &state = GetState();
+        std::lock_guard<std::mutex> lock(state.mutex);
+        std::map<std::string, Usage>::iterator it = state.tags.find(tag);
+        if (it == state.tags.end()) {
+            Usage usage;
+            memset(&usage, 0, sizeof(usage));
+            it = state.tags.insert(std::make_pair(std::string(tag), usage)).first;
+        }
+        Add(it->second, (long long) bytes);
+        it->second.numb_allocations++;
+        it->second.total += (long long) bytes;
+        Add(state.all, (long long) bytes);
+        state.all.numb_allocations++;
+        state.all.total += (long long) bytes;
+
+        return tag;
+    }
+
+    ________________________________________________________________________________
+
+//! @internal count a deallocation
+    int Freed(
+            size_t bytes,
+            const char *tag) {
+
+        if (bytes == 0 || tag == NULL) {
+            return 0;
+        }
+
+        State &state = GetState();
+        std::lock_guard<std::mutex> lock(state.mutex);
+        std::map<std::string, Usage>::iterator it = state.tags.find(tag);
+        if (it == state.tags.end()) {
+            return 1;
+        }
+        it->second.current -= (long long) bytes;
+        state.all.current -= (long long) bytes;
+
+        return 0;
+    }
+
+    ________________________________________________________________________________
+
+//! @internal usage of the calling processor
+    int GetUsage(
+            Usage &usage,
+            const char *tag) {
+
+        State &state = GetState();
+        std::lock_guard<std::mutex> lock(state.mutex);
+        if (tag == NULL) {
+            usage = state.all;
+            return 0;
+        }
+        std::map<std::string, Usage>::const_iterator it = state.tags.find(tag);
+        if (it == state.tags.end()) {
+            memset(&usage, 0, sizeof(usage));
+            return 1;
+        }
+        usage = it->second;
+
+        return 0;
+    }
+
+    ________________________________________________________________________________
+
+//! @internal tags of the calling processor
+    int GetTags(
+            std::vector<std::string> &tags) {
+
+        State &state = GetState();
+        std::lock_guard<std::mutex> lock(state.mutex);
+        tags.clear();
+        std::map<std::string, Usage>::const_iterator it;
+        for (it = state.tags.begin(); it != state.tags.end(); ++it) {
+            tags.push_back(it->first);
+        }
+
+        return 0;
+    }
+
+    ________________________________________________________________________________
+
+//! @internal start new high-water marks from the current bytes
+    int ResetPeak() {
+
+        State &state = GetState();
+        std::lock_guard<std::mutex> lock(state.mutex);
+        state.all.peak = state.all.current;
+        std::map<std::string, Usage>::iterator it;
+        for (it = state.tags.begin(); it != state.tags.end(); ++it) {
+            it->second.peak = it->second.current;
+        }
+
+        return 0;
+    }
+
+    ________________________________________________________________________________
+
+//! @internal print current and peak bytes by tag, over the processors
+    int Report(
+            MPI_Comm &mpi_comm) {
+
+        int rank, nproc;
+        MPI_Comm_rank(mpi_comm, &rank);
+        MPI_Comm_size(mpi_comm, &nproc);
+
+        // -- tags of all processors (a tag may be seen by a few of them)
+        std::vector<std::string> tags;
+        GetTags(tags);
+        std::string text;
+        for (size_t t = 0; t < tags.size(); t++) {
+            text += tags[t] + '\n';
+        }
+        int size = (int) text.size();
+        std::vector<int> sizes(nproc);
+        std::vector<int> shifts(nproc);
+        MPI_Allgather(&size, 1, MPI_INT, sizes.data(), 1, MPI_INT, mpi_comm);
+        int total_size = 0;
+        for (int r = 0; r < nproc; r++) {
+            shifts[r] = total_size;
+            total_size += sizes[r];
+        }
+        std::vector<char> all_text(total_size + 1);
+        MPI_Allgatherv(text.data(), size, MPI_CHAR, all_text.data(), sizes.data(),
+                       shifts.data(), MPI_CHAR, mpi_comm);
+        std::set<std::string> all_tags;
+        size_t begin = 0;
+        for (int k = 0; k < total_size; k++) {
+            if (all_text[k] == '\n') {
+                all_tags.insert(std::string(all_text.data() + begin, k - begin));
+                begin = k + 1;
+            }
+        }
+        tags.assign(all_tags.begin(), all_tags.end());
+
+        // -- current, peak, allocations by tag, then of the processor
+        const int numb_tags = (int) tags.size();
+        std::vector<double> values(3 * (numb_tags + 1));
+        Usage usage;
+        for (int t = 0; t <= numb_tags; t++) {
+            GetUsage(usage, (t < numb_tags) ? tags[t].c_str() : NULL);
+            values[3 * t] = (double) usage.current;
+            values[3 * t + 1] = (double) usage.peak;
+            values[3 * t + 2] = (double) usage.numb_allocations;
+        }
+        std::vector<double> values_min(values.size());
+        std::vector<double> values_max(values.size());
+        std::vector<double> values_sum(values.size());
+        MPI_Reduce(values.data(), values_min.data(), (int) values.size(), MPI_DOUBLE, MPI_MIN,
+                   0, mpi_comm);
+        MPI_Reduce(values.data(), values_max.data(), (int) values.size(), MPI_DOUBLE, MPI_MAX,
+                   0, mpi_comm);
+        MPI_Reduce(values.data(), values_sum.data(), (int) values.size(), MPI_DOUBLE, MPI_SUM,
+                   0, mpi_comm);
+        std::vector<double> peaks(nproc);
+        MPI_Gather(&values[3 * numb_tags + 1], 1, MPI_DOUBLE, peaks.data(), 1, MPI_DOUBLE,
+                   0, mpi_comm);
+
+        if (rank == 0) {
+            const double mib = 1. / (1024. * 1024.);
+            iomrg::printf("-- memory (MiB per processor, min / max over %d processors)\n",
+                          nproc);
+            iomrg::printf("%-36s %12s %12s %12s %12s %12s\n", "tag", "current min",
+                          "current max", "peak min", "peak max", "allocations");
+            for (int t = 0; t <= numb_tags; t++) {
+                iomrg::printf("%-36s %12.3f %12.3f %12.3f %12.3f %12.0f\n",
+                              (t < numb_tags) ? tags[t].c_str() : "(all)",
+                              values_min[3 * t] * mib, values_max[3 * t] * mib,
+                              values_min[3 * t + 1] * mib, values_max[3 * t + 1] * mib,
+                              values_sum[3 * t + 2]);
+            }
+            // -- one line: printf prefixes each call with the processor
+            double peak_sum = 0.;
+            std::string line = "-- peak by processor (MiB):";
+            char item[64];
+            for (int r = 0; r < nproc; r++) {
+                snprintf(item, sizeof(item), " %d: %.3f", r, peaks[r] * mib);
+                line += item;
+                peak_sum += peaks[r];
+            }
+            iomrg::printf("%s\n", line.c_str());
+            iomrg::printf("-- sum of the peaks: %.3f MiB\n", peak_sum * mib);
+        }
+
+        return 0;
+    }
+
+    ________________________________________________________________________________
+
+//! @internal constructor: the tag becomes the innermost one
+    Tag::Tag(
+            const char *name) : m_previous(t_tag) {
+
+        t_tag = name;
+    }
+
+    ________________________________________________________________________________
+
+//! @internal destructor: the enclosing tag comes back
+    Tag::~Tag() {
+
+        t_tag = m_previous;
+    }
+
+    ________________________________________________________________________________
+
+} // namespace Memory {
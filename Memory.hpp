@@ -0,0 +1,124 @@
+/*!
+*  @file Memory.hpp
+*  @brief header of Memory (bytes allocated per processor, by allocation site)
+*  @author Abal-Kassim Cheik Ahamed, Frédéric Magoulès, Sonia Toubaline
+*  @date Tue Nov 24 16:16:48 CET 2015
+*  @version 1.0
+*  @remarks the elements of Vector and MatrixDense, the scratch buffers of the
+*           contexts and the staging buffers of the library are counted;
+*           mapped files are not (they belong to the page cache); an
+*           allocation takes the tag of the innermost MEMORY_TAG of its
+*           thread, or the default tag of its site
+*/
+
+#ifndef GUARD_MEMORY_HPP_
+#define GUARD_MEMORY_HPP_
+
+// basic packages
+#include <stdio.h>
+#include <string>
+#include <vector>
+#include <mpi.h>
+
+// project packages
+#include "dllmrg.hpp"
+
+// third-party packages
+
+
+//! @namespace Memory
+namespace Memory {
+
+//! @struct Usage
+//! @brief bytes of an allocation site (or of the processor)
+struct Usage {
+  //! bytes allocated now
+  long long current;
+  //! high-water mark of current
+  long long peak;
+  //! number of allocations
+  long long numb_allocations;
+  //! bytes allocated in total
+  long long total;
+} ; // struct Usage {
+
+//! @brief count an allocation
+//! @param [in] bytes = bytes allocated
+//! @param [in] default_tag = tag of the site if no MEMORY_TAG is active
+//           (string literal, kept by address)
+//! @return tag of the allocation, to be given back to Freed
+const char* Allocated (
+        size_t bytes,
+        const char* default_tag ) ;
+
+//! @brief count a deallocation
+//! @param [in] bytes = bytes released
+//! @param [in] tag = tag returned by Allocated
+//! @return error code
+int Freed (
+        size_t bytes,
+        const char* tag ) ;
+
+//! @brief usage of the calling processor
+//! @param [in,out] usage = usage of the tag, or of all tags
+//! @param [in] tag = allocation site, NULL: all tags
+//! @return error code (1: unknown tag, usage set to zero)
+int GetUsage (
+        Usage& usage,
+        const char* tag = NULL ) ;
+
+//! @brief tags of the calling processor
+//! @param [in,out] tags = tags seen so far, in alphabetical order
+//! @return error code
+int GetTags (
+        std::vector<std::string>& tags ) ;
+
+//! @brief start new high-water marks from the current bytes
+//! @remarks to measure the peak of one phase of a run
+//! @return error code
+int ResetPeak ( ) ;
+
+//! @brief print current and peak bytes by tag, over the processors
+//! @param [in] mpi_comm = MPI communicator
+//! @remarks collective; printed by processor 0 (iomrg::printf); per tag: min
+//           and max over the processors of the current and peak bytes, and the
+//           number of allocations; then the peak of each processor and their
+//           sum (the footprint of the job)
+//! @return error code
+int Report (
+        MPI_Comm& mpi_comm ) ;
+
+//! @class Tag
+//! @brief tag of the allocations of the thread from its construction to its
+//         destruction
+class Tag {
+
+ public:
+
+  //! @brief constructor: the tag becomes the innermost one
+  //! @param [in] name = tag (string literal, kept by address)
+  explicit Tag (
+        const char* name ) ;
+
+  //! @brief destructor: the enclosing tag comes back
+  ~Tag ( ) ;
+
+ private:
+
+  //! enclosing tag
+  const char* m_previous;
+
+} ; // class Tag {
+
+} // namespace Memory {
+
+
+#define MEMORY_CONCAT_( a, b ) a##b
+#define MEMORY_CONCAT( a, b ) MEMORY_CONCAT_( a, b )
+
+//! tag of the allocations until the end of the enclosing block
+#define MEMORY_TAG( name ) \
+  Memory::Tag MEMORY_CONCAT( memory_tag_, __LINE__ )( name )
+
+
+#endif // GUARD_MEMORY_HPP_
@@ -0,0 +1,722 @@
+/*!
+*  @file MpiProfile.cpp
+*  @internal PMPI interception layer (calls, bytes and time of MPI functions)
+*  @author Abal-Kassim Cheik Ahamed, Frédéric Magoulès, Sonia Toubaline
+*  @date Tue Nov 24 16:16:48 CET 2015
+*  @version 1.0
+*  @remarks built as the shared library td1_pmpi, loaded in front of MPI:
+*           mpirun -x LD_PRELOAD=libtd1_pmpi.so -np 4 ./DemoMVPBandRow
+*  @remarks the report is written at MPI_Finalize (stdout of rank 0, or the
+*           file $TD1_PMPI_FILE); $TD1_PMPI_REPORT=rank adds one table per rank
+*  @remarks bytes are the payload of the local buffers (MPI_Type_size, so the
+*           elements selected by a derived datatype): sent to and received
+*           from the other processors, the part of root to itself excluded
+*/
+
+// basic packages
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <map>
+#include <string>
+#include <vector>
+#include <mpi.h>
+
+// project packages
+#include "dllmrg.hpp"
+
+// third-party packages
+
+
+//! @namespace MpiProfile
+namespace MpiProfile {
+
+    ________________________________________________________________________________
+
+//! @internal intercepted functions
+    struct function {
+        enum function_enum {
+            c_SEND = 0,
+            c_RECV,
+            c_ISEND,
+            c_IRECV,
+            c_WAIT,
+            c_WAITALL,
+            c_TEST,
+            c_TESTALL,
+            c_BARRIER,
+            c_BCAST,
+            c_REDUCE,
+            c_ALLREDUCE,
+            c_SCATTER,
+            c_SCATTERV,
+            c_ISCATTERV,
+            c_GATHER,
+            c_GATHERV,
+            c_IGATHERV,
+            c_ALLGATHER,
+            c_ALLGATHERV,
+            c_IALLGATHERV,
+            c_ALLTOALL,
+            c_ALLTOALLV,
+            c_ALLTOALLW,
+            c_NUMB_FUNCTIONS
+        };
+    };
+
+    const char *g_function_names[function::c_NUMB_FUNCTIONS] = {
+            "MPI_Send", "MPI_Recv", "MPI_Isend", "MPI_Irecv", "MPI_Wait", "MPI_Waitall",
+            "MPI_Test", "MPI_Testall",
+            "MPI_Barrier", "MPI_Bcast", "MPI_Reduce", "MPI_Allreduce",
+            "MPI_Scatter", "MPI_Scatterv", "MPI_Iscatterv",
+            "MPI_Gather", "MPI_Gatherv", "MPI_Igatherv",
+            "MPI_Allgather", "MPI_Allgatherv", "MPI_Iallgatherv",
+            "MPI_Alltoall", "MPI_Alltoallv", "MPI_Alltoallw"};
+
+//! @internal counters of a function (or of a communicator)
+    struct Stat {
+        //! number of calls
+        long long numb_calls;
+        //! bytes sent to other processors
+        long long bytes_sent;
+        //! bytes received from other processors
+        long long bytes_recv;
+        //! time spent in the calls (s)
+        double time;
+    };
+
+//! @internal counters by function
+    Stat g_functions[function::c_NUMB_FUNCTIONS];
+
+//! @internal counters by communicator label
+    std::map<std::string, Stat> g_comms;
+
+//! @internal label of the communicators in use (by handle)
+    std::map<MPI_Comm, std::string> g_comm_labels;
+
+//! @internal number of communicators labelled so far
+    int g_numb_comms = 0;
+
+//! @internal time of MPI_Init (s)
+    double g_time_init = 0.;
+
+    ________________________________________________________________________________
+
+//! @internal bytes of count elements of a datatype
+    long long Bytes(
+            int count,
+            MPI_Datatype datatype) {
+
+        int size = 0;
+        PMPI_Type_size(datatype, &size);
+
+        return (long long) count * size;
+    }
+
+    ________________________________________________________________________________
+
+//! @internal label of a communicator: world, self, or order of first use
+//! @remarks collectives are called in the same order by all processors, so
+//           the labels usually agree between processors
+    const std::string &CommLabel(
+            MPI_Comm comm) {
+
+        std::map<MPI_Comm, std::string>::iterator it = g_comm_labels.find(comm);
+        if (it != g_comm_labels.end()) {
+            return it->second;
+        }
+
+        // -- completion of requests (MPI_Wait, MPI_Test, ...) has no communicator
+        char label[64];
+        if (comm == MPI_COMM_NULL) {
+            snprintf(label, sizeof(label), "requests");
+        } else if (comm == MPI_COMM_WORLD) {
+            snprintf(label, sizeof(label), "world");
+        } else if (comm == MPI_COMM_SELF) {
+            snprintf(label, sizeof(label), "self");
+        } else {
+            int size;
+            PMPI_Comm_size(comm, &size);
+            snprintf(label, sizeof(label), "comm %d [%d procs]", ++g_numb_comms, size);
+        }
+
+        return g_comm_labels[comm] = label;
+    }
+
+    ________________________________________________________________________________
+
+//! @internal record a call
+    void Record(
+            int function_numb,
+            MPI_Comm comm,
+            long long bytes_sent,
+            long long bytes_recv,
+            double time) {
+
+        Stat *stats[2] = {&g_functions[function_numb], &g_comms[CommLabel(comm)]};
+        for (int k = 0; k < 2; k++) {
+            stats[k]->numb_calls++;
+            stats[k]->bytes_sent += bytes_sent;
+            stats[k]->bytes_recv += bytes_recv;
+            stats[k]->time += time;
+        }
+    }
+
+    ________________________________________________________________________________
+
+//! @internal rank of the processor in a communicator
+    int Rank(
+            MPI_Comm comm) {
+
+        int rank;
+        PMPI_Comm_rank(comm, &rank);
+
+        return rank;
+    }
+
+    ________________________________________________________________________________
+
+//! @internal sum of counts * size over the processors but me
+    long long BytesOthers(
+            const int *counts,
+            MPI_Datatype datatype,
+            int rank,
+            int nproc) {
+
+        long long count = 0;
+        for (int k = 0; k < nproc; k++) {
+            count += (k != rank) ? counts[k] : 0;
+        }
+
+        return count * Bytes(1, datatype);
+    }
+
+    ________________________________________________________________________________
+
+//! @internal serialize the counters: one line "kind<TAB>name<TAB>values" per row
+    std::string Serialize() {
+
+        std::string text;
+        char line[256];
+        for (int f = 0; f < function::c_NUMB_FUNCTIONS; f++) {
+            const Stat &stat = g_functions[f];
+            if (stat.numb_calls == 0) {
+                continue;
+            }
+            snprintf(line, sizeof(line), "f\t%s\t%lld %lld %lld %.9e\n", g_function_names[f],
+                     stat.numb_calls, stat.bytes_sent, stat.bytes_recv, stat.time);
+            text += line;
+        }
+        std::map<std::string, Stat>::const_iterator it;
+        for (it = g_comms.begin(); it != g_comms.end(); ++it) {
+            snprintf(line, sizeof(line), "c\t%s\t%lld %lld %lld %.9e\n", it->first.c_str(),
+                     it->second.numb_calls, it->second.bytes_sent, it->second.bytes_recv,
+                     it->second.time);
+            text += line;
+        }
+
+        return text;
+    }
+
+    ________________________________________________________________________________
+
+//! @internal counters of all processors for a row (kind, name)
+    struct Row {
+        //! number of processors which called
+        int numb_procs;
+        //! sum over the processors
+        Stat sum;
+        //! min of the time over the processors
+        double time_min;
+        //! max of the time over the processors
+        double time_max;
+    };
+
+    ________________________________________________________________________________
+
+//! @internal print a table of rows
+    void PrintTable(
+            FILE *file,
+            const char *title,
+            const std::vector<std::pair<std::string, Row> > &rows,
+            int nproc) {
+
+        fprintf(file, "%-24s %10s %14s %14s %12s %12s %12s\n", title, "calls",
+                "bytes sent", "bytes recv", "min (s)", "mean (s)", "max (s)");
+        for (size_t k = 0; k < rows.size(); k++) {
+            const Row &row = rows[k].second;
+            fprintf(file, "%-24s %10lld %14lld %14lld %12.6f %12.6f %12.6f\n",
+                    rows[k].first.c_str(), row.sum.numb_calls, row.sum.bytes_sent,
+                    row.sum.bytes_recv, (row.numb_procs < nproc) ? 0. : row.time_min,
+                    row.sum.time / nproc, row.time_max);
+        }
+        fprintf(file, "\n");
+    }
+
+    ________________________________________________________________________________
+
+//! @internal parse the serialized counters of a processor and merge them
+    void Merge(
+            std::map<std::string, Row> &functions,
+            std::map<std::string, Row> &comms,
+            std::vector<std::pair<std::string, Row> > &functions_proc,
+            std::vector<std::pair<std::string, Row> > &comms_proc,
+            const char *text,
+            int size) {
+
+        std::string lines(text, size);
+        size_t pos = 0;
+        while (pos < lines.size()) {
+            size_t end = lines.find('\n', pos);
+            std::string line = lines.substr(pos, end - pos);
+            pos = end + 1;
+
+            size_t tab_1 = line.find('\t');
+            size_t tab_2 = line.find('\t', tab_1 + 1);
+            std::string name = line.substr(tab_1 + 1, tab_2 - tab_1 - 1);
+            Row row;
+            row.numb_procs = 1;
+            sscanf(line.c_str() + tab_2 + 1, "%lld %lld %lld %le", &row.sum.numb_calls,
+                   &row.sum.bytes_sent, &row.sum.bytes_recv, &row.sum.time);
+            row.time_min = row.sum.time;
+            row.time_max = row.sum.time;
+
+            bool is_function = (line[0] == 'f');
+            (is_function ? functions_proc : comms_proc).push_back(std::make_pair(name, row));
+            std::map<std::string, Row> &rows = is_function ? functions : comms;
+            std::map<std::string, Row>::iterator it = rows.find(name);
+            if (it == rows.end()) {
+                rows[name] = row;
+                continue;
+            }
+            Row &merged = it->second;
+            merged.numb_procs++;
+            merged.sum.numb_calls += row.sum.numb_calls;
+            merged.sum.bytes_sent += row.sum.bytes_sent;
+            merged.sum.bytes_recv += row.sum.bytes_recv;
+            merged.sum.time += row.sum.time;
+            merged.time_min = (row.time_min < merged.time_min) ? row.time_min : merged.time_min;
+            merged.time_max = (row.time_max > merged.time_max) ? row.time_max : merged.time_max;
+        }
+    }
+
+    ________________________________________________________________________________
+
+//! @internal gather the counters on rank 0 and write the report
+    int Report() {
+
+        const int root = 0;
+        int rank, nproc;
+        PMPI_Comm_rank(MPI_COMM_WORLD, &rank);
+        PMPI_Comm_size(MPI_COMM_WORLD, &nproc);
+        double time_total = PMPI_Wtime() - g_time_init;
+
+        std::string text = Serialize();
+        int size = (int) text.size();
+        std::vector<int> sizes(nproc), shifts(nproc);
+        PMPI_Gather(&size, 1, MPI_INT, sizes.data(), 1, MPI_INT, root, MPI_COMM_WORLD);
+        int total_size = 0;
+        for (int p = 0; rank == root && p < nproc; p++) {
+            shifts[p] = total_size;
+            total_size += sizes[p];
+        }
+        std::vector<char> text_all(total_size + 1);
+        PMPI_Gatherv(text.data(), size, MPI_CHAR, text_all.data(), sizes.data(), shifts.data(),
+                     MPI_CHAR, root, MPI_COMM_WORLD);
+        std::vector<double> times_total(nproc);
+        PMPI_Gather(&time_total, 1, MPI_DOUBLE, times_total.data(), 1, MPI_DOUBLE, root,
+                    MPI_COMM_WORLD);
+        if (rank != root) {
+            return 0;
+        }
+
+        const char *file_name = getenv("TD1_PMPI_FILE");
+        const char *report = getenv("TD1_PMPI_REPORT");
+        bool opt_rank = (report != NULL && strcmp(report, "rank") == 0);
+        FILE *file = (file_name != NULL) ? fopen(file_name, "w") : stdout;
+        if (file == NULL) {
+            return 1;
+        }
+
+        // -- per processor, then aggregated over the processors
+        std::map<std::string, Row> functions, comms;
+        double time_mpi = 0.;
+        for (int p = 0; p < nproc; p++) {
+            std::vector<std::pair<std::string, Row> > functions_proc, comms_proc;
+            Merge(functions, comms, functions_proc, comms_proc,
+                  text_all.data() + shifts[p], sizes[p]);
+            double time_mpi_proc = 0.;
+            for (size_t k = 0; k < functions_proc.size(); k++) {
+                time_mpi_proc += functions_proc[k].second.sum.time;
+            }
+            time_mpi += time_mpi_proc;
+            if (opt_rank) {
+                fprintf(file, "-- MPI profile [rank %d/%d] [time in MPI: %.6f s / %.6f s]\n",
+                        p, nproc, time_mpi_proc, times_total[p]);
+                PrintTable(file, "function", functions_proc, 1);
+                PrintTable(file, "communicator", comms_proc, 1);
+            }
+        }
+
+        double time_total_sum = 0.;
+        for (int p = 0; p < nproc; p++) {
+            time_total_sum += times_total[p];
+        }
+        fprintf(file, "-- MPI profile [numb_procs: %d] [time in MPI: %.1f %%]\n", nproc,
+                (time_total_sum > 0.) ? 100. * time_mpi / time_total_sum : 0.);
+        PrintTable(file, "function",
+                   std::vector<std::pair<std::string, Row> >(functions.begin(), functions.end()),
+                   nproc);
+        PrintTable(file, "communicator",
+                   std::vector<std::pair<std::string, Row> >(comms.begin(), comms.end()),
+                   nproc);
+
+        if (file != stdout) {
+            fclose(file);
+        } else {
+            fflush(file);
+        }
+
+        return 0;
+    }
+
+    ________________________________________________________________________________
+
+} // namespace MpiProfile {
+
+
+// -----------------------------------------------------------------------------
+// -- Intercepted MPI functions (forwarded to PMPI)
+// -----------------------------------------------------------------------------
+
+namespace mp = MpiProfile;
+
+int MPI_Init(int *argc, char ***argv) {
+    int error = PMPI_Init(argc, argv);
+    mp::g_time_init = PMPI_Wtime();
+    return error;
+}
+
+int MPI_Init_thread(int *argc, char ***argv, int required, int *provided) {
+    int error = PMPI_Init_thread(argc, argv, required, provided);
+    mp::g_time_init = PMPI_Wtime();
+    return error;
+}
+
+int MPI_Finalize(void) {
+    mp::Report();
+    return PMPI_Finalize();
+}
+
+int MPI_Comm_free(MPI_Comm *comm) {
+    // -- the handle may be reused by a new communicator
+    mp::g_comm_labels.erase(*comm);
+    return PMPI_Comm_free(comm);
+}
+
+int MPI_Send(const void *buf, int count, MPI_Datatype datatype, int dest,
+             int tag, MPI_Comm comm) {
+    double t = PMPI_Wtime();
+    int error = PMPI_Send(buf, count, datatype, dest, tag, comm);
+    mp::Record(mp::function::c_SEND, comm,
+               (dest == mp::Rank(comm)) ? 0 : mp::Bytes(count, datatype), 0,
+               PMPI_Wtime() - t);
+    return error;
+}
+
+int MPI_Recv(void *buf, int count, MPI_Datatype datatype, int source,
+             int tag, MPI_Comm comm, MPI_Status *status) {
+    // -- bytes actually received, even if the caller ignores the status
+    MPI_Status status_local;
+    MPI_Status *status_used = (status == MPI_STATUS_IGNORE) ? &status_local : status;
+    double t = PMPI_Wtime();
+    int error = PMPI_Recv(buf, count, datatype, source, tag, comm, status_used);
+    double time = PMPI_Wtime() - t;
+    int numb_bytes = 0;
+    if (status_used->MPI_SOURCE != mp::Rank(comm)) {
+        PMPI_Get_count(status_used, MPI_BYTE, &numb_bytes);
+    }
+    mp::Record(mp::function::c_RECV, comm, 0, numb_bytes, time);
+    return error;
+}
+
+int MPI_Isend(const void *buf, int count, MPI_Datatype datatype, int dest,
+              int tag, MPI_Comm comm, MPI_Request *request) {
+    double t = PMPI_Wtime();
+    int error = PMPI_Isend(buf, count, datatype, dest, tag, comm, request);
+    mp::Record(mp::function::c_ISEND, comm,
+               (dest == mp::Rank(comm)) ? 0 : mp::Bytes(count, datatype), 0,
+               PMPI_Wtime() - t);
+    return error;
+}
+
+int MPI_Irecv(void *buf, int count, MPI_Datatype datatype, int source,
+              int tag, MPI_Comm comm, MPI_Request *request) {
+    double t = PMPI_Wtime();
+    int error = PMPI_Irecv(buf, count, datatype, source, tag, comm, request);
+    mp::Record(mp::function::c_IRECV, comm, 0,
+               (source == mp::Rank(comm)) ? 0 : mp::Bytes(count, datatype),
+               PMPI_Wtime() - t);
+    return error;
+}
+
+int MPI_Wait(MPI_Request *request, MPI_Status *status) {
+    double t = PMPI_Wtime();
+    int error = PMPI_Wait(request, status);
+    mp::Record(mp::function::c_WAIT, MPI_COMM_NULL, 0, 0, PMPI_Wtime() - t);
+    return error;
+}
+
+int MPI_Waitall(int count, MPI_Request array_of_requests[],
+                MPI_Status *array_of_statuses) {
+    double t = PMPI_Wtime();
+    int error = PMPI_Waitall(count, array_of_requests, array_of_statuses);
+    mp::Record(mp::function::c_WAITALL, MPI_COMM_NULL, 0, 0, PMPI_Wtime() - t);
+    return error;
+}
+
+int MPI_Test(MPI_Request *request, int *flag, MPI_Status *status) {
+    double t = PMPI_Wtime();
+    int error = PMPI_Test(request, flag, status);
+    mp::Record(mp::function::c_TEST, MPI_COMM_NULL, 0, 0, PMPI_Wtime() - t);
+    return error;
+}
+
+int MPI_Testall(int count, MPI_Request array_of_requests[], int *flag,
+                MPI_Status *array_of_statuses) {
+    double t = PMPI_Wtime();
+    int error = PMPI_Testall(count, array_of_requests, flag, array_of_statuses);
+    mp::Record(mp::function::c_TESTALL, MPI_COMM_NULL, 0, 0, PMPI_Wtime() - t);
+    return error;
+}
+
+int MPI_Barrier(MPI_Comm comm) {
+    double t = PMPI_Wtime();
+    int error = PMPI_Barrier(comm);
+    mp::Record(mp::function::c_BARRIER, comm, 0, 0, PMPI_Wtime() - t);
+    return error;
+}
+
+int MPI_Bcast(void *buffer, int count, MPI_Datatype datatype,
+              int root, MPI_Comm comm) {
+    int rank, nproc;
+    PMPI_Comm_rank(comm, &rank);
+    PMPI_Comm_size(comm, &nproc);
+    double t = PMPI_Wtime();
+    int error = PMPI_Bcast(buffer, count, datatype, root, comm);
+    long long bytes = mp::Bytes(count, datatype);
+    mp::Record(mp::function::c_BCAST, comm, (rank == root) ? bytes * (nproc - 1) : 0,
+               (rank == root) ? 0 : bytes, PMPI_Wtime() - t);
+    return error;
+}
+
+int MPI_Reduce(const void *sendbuf, void *recvbuf, int count,
+               MPI_Datatype datatype, MPI_Op op, int root, MPI_Comm comm) {
+    int rank, nproc;
+    PMPI_Comm_rank(comm, &rank);
+    PMPI_Comm_size(comm, &nproc);
+    double t = PMPI_Wtime();
+    int error = PMPI_Reduce(sendbuf, recvbuf, count, datatype, op, root, comm);
+    long long bytes = mp::Bytes(count, datatype);
+    mp::Record(mp::function::c_REDUCE, comm, (rank == root) ? 0 : bytes,
+               (rank == root) ? bytes * (nproc - 1) : 0, PMPI_Wtime() - t);
+    return error;
+}
+
+int MPI_Allreduce(const void *sendbuf, void *recvbuf, int count,
+                  MPI_Datatype datatype, MPI_Op op, MPI_Comm comm) {
+    int nproc;
+    PMPI_Comm_size(comm, &nproc);
+    double t = PMPI_Wtime();
+    int error = PMPI_Allreduce(sendbuf, recvbuf, count, datatype, op, comm);
+    long long bytes = (nproc > 1) ? mp::Bytes(count, datatype) : 0;
+    mp::Record(mp::function::c_ALLREDUCE, comm, bytes, bytes, PMPI_Wtime() - t);
+    return error;
+}
+
+int MPI_Scatter(const void *sendbuf, int sendcount, MPI_Datatype sendtype,
+                void *recvbuf, int recvcount, MPI_Datatype recvtype,
+                int root, MPI_Comm comm) {
+    int rank, nproc;
+    PMPI_Comm_rank(comm, &rank);
+    PMPI_Comm_size(comm, &nproc);
+    double t = PMPI_Wtime();
+    int error = PMPI_Scatter(sendbuf, sendcount, sendtype, recvbuf, recvcount, recvtype,
+                             root, comm);
+    mp::Record(mp::function::c_SCATTER, comm,
+               (rank == root) ? mp::Bytes(sendcount, sendtype) * (nproc - 1) : 0,
+               (rank == root) ? 0 : mp::Bytes(recvcount, recvtype), PMPI_Wtime() - t);
+    return error;
+}
+
+int MPI_Scatterv(const void *sendbuf, const int sendcounts[], const int displs[],
+                 MPI_Datatype sendtype, void *recvbuf, int recvcount,
+                 MPI_Datatype recvtype, int root, MPI_Comm comm) {
+    int rank, nproc;
+    PMPI_Comm_rank(comm, &rank);
+    PMPI_Comm_size(comm, &nproc);
+    double t = PMPI_Wtime();
+    int error = PMPI_Scatterv(sendbuf, sendcounts, displs, sendtype, recvbuf, recvcount,
+                              recvtype, root, comm);
+    mp::Record(mp::function::c_SCATTERV, comm,
+               (rank == root) ? mp::BytesOthers(sendcounts, sendtype, rank, nproc) : 0,
+               (rank == root) ? 0 : mp::Bytes(recvcount, recvtype), PMPI_Wtime() - t);
+    return error;
+}
+
+int MPI_Iscatterv(const void *sendbuf, const int sendcounts[], const int displs[],
+                  MPI_Datatype sendtype, void *recvbuf, int recvcount,
+                  MPI_Datatype recvtype, int root, MPI_Comm comm, MPI_Request *request) {
+    int rank, nproc;
+    PMPI_Comm_rank(comm, &rank);
+    PMPI_Comm_size(comm, &nproc);
+    double t = PMPI_Wtime();
+    int error = PMPI_Iscatterv(sendbuf, sendcounts, displs, sendtype, recvbuf, recvcount,
+                               recvtype, root, comm, request);
+    mp::Record(mp::function::c_ISCATTERV, comm,
+               (rank == root) ? mp::BytesOthers(sendcounts, sendtype, rank, nproc) : 0,
+               (rank == root) ? 0 : mp::Bytes(recvcount, recvtype), PMPI_Wtime() - t);
+    return error;
+}
+
+int MPI_Gather(const void *sendbuf, int sendcount, MPI_Datatype sendtype,
+               void *recvbuf, int recvcount, MPI_Datatype recvtype,
+               int root, MPI_Comm comm) {
+    int rank, nproc;
+    PMPI_Comm_rank(comm, &rank);
+    PMPI_Comm_size(comm, &nproc);
+    double t = PMPI_Wtime();
+    int error = PMPI_Gather(sendbuf, sendcount, sendtype, recvbuf, recvcount, recvtype,
+                            root, comm);
+    mp::Record(mp::function::c_GATHER, comm,
+               (rank == root) ? 0 : mp::Bytes(sendcount, sendtype),
+               (rank == root) ? mp::Bytes(recvcount, recvtype) * (nproc - 1) : 0,
+               PMPI_Wtime() - t);
+    return error;
+}
+
+int MPI_Gatherv(const void *sendbuf, int sendcount, MPI_Datatype sendtype,
+                void *recvbuf, const int recvcounts[], const int displs[],
+                MPI_Datatype recvtype, int root, MPI_Comm comm) {
+    int rank, nproc;
+    PMPI_Comm_rank(comm, &rank);
+    PMPI_Comm_size(comm, &nproc);
+    double t = PMPI_Wtime();
+    int error = PMPI_Gatherv(sendbuf, sendcount, sendtype, recvbuf, recvcounts, displs,
+                             recvtype, root, comm);
+    mp::Record(mp::function::c_GATHERV, comm,
+               (rank == root) ? 0 : mp::Bytes(sendcount, sendtype),
+               (rank == root) ? mp::BytesOthers(recvcounts, recvtype, rank, nproc) : 0,
+               PMPI_Wtime() - t);
+    return error;
+}
+
+int MPI_Igatherv(const void *sendbuf, int sendcount, MPI_Datatype sendtype,
+                 void *recvbuf, const int recvcounts[], const int displs[],
+                 MPI_Datatype recvtype, int root, MPI_Comm comm, MPI_Request *request) {
+    int rank, nproc;
+    PMPI_Comm_rank(comm, &rank);
+    PMPI_Comm_size(comm, &nproc);
+    double t = PMPI_Wtime();
+    int error = PMPI_Igatherv(sendbuf, sendcount, sendtype, recvbuf, recvcounts, displs,
+                              recvtype, root, comm, request);
+    mp::Record(mp::function::c_IGATHERV, comm,
+               (rank == root) ? 0 : mp::Bytes(sendcount, sendtype),
+               (rank == root) ? mp::BytesOthers(recvcounts, recvtype, rank, nproc) : 0,
+               PMPI_Wtime() - t);
+    return error;
+}
+
+int MPI_Allgather(const void *sendbuf, int sendcount, MPI_Datatype sendtype,
+                  void *recvbuf, int recvcount, MPI_Datatype recvtype, MPI_Comm comm) {
+    int nproc;
+    PMPI_Comm_size(comm, &nproc);
+    double t = PMPI_Wtime();
+    int error = PMPI_Allgather(sendbuf, sendcount, sendtype, recvbuf, recvcount, recvtype,
+                               comm);
+    long long bytes = mp::Bytes(recvcount, recvtype) * (nproc - 1);
+    mp::Record(mp::function::c_ALLGATHER, comm, bytes, bytes, PMPI_Wtime() - t);
+    return error;
+}
+
+int MPI_Allgatherv(const void *sendbuf, int sendcount, MPI_Datatype sendtype,
+                   void *recvbuf, const int recvcounts[],
+                   const int displs[], MPI_Datatype recvtype, MPI_Comm comm) {
+    int rank, nproc;
+    PMPI_Comm_rank(comm, &rank);
+    PMPI_Comm_size(comm, &nproc);
+    double t = PMPI_Wtime();
+    int error = PMPI_Allgatherv(sendbuf, sendcount, sendtype, recvbuf, recvcounts, displs,
+                                recvtype, comm);
+    // -- my part goes to every other processor
+    mp::Record(mp::function::c_ALLGATHERV, comm,
+               mp::Bytes(recvcounts[rank], recvtype) * (nproc - 1),
+               mp::BytesOthers(recvcounts, recvtype, rank, nproc), PMPI_Wtime() - t);
+    return error;
+}
+
+int MPI_Iallgatherv(const void *sendbuf, int sendcount, MPI_Datatype sendtype,
+                    void *recvbuf, const int recvcounts[], const int displs[],
+                    MPI_Datatype recvtype, MPI_Comm comm, MPI_Request *request) {
+    int rank, nproc;
+    PMPI_Comm_rank(comm, &rank);
+    PMPI_Comm_size(comm, &nproc);
+    double t = PMPI_Wtime();
+    int error = PMPI_Iallgatherv(sendbuf, sendcount, sendtype, recvbuf, recvcounts, displs,
+                                 recvtype, comm, request);
+    // -- my part goes to every other processor (time: posting only)
+    mp::Record(mp::function::c_IALLGATHERV, comm,
+               mp::Bytes(recvcounts[rank], recvtype) * (nproc - 1),
+               mp::BytesOthers(recvcounts, recvtype, rank, nproc), PMPI_Wtime() - t);
+    return error;
+}
+
+int MPI_Alltoall(const void *sendbuf, int sendcount, MPI_Datatype sendtype,
+                 void *recvbuf, int recvcount, MPI_Datatype recvtype, MPI_Comm comm) {
+    int nproc;
+    PMPI_Comm_size(comm, &nproc);
+    double t = PMPI_Wtime();
+    int error = PMPI_Alltoall(sendbuf, sendcount, sendtype, recvbuf, recvcount, recvtype,
+                              comm);
+    mp::Record(mp::function::c_ALLTOALL, comm,
+               mp::Bytes(sendcount, sendtype) * (nproc - 1),
+               mp::Bytes(recvcount, recvtype) * (nproc - 1), PMPI_Wtime() - t);
+    return error;
+}
+
+int MPI_Alltoallv(const void *sendbuf, const int sendcounts[], const int sdispls[],
+                  MPI_Datatype sendtype, void *recvbuf, const int recvcounts[],
+                  const int rdispls[], MPI_Datatype recvtype, MPI_Comm comm) {
+    int rank, nproc;
+    PMPI_Comm_rank(comm, &rank);
+    PMPI_Comm_size(comm, &nproc);
+    double t = PMPI_Wtime();
+    int error = PMPI_Alltoallv(sendbuf, sendcounts, sdispls, sendtype, recvbuf, recvcounts,
+                               rdispls, recvtype, comm);
+    mp::Record(mp::function::c_ALLTOALLV, comm,
+               mp::BytesOthers(sendcounts, sendtype, rank, nproc),
+               mp::BytesOthers(recvcounts, recvtype, rank, nproc), PMPI_Wtime() - t);
+    return error;
+}
+
+int MPI_Alltoallw(const void *sendbuf, const int sendcounts[], const int sdispls[],
+                  const MPI_Datatype sendtypes[], void *recvbuf, const int recvcounts[],
+                  const int rdispls[], const MPI_Datatype recvtypes[], MPI_Comm comm) {
+    int rank, nproc;
+    PMPI_Comm_rank(comm, &rank);
+    PMPI_Comm_size(comm, &nproc);
+    double t = PMPI_Wtime();
+    int error = PMPI_Alltoallw(sendbuf, sendcounts, sdispls, sendtypes, recvbuf, recvcounts,
+                               rdispls, recvtypes, comm);
+    double time = PMPI_Wtime() - t;
+    long long bytes_sent = 0;
+    long long bytes_recv = 0;
+    for (int k = 0; k < nproc; k++) {
+        if (k != rank) {
+            bytes_sent += mp::Bytes(sendcounts[k], sendtypes[k]);
+            bytes_recv += mp::Bytes(recvcounts[k], recvtypes[k]);
+        }
+    }
+    mp::Record(mp::function::c_ALLTOALLW, comm, bytes_sent, bytes_recv, time);
+    return error;
+}
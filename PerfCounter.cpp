@@ -0,0 +1,381 @@
+/*!
+*  @file PerfCounter.cpp
+*  @internal source of PerfCounter (hardware counters around the kernels)
+*  @author Abal-Kassim Cheik Ahamed, Frédéric Magoulès, Sonia Toubaline
+*  @date Tue Nov 24 16:16:48 CET 2015
+*  @version 1.0
+*  @remarks
+*/
+
+// basic packages
+#include <stdlib.h>
+#include <string.h>
+#if defined(TD1_PERF) && defined(__linux__)
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// project packages
+#include "PerfCounter.hpp"
+
+// third-party packages
+
+
+//! @namespace PerfCounter
+namespace PerfCounter {
+
+    bool g_enabled = true;
+
+    ________________________________________________________________________________
+
+//! @internal counters of a thread: one group, led by the first event opened
+    struct Counters {
+        //! open attempted
+        bool is_open;
+        //! file descriptor of the group leader (-1: counters unavailable)
+        int leader;
+        //! file descriptors by event (-1: not counted)
+        int fds[event::c_NUMB_EVENTS];
+        //! events in the order of the group
+        int order[event::c_NUMB_EVENTS];
+        //! number of events counted
+        int numb_open;
+
+        Counters() : is_open(false), leader(-1), numb_open(0) {
+            for (int e = 0; e < event::c_NUMB_EVENTS; e++) {
+                fds[e] = -1;
+            }
+        }
+
+        ~Counters() {
+#if defined(TD1_PERF) && defined(__linux__)
+            for (int e = 0; e < event::c_NUMB_EVENTS; e++) {
+                if (fds[e] >= 0) {
+                    close(fds[e]);
+                }
+            }
+#endif
+        }
+    };
+
+    thread_local Counters t_counters;
+
+//! @internal totals of a region
+    struct Region {
+        long long calls;
+        //! calls during which the group was scheduled (counts valid)
+        long long calls_counted;
+        double time;
+        double flops;
+        double bytes;
+        unsigned long long values[event::c_NUMB_EVENTS];
+    };
+
+    std::mutex g_regions_mutex;
+    std::map<std::string, Region> g_regions;
+
+    ________________________________________________________________________________
+
+//! @internal seconds since an arbitrary origin
+    double Now() {
+
+        return std::chrono::duration<double>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    ________________________________________________________________________________
+
+#if defined(TD1_PERF) && defined(__linux__)
+
+//! @internal open an event of the calling thread (user space only)
+    int OpenEvent(
+            unsigned int type,
+            unsigned long long config,
+            int group_fd) {
+
+        struct perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = type;
+        attr.config = config;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED |
+                           PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+        return (int) syscall(SYS_perf_event_open, &attr, 0, -1, group_fd,
+                             PERF_FLAG_FD_CLOEXEC);
+    }
+
+    ________________________________________________________________________________
+
+//! @internal counters of the calling thread, opened on first use
+    Counters &Open() {
+
+        Counters &counters = t_counters;
+        if (counters.is_open) {
+            return counters;
+        }
+        counters.is_open = true;
+
+        const char *fp_event = getenv("TD1_PERF_FP_EVENT");
+        for (int e = 0; e < event::c_NUMB_EVENTS; e++) {
+            unsigned int type = PERF_TYPE_HARDWARE;
+            unsigned long long config = 0;
+            if (e == event::c_CYCLES) {
+                config = PERF_COUNT_HW_CPU_CYCLES;
+            } else if (e == event::c_INSTRUCTIONS) {
+                config = PERF_COUNT_HW_INSTRUCTIONS;
+            } else if (e == event::c_LLC_MISSES) {
+                type = PERF_TYPE_HW_CACHE;
+                config = PERF_COUNT_HW_CACHE_LL | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                         (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+            } else if (fp_event != NULL) {
+                type = PERF_TYPE_RAW;
+                config = strtoull(fp_event, NULL, 16);
+            } else {
+                continue;
+            }
+            int fd = OpenEvent(type, config, counters.leader);
+            if (fd < 0) {
+                continue;
+            }
+            counters.fds[e] = fd;
+            counters.order[counters.numb_open++] = e;
+            if (counters.leader < 0) {
+                counters.leader = fd;
+            }
+        }
+
+        return counters;
+    }
+
+    ________________________________________________________________________________
+
+//! @internal read the counters of the group, with the times the group was
+//            enabled and running (shorter when multiplexed with other groups)
+    int Read(
+            const Counters &counters,
+            unsigned long long values[event::c_NUMB_EVENTS],
+            unsigned long long times[2]) {
+
+        // -- number of events, time enabled, time running, values
+        unsigned long long data[3 + event::c_NUMB_EVENTS];
+        if (read(counters.leader, data, sizeof(data)) < (ssize_t) (3 * sizeof(data[0]))) {
+            return 1;
+        }
+        times[0] = data[1];
+        times[1] = data[2];
+        for (int k = 0; k < counters.numb_open && k < (int) data[0]; k++) {
+            values[counters.order[k]] = data[3 + k];
+        }
+
+        return 0;
+    }
+
+#else // #if defined(TD1_PERF) && defined(__linux__)
+
+//! @internal without TD1_PERF or off Linux: no counters, the regions do nothing
+    Counters &Open() {
+
+        t_counters.is_open = true;
+
+        return t_counters;
+    }
+
+//! @internal without TD1_PERF or off Linux: nothing to read
+    int Read(
+            const Counters &counters,
+            unsigned long long values[event::c_NUMB_EVENTS],
+            unsigned long long times[2]) {
+
+        return 1;
+    }
+
+#endif // #if defined(TD1_PERF) && defined(__linux__)
+
+    ________________________________________________________________________________
+
+//! @internal counters of the calling thread, opened on first use
+    int Available(
+            bool available[event::c_NUMB_EVENTS]) {
+
+        Counters &counters = Open();
+        for (int e = 0; e < event::c_NUMB_EVENTS; e++) {
+            available[e] = (counters.fds[e] >= 0);
+        }
+
+        return counters.numb_open;
+    }
+
+    ________________________________________________________________________________
+
+//! @internal constructor: read the counters
+    Scope::Scope(
+            const char *name,
+            double flops,
+            double bytes) : m_name(name), m_flops(flops), m_bytes(bytes),
+                            m_time(0.), m_active(false) {
+
+        if (!g_enabled) {
+            return;
+        }
+        Counters &counters = Open();
+        if (counters.numb_open == 0) {
+            return;
+        }
+        memset(m_values, 0, sizeof(m_values));
+        m_active = (Read(counters, m_values, m_times) == 0);
+        m_time = Now();
+    }
+
+    ________________________________________________________________________________
+
+//! @internal destructor: read the counters, add the differences to the region
+    Scope::~Scope() {
+
+        if (!m_active) {
+            return;
+        }
+        double time = Now() - m_time;
+        unsigned long long values[event::c_NUMB_EVENTS];
+        unsigned long long times[2];
+        memset(values, 0, sizeof(values));
+        if (Read(t_counters, values, times) != 0) {
+            return;
+        }
+        // -- group never scheduled in the region (counters held by others):
+        //    counts unavailable; multiplexed: counts scaled to the whole region
+        double enabled = (double) (times[0] - m_times[0]);
+        double running = (double) (times[1] - m_times[1]);
+        double scale = (running > 0. && running < enabled) ? enabled / running : 1.;
+
+        std::lock_guard<std::mutex> lock(g_regions_mutex);
+        std::map<std::string, Region>::iterator it = g_regions.find(m_name);
+        if (it == g_regions.end()) {
+            Region region;
+            memset(&region, 0, sizeof(region));
+            it = g_regions.insert(std::make_pair(std::string(m_name), region)).first;
+        }
+        Region &region = it->second;
+        region.calls++;
+        region.time += time;
+        region.flops += m_flops;
+        region.bytes += m_bytes;
+        if (running <= 0.) {
+            return;
+        }
+        region.calls_counted++;
+        for (int e = 0; e < event::c_NUMB_EVENTS; e++) {
+            region.values[e] += (unsigned long long) ((values[e] - m_values[e]) * scale);
+        }
+    }
+
+    ________________________________________________________________________________
+
+//! @internal print the regions of each processor, with derived metrics
+    int Report(
+            MPI_Comm &mpi_comm,
+            FILE *stream) {
+
+        int rank, nproc;
+        MPI_Comm_rank(mpi_comm, &rank);
+        MPI_Comm_size(mpi_comm, &nproc);
+
+        // -- nothing recorded (TD1_PERF off, no counters): counters not opened
+        int numb_regions = 0;
+        {
+            std::lock_guard<std::mutex> lock(g_regions_mutex);
+            numb_regions = (int) g_regions.size();
+        }
+        MPI_Allreduce(MPI_IN_PLACE, &numb_regions, 1, MPI_INT, MPI_SUM, mpi_comm);
+        if (numb_regions == 0) {
+            return 0;
+        }
+
+        bool available[event::c_NUMB_EVENTS];
+        Available(available);
+
+        // -- lines of the processor
+        std::string text;
+        {
+            std::lock_guard<std::mutex> lock(g_regions_mutex);
+            char line[512];
+            std::map<std::string, Region>::const_iterator it;
+            for (it = g_regions.begin(); it != g_regions.end(); ++it) {
+                const Region &r = it->second;
+                const unsigned long long *v = r.values;
+                // -- events of a region whose group never ran are unavailable
+                bool counted[event::c_NUMB_EVENTS];
+                for (int e = 0; e < event::c_NUMB_EVENTS; e++) {
+                    counted[e] = available[e] && r.calls_counted > 0;
+                }
+                char cycles[32] = "-";
+                char ipc[32] = "-";
+                char fp[32] = "-";
+                if (counted[event::c_CYCLES]) {
+                    snprintf(cycles, sizeof(cycles), "%.4e", (double) v[event::c_CYCLES]);
+                }
+                if (counted[event::c_CYCLES] && counted[event::c_INSTRUCTIONS]) {
+                    snprintf(ipc, sizeof(ipc), "%.2f", (double) v[event::c_INSTRUCTIONS] /
+                             std::max((double) v[event::c_CYCLES], 1.));
+                }
+                if (counted[event::c_FP_OPS]) {
+                    snprintf(fp, sizeof(fp), "%.4e", (double) v[event::c_FP_OPS]);
+                }
+                // -- bytes from memory: LLC misses, or the model ('*')
+                bool is_model = !counted[event::c_LLC_MISSES];
+                double bytes = is_model ? r.bytes : 64. * v[event::c_LLC_MISSES];
+                double flops = counted[event::c_FP_OPS] ? (double) v[event::c_FP_OPS] : r.flops;
+                snprintf(line, sizeof(line),
+                         "%5d %-32s %8lld %12.6f %12s %6s %12.4e %12s %12.4e %9.3f%s %9.3f%s\n",
+                         rank, it->first.c_str(), r.calls, r.time, cycles, ipc, r.flops, fp,
+                         bytes, (flops > 0.) ? bytes / flops : 0., is_model ? "*" : " ",
+                         (r.time > 0.) ? bytes / r.time * 1.e-9 : 0., is_model ? "*" : " ");
+                text += line;
+            }
+            g_regions.clear();
+        }
+
+        // -- lines of all processors on processor 0
+        int size = (int) text.size();
+        std::vector<int> sizes(nproc);
+        std::vector<int> shifts(nproc);
+        MPI_Gather(&size, 1, MPI_INT, sizes.data(), 1, MPI_INT, 0, mpi_comm);
+        int total_size = 0;
+        for (int r = 0; r < nproc; r++) {
+            shifts[r] = total_size;
+            total_size += sizes[r];
+        }
+        std::vector<char> all_text((rank == 0) ? total_size + 1 : 1);
+        MPI_Gatherv(text.data(), size, MPI_CHAR, all_text.data(), sizes.data(),
+                    shifts.data(), MPI_CHAR, 0, mpi_comm);
+
+        if (rank == 0) {
+            fprintf(stream, "-- perf counters (cycles: %s, instructions: %s, LLC misses: %s, "
+                            "fp ops: %s)\n",
+                    available[event::c_CYCLES] ? "yes" : "no",
+                    available[event::c_INSTRUCTIONS] ? "yes" : "no",
+                    available[event::c_LLC_MISSES] ? "yes" : "no",
+                    available[event::c_FP_OPS] ? "yes" : "no");
+            fprintf(stream, "%5s %-32s %8s %12s %12s %6s %12s %12s %12s %10s %10s\n",
+                    "rank", "region", "calls", "time (s)", "cycles", "IPC", "flops",
+                    "fp ops", "bytes", "B/flop", "GB/s");
+            fwrite(all_text.data(), 1, total_size, stream);
+            fprintf(stream, "(*: model of the kernel, LLC misses not counted)\n");
+            fflush(stream);
+        }
+
+        return 0;
+    }
+
+    ________________________________________________________________________________
+
+} // namespace PerfCounter {
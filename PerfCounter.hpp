@@ -0,0 +1,123 @@
+/*!
+*  @file PerfCounter.hpp
+*  @brief header of PerfCounter (hardware counters around the kernels)
+*  @author Abal-Kassim Cheik Ahamed, Frédéric Magoulès, Sonia Toubaline
+*  @date Tue Nov 24 16:16:48 CET 2015
+*  @version 1.0
+*  @remarks regions are compiled only with TD1_PERF (cmake -DTD1_PERF=ON),
+*           PERF_SCOPE expands to nothing otherwise; the counters are read
+*           with perf_event_open on Linux only; without counters (other
+*           systems, perf_event_open refused) the regions do nothing
+*/
+
+#ifndef GUARD_PERFCOUNTER_HPP_
+#define GUARD_PERFCOUNTER_HPP_
+
+// basic packages
+#include <stdio.h>
+#include <mpi.h>
+
+// project packages
+#include "dllmrg.hpp"
+
+// third-party packages
+
+
+//! @namespace PerfCounter
+namespace PerfCounter {
+
+//! @struct event
+//! @brief counted events
+struct event {
+  enum event_enum {
+    //! cpu cycles (user space)
+    c_CYCLES = 0,
+    //! instructions retired
+    c_INSTRUCTIONS = 1,
+    //! last level cache read misses (64 bytes from memory each)
+    c_LLC_MISSES = 2,
+    //! floating point operations: raw event $TD1_PERF_FP_EVENT (hexadecimal,
+    //  model specific), not counted otherwise
+    c_FP_OPS = 3,
+    //! number of events
+    c_NUMB_EVENTS = 4
+  }  ; // enum event_enum {
+
+} ; // struct event {
+
+//! record the regions (runtime switch, default: true)
+extern bool g_enabled;
+
+//! @brief counters of the calling thread, opened on first use
+//! @param [in,out] available = available[e] is true if event e is counted
+//! @return number of events counted (0: counters unavailable)
+int Available (
+        bool available[event::c_NUMB_EVENTS] ) ;
+
+//! @class Scope
+//! @brief region counted from its construction to its destruction
+class Scope {
+
+ public:
+
+  //! @brief constructor: read the counters
+  //! @param [in] name = name of the region (string literal, kept by address)
+  //! @param [in] flops = floating point operations of the region (model)
+  //! @param [in] bytes = bytes read and written by the region (model)
+  Scope (
+        const char* name,
+        double flops,
+        double bytes ) ;
+
+  //! @brief destructor: read the counters, add the differences to the region
+  ~Scope ( ) ;
+
+ private:
+
+  //! name of the region
+  const char* m_name;
+  //! floating point operations (model)
+  double m_flops;
+  //! bytes (model)
+  double m_bytes;
+  //! time at the construction
+  double m_time;
+  //! counters at the construction
+  unsigned long long m_values[event::c_NUMB_EVENTS];
+  //! times the group was enabled and running at the construction
+  unsigned long long m_times[2];
+  //! counters read
+  bool m_active;
+
+} ; // class Scope {
+
+//! @brief print the regions of each processor, with derived metrics
+//! @param [in] mpi_comm = MPI communicator
+//! @param [in] stream = stream of processor 0 (default: stdout)
+//! @remarks collective; per processor and region: calls, time, cycles,
+//           instructions per cycle, floating point operations, bytes from
+//           memory (LLC misses x 64), bytes per flop and bandwidth; counts
+//           of a multiplexed group are scaled by time enabled / time running,
+//           a region whose group never ran shows them unavailable ('-');
+//           prints nothing if no region was counted; the regions are cleared
+//! @return error code
+int Report (
+        MPI_Comm& mpi_comm,
+        FILE* stream = stdout ) ;
+
+} // namespace PerfCounter {
+
+
+#define PERF_CONCAT_( a, b ) a##b
+#define PERF_CONCAT( a, b ) PERF_CONCAT_( a, b )
+
+#ifdef TD1_PERF
+//! region counted until the end of the enclosing block
+#define PERF_SCOPE( name, flops, bytes ) \
+  PerfCounter::Scope PERF_CONCAT( perf_scope_, __LINE__ )( name, flops, bytes )
+#else
+#define PERF_SCOPE( name, flops, bytes )
+#endif
+
+
+#endif // GUARD_PERFCOUNTER_HPP_
@@ -0,0 +1,374 @@
+/*!
+*  @file Roofline.cpp
+*  @internal source of Roofline (peaks of the host, bounds of the operations)
+*  @author Abal-Kassim Cheik Ahamed, Frédéric Magoulès, Sonia Toubaline
+*  @date Tue Nov 24 16:16:48 CET 2015
+*  @version 1.0
+*  @remarks
+*/
+
+// basic packages
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <algorithm>
+
+// project packages
+#include "Roofline.hpp"
+#include "Vector.hpp"
+#include "Memory.hpp"
+
+// third-party packages
+
+
+//! @namespace Roofline
+namespace Roofline {
+
+//! @internal results of the multiply-adds, kept from the optimizer
+    volatile double g_sink = 0.;
+
+    ________________________________________________________________________________
+
+//! @internal floating point operations and bytes of a kernel
+    int Counts(
+            double &flops,
+            double &bytes,
+            int kernel_type,
+            int size) {
+
+        double n = size;
+        flops = 0.;
+        bytes = 0.;
+        if (kernel_type == kernel::c_COPY) {
+            bytes = sizeof(double) * 2. * n * n;
+        } else if (kernel_type == kernel::c_GEMV) {
+            flops = 2. * n * n;
+            bytes = sizeof(double) * (n * n + 2. * n);
+        } else if (kernel_type == kernel::c_GEMM) {
+            flops = 2. * n * n * n;
+            bytes = sizeof(double) * 3. * n * n;
+        } else if (kernel_type == kernel::c_DISTRIBUTE || kernel_type == kernel::c_ASSEMBLE) {
+            bytes = sizeof(double) * n * n;
+        } else {
+            return 1;
+        }
+
+        return 0;
+    }
+
+    ________________________________________________________________________________
+
+//! @internal shortest time allowed by the peaks
+    double Time(
+            const Machine &machine,
+            int kernel_type,
+            double flops,
+            double bytes,
+            int numb_procs) {
+
+        // -- root reads (or writes) every element, the others wait for it
+        if (kernel_type == kernel::c_DISTRIBUTE || kernel_type == kernel::c_ASSEMBLE) {
+            numb_procs = 1;
+        }
+        // -- processors running at once (fewer if they share cores)
+        double concurrency = (machine.flops > 0.) ? machine.flops_host / machine.flops : 1.;
+        double procs = std::min((double) numb_procs, std::max(concurrency, 1.));
+
+        // -- level of the working set of a processor
+        double working_set = bytes / numb_procs;
+        int level = 0;
+        while (level + 1 < machine.numb_levels && machine.level_bytes[level] < working_set) {
+            level++;
+        }
+        double bandwidth = procs * machine.bandwidth[level];
+        if (level == machine.numb_levels - 1) {
+            bandwidth = std::min(bandwidth, machine.bandwidth_host);
+        }
+
+        double time_flops = (machine.flops > 0.) ? flops / (procs * machine.flops) : 0.;
+        double time_bytes = (bandwidth > 0.) ? bytes / bandwidth : 0.;
+
+        return std::max(time_flops, time_bytes);
+    }
+
+    ________________________________________________________________________________
+
+//! @internal percent of the roofline reached in a time
+    double Percent(
+            const Machine &machine,
+            int kernel_type,
+            double flops,
+            double bytes,
+            int numb_procs,
+            double time) {
+
+        if (time <= 0.) {
+            return 0.;
+        }
+
+        return 100. * Time(machine, kernel_type, flops, bytes, numb_procs) / time;
+    }
+
+    ________________________________________________________________________________
+
+//! @internal best (or mean) time of a triad a := b + s c on the first n elements
+    double Triad(
+            Vector<double, int> &a,
+            const Vector<double, int> &b,
+            const Vector<double, int> &c,
+            int n,
+            int numb_runs,
+            const bool opt_mean) {
+
+        double *pa = a.GetCoef();
+        const double *pb = b.GetCoef();
+        const double *pc = c.GetCoef();
+        const double s = 3.;
+        // -- small working sets: repeated up to about 2^20 elements per run
+        const int numb_repeats = std::max((1 << 20) / n, 1);
+        double time_best = -1.;
+        double time_sum = 0.;
+        for (int r = 0; r < numb_runs; r++) {
+            double t0 = MPI_Wtime();
+            for (int k = 0; k < numb_repeats; k++) {
+                for (int i = 0; i < n; i++) {
+                    pa[i] = pb[i] + s * pc[i];
+                }
+            }
+            double time = (MPI_Wtime() - t0) / numb_repeats;
+            time_sum += time;
+            if (time_best < 0. || time < time_best) {
+                time_best = time;
+            }
+        }
+
+        return opt_mean ? time_sum / numb_runs : time_best;
+    }
+
+    ________________________________________________________________________________
+
+//! @internal best (or mean) time of numb_iters x 32 independent multiply-adds
+//            (enough chains to hide the latency of vector multiply-adds)
+    double MultiplyAdd(
+            int numb_iters,
+            int numb_runs,
+            const bool opt_mean) {
+
+        const double m = 0.999999;
+        const double c = 1.e-6;
+        double time_best = -1.;
+        double time_sum = 0.;
+        for (int r = 0; r < numb_runs; r++) {
+            double acc[32];
+            for (int k = 0; k < 32; k++) {
+                acc[k] = 1. + k;
+            }
+            double t0 = MPI_Wtime();
+            for (int it = 0; it < numb_iters; it++) {
+                for (int k = 0; k < 32; k++) {
+                    acc[k] = acc[k] * m + c;
+                }
+            }
+            double time = MPI_Wtime() - t0;
+            for (int k = 0; k < 32; k++) {
+                g_sink = g_sink + acc[k];
+            }
+            time_sum += time;
+            if (time_best < 0. || time < time_best) {
+                time_best = time;
+            }
+        }
+
+        return opt_mean ? time_sum / numb_runs : time_best;
+    }
+
+    ________________________________________________________________________________
+
+//! @internal measure the peaks: processor 0 alone, then all processors at once
+    int Probe(
+            Machine &machine,
+            MPI_Comm &mpi_comm,
+            int numb_elements) {
+        MEMORY_TAG("Roofline::Probe");
+
+        int rank, nproc;
+        MPI_Comm_rank(mpi_comm, &rank);
+        MPI_Comm_size(mpi_comm, &nproc);
+        const int numb_runs = 5;
+
+        // -- three arrays, first touch before the timed runs
+        Vector<double, int> a(numb_elements);
+        Vector<double, int> b(numb_elements);
+        Vector<double, int> c(numb_elements);
+        for (int i = 0; i < numb_elements; i++) {
+            a(i) = 0.;
+            b(i) = 1.;
+            c(i) = 2.;
+        }
+
+        // -- processor 0 alone, the others wait: working sets divided by 8
+        //    down to 1024 elements, then 32 chains of multiply-adds
+        memset(&machine, 0, sizeof(machine));
+        if (rank == 0) {
+            int levels[c_MAX_LEVELS];
+            int numb_levels = 0;
+            for (int n = numb_elements; n >= 1024 && numb_levels < c_MAX_LEVELS; n /= 8) {
+                levels[numb_levels++] = n;
+            }
+            for (int k = 0; k < numb_levels; k++) {
+                int n = levels[numb_levels - 1 - k];
+                double time = Triad(a, b, c, n, numb_runs, false);
+                machine.level_bytes[k] = 3. * sizeof(double) * n;
+                machine.bandwidth[k] = (time > 0.) ? machine.level_bytes[k] / time : 0.;
+            }
+            machine.numb_levels = numb_levels;
+            double time = MultiplyAdd(numb_elements / 4, numb_runs, false);
+            machine.flops = (time > 0.) ? 2. * 32. * (numb_elements / 4) / time : 0.;
+        }
+        MPI_Bcast(&machine, sizeof(machine), MPI_BYTE, 0, mpi_comm);
+        machine.numb_procs = nproc;
+
+        // -- all processors at once: largest working set, multiply-adds; mean
+        //    time, processors sharing a core interleave their runs
+        MPI_Barrier(mpi_comm);
+        double time = Triad(a, b, c, numb_elements, numb_runs, true);
+        double rates[2];
+        rates[0] = (time > 0.) ? 3. * sizeof(double) * numb_elements / time : 0.;
+        MPI_Barrier(mpi_comm);
+        time = MultiplyAdd(numb_elements / 4, numb_runs, true);
+        rates[1] = (time > 0.) ? 2. * 32. * (numb_elements / 4) / time : 0.;
+        MPI_Allreduce(MPI_IN_PLACE, rates, 2, MPI_DOUBLE, MPI_SUM, mpi_comm);
+        machine.bandwidth_host = rates[0];
+        machine.flops_host = rates[1];
+
+        return 0;
+    }
+
+    ________________________________________________________________________________
+
+//! @internal cache file of the host
+    int CacheFileName(
+            std::string &file_name) {
+
+        const char *name = getenv("TD1_ROOFLINE_FILE");
+        if (name != NULL) {
+            file_name = name;
+            return 0;
+        }
+
+        const char *dir = getenv("TD1_TUNE_DIR");
+        if (dir == NULL) {
+            dir = getenv("HOME");
+        }
+        char host_name[256] = "localhost";
+        gethostname(host_name, sizeof(host_name) - 1);
+        file_name = std::string((dir != NULL) ? dir : ".") + "/.td1_roofline_" + host_name;
+
+        return 0;
+    }
+
+    ________________________________________________________________________________
+
+//! @internal read the peaks from a cache file
+    int Load(
+            Machine &machine,
+            const char *file_name) {
+
+        FILE *file = fopen(file_name, "r");
+        if (file == NULL) {
+            return 1;
+        }
+        memset(&machine, 0, sizeof(machine));
+        int numb_found = 0;
+        char line[256];
+        while (fgets(line, sizeof(line), file) != NULL) {
+            if (strncmp(line, "numb_procs=", 11) == 0) {
+                machine.numb_procs = atoi(line + 11);
+                numb_found++;
+            } else if (strncmp(line, "flops=", 6) == 0) {
+                machine.flops = atof(line + 6);
+                numb_found++;
+            } else if (strncmp(line, "flops_host=", 11) == 0) {
+                machine.flops_host = atof(line + 11);
+                numb_found++;
+            } else if (strncmp(line, "bandwidth_host=", 15) == 0) {
+                machine.bandwidth_host = atof(line + 15);
+                numb_found++;
+            } else if (strncmp(line, "level=", 6) == 0 && machine.numb_levels < c_MAX_LEVELS) {
+                int k = machine.numb_levels;
+                if (sscanf(line + 6, "%lf,%lf", &machine.level_bytes[k],
+                           &machine.bandwidth[k]) == 2) {
+                    machine.numb_levels++;
+                }
+            }
+        }
+        fclose(file);
+
+        return (numb_found == 4 && machine.numb_levels > 0) ? 0 : 1;
+    }
+
+    ________________________________________________________________________________
+
+//! @internal write the peaks into a cache file
+    int Save(
+            const Machine &machine,
+            const char *file_name) {
+
+        FILE *file = fopen(file_name, "w");
+        if (file == NULL) {
+            return 1;
+        }
+        char host_name[256] = "localhost";
+        gethostname(host_name, sizeof(host_name) - 1);
+        fprintf(file, "# td1 roofline, host %s (flop/s, bytes/s; level=working set,bandwidth)\n",
+                host_name);
+        fprintf(file, "numb_procs=%d\n", machine.numb_procs);
+        fprintf(file, "flops=%.6e\n", machine.flops);
+        fprintf(file, "flops_host=%.6e\n", machine.flops_host);
+        fprintf(file, "bandwidth_host=%.6e\n", machine.bandwidth_host);
+        for (int k = 0; k < machine.numb_levels; k++) {
+            fprintf(file, "level=%.0f,%.6e\n", machine.level_bytes[k], machine.bandwidth[k]);
+        }
+        fclose(file);
+
+        return 0;
+    }
+
+    ________________________________________________________________________________
+
+//! @internal peaks of the host: cache file of processor 0, probe otherwise
+    int Get(
+            Machine &machine,
+            MPI_Comm &mpi_comm,
+            const bool opt_probe) {
+
+        int rank, nproc;
+        MPI_Comm_rank(mpi_comm, &rank);
+        MPI_Comm_size(mpi_comm, &nproc);
+
+        std::string file_name;
+        CacheFileName(file_name);
+        int is_cached = 0;
+        if (rank == 0 && !opt_probe) {
+            is_cached = (Load(machine, file_name.c_str()) == 0 && machine.numb_procs == nproc);
+        }
+        MPI_Bcast(&is_cached, 1, MPI_INT, 0, mpi_comm);
+        if (is_cached) {
+            MPI_Bcast(&machine, sizeof(machine), MPI_BYTE, 0, mpi_comm);
+            return 0;
+        }
+
+        Probe(machine, mpi_comm);
+        int error = 0;
+        if (rank == 0) {
+            error = Save(machine, file_name.c_str());
+        }
+        MPI_Bcast(&error, 1, MPI_INT, 0, mpi_comm);
+
+        return error;
+    }
+
+    ________________________________________________________________________________
+
+} // namespace Roofline {
@@ -0,0 +1,172 @@
+/*!
+*  @file Roofline.hpp
+*  @brief header of Roofline (peaks of the host, bounds of the operations)
+*  @author Abal-Kassim Cheik Ahamed, Frédéric Magoulès, Sonia Toubaline
+*  @date Tue Nov 24 16:16:48 CET 2015
+*  @version 1.0
+*  @remarks the peaks are measured once per host and number of processors,
+*           then read from the cache file of the host; the probe is compiled
+*           with -O3 whatever the build type (and -march=native with
+*           TD1_NATIVE), so kernels built without optimization stay far below
+*           the roof; the bandwidth roof follows the working set of each
+*           processor (caches, then memory)
+*/
+
+#ifndef GUARD_ROOFLINE_HPP_
+#define GUARD_ROOFLINE_HPP_
+
+// basic packages
+#include <string>
+#include <mpi.h>
+
+// project packages
+#include "dllmrg.hpp"
+
+// third-party packages
+
+
+//! @namespace Roofline
+namespace Roofline {
+
+//! @struct kernel
+//! @brief operations with an analytic count (square matrices of size n)
+struct kernel {
+  enum kernel_enum {
+    //! y := x on n x n elements (BLAS-1, Vector::operator=)
+    c_COPY = 0,
+    //! y := A x (BLAS-2)
+    c_GEMV = 1,
+    //! C := A B (BLAS-3)
+    c_GEMM = 2,
+    //! matrix from root to the processors
+    c_DISTRIBUTE = 3,
+    //! matrix from the processors to root
+    c_ASSEMBLE = 4,
+    //! number of kernels
+    c_NUMB_KERNELS = 5
+  }  ; // enum kernel_enum {
+
+} ; // struct kernel {
+
+//! maximum number of working sets of the bandwidth probe
+const int c_MAX_LEVELS = 8;
+
+//! @struct Machine
+//! @brief peaks of one processor alone, and of all processors at once
+struct Machine {
+  //! number of working sets probed (smallest first)
+  int numb_levels;
+  //! working set of each level (bytes of the three arrays of the triad)
+  double level_bytes[c_MAX_LEVELS];
+  //! bandwidth of each level, one processor alone (bytes/s, triad)
+  double bandwidth[c_MAX_LEVELS];
+  //! bandwidth of the largest level, sum over all processors at once
+  double bandwidth_host;
+  //! floating point rate, one processor alone (flop/s, multiply-adds)
+  double flops;
+  //! floating point rate, sum over all processors at once
+  double flops_host;
+  //! number of processors during the probe
+  int numb_procs;
+} ; // struct Machine {
+
+//! @brief floating point operations and bytes of a kernel
+//! @param [in,out] flops = floating point operations
+//! @param [in,out] bytes = bytes read and written by the kernels, moved by
+//           distribute and assemble (each element once)
+//! @param [in] kernel_type = kernel (see kernel)
+//! @param [in] size = size of the matrices (size x size)
+//! @return error code (1: unknown kernel)
+int Counts (
+        double& flops,
+        double& bytes,
+        int kernel_type,
+        int size ) ;
+
+//! @brief shortest time allowed by the peaks
+//! @param [in] machine = peaks
+//! @param [in] kernel_type = kernel (see kernel)
+//! @param [in] flops = floating point operations
+//! @param [in] bytes = bytes
+//! @param [in] numb_procs = number of processors sharing the work
+//! @remarks max(flops / flop rate, bytes / bandwidth) with the rates of
+//           min(numb_procs, flops_host / flops) processors (processors
+//           sharing a core do not add up) and the bandwidth of the level of
+//           bytes / numb_procs, capped by bandwidth_host for the largest;
+//           distribute and assemble go through root, whatever the number of
+//           processors
+//! @return time (s)
+double Time (
+        const Machine& machine,
+        int kernel_type,
+        double flops,
+        double bytes,
+        int numb_procs ) ;
+
+//! @brief percent of the roofline reached in a time
+//! @param [in] machine = peaks
+//! @param [in] kernel_type = kernel (see kernel)
+//! @param [in] flops = floating point operations
+//! @param [in] bytes = bytes
+//! @param [in] numb_procs = number of processors sharing the work
+//! @param [in] time = time measured (s)
+//! @return 100 x Time( ) / time
+double Percent (
+        const Machine& machine,
+        int kernel_type,
+        double flops,
+        double bytes,
+        int numb_procs,
+        double time ) ;
+
+//! @brief measure the peaks: processor 0 alone, then all processors at once
+//! @param [in,out] machine = peaks
+//! @param [in] mpi_comm = MPI communicator
+//! @param [in] numb_elements = elements of each array of the largest triad
+//! @remarks collective; the largest arrays must be much larger than the
+//           caches, the smaller working sets are 1/8, 1/64, ... of it
+//! @return error code
+int Probe (
+        Machine& machine,
+        MPI_Comm& mpi_comm,
+        int numb_elements = 1 << 22 ) ;
+
+//! @brief cache file of the host
+//! @param [in,out] file_name = $TD1_ROOFLINE_FILE, or
+//           ${TD1_TUNE_DIR:-$HOME}/.td1_roofline_<host name>
+//! @return error code
+int CacheFileName (
+        std::string& file_name ) ;
+
+//! @brief read the peaks from a cache file
+//! @param [in,out] machine = peaks
+//! @param [in] file_name = cache file
+//! @return error code (1: no file or incomplete)
+int Load (
+        Machine& machine,
+        const char* file_name ) ;
+
+//! @brief write the peaks into a cache file
+//! @param [in] machine = peaks
+//! @param [in] file_name = cache file
+//! @return error code
+int Save (
+        const Machine& machine,
+        const char* file_name ) ;
+
+//! @brief peaks of the host: cache file of processor 0, probe otherwise
+//! @param [in,out] machine = peaks
+//! @param [in] mpi_comm = MPI communicator
+//! @param [in] opt_probe = probe even if the cache file exists
+//! @remarks collective; the cache is used only if it was measured with the
+//           same number of processors; a probe rewrites it
+//! @return error code
+int Get (
+        Machine& machine,
+        MPI_Comm& mpi_comm,
+        const bool opt_probe = false ) ;
+
+} // namespace Roofline {
+
+
+#endif // GUARD_ROOFLINE_HPP_
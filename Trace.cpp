@@ -0,0 +1,317 @@
+/*!
+*  @file Trace.cpp
+*  @internal source of Trace (timed regions of the library)
+*  @author Abal-Kassim Cheik Ahamed, Frédéric Magoulès, Sonia Toubaline
+*  @date Tue Nov 24 16:16:48 CET 2015
+*  @version 1.0
+*  @remarks
+*/
+
+// basic packages
+#include <stdio.h>
+#include <string.h>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+// project packages
+#include "Trace.hpp"
+
+// third-party packages
+
+
+//! @namespace Trace
+namespace Trace {
+
+    ________________________________________________________________________________
+
+//! @internal closed (or open) region of the processor
+    struct Event {
+        //! name (string literal)
+        const char *name;
+        //! index of the enclosing event (-1: none)
+        int parent;
+        //! begin (s, from the origin)
+        double t_begin;
+        //! end (s, from the origin)
+        double t_end;
+    };
+
+//! @internal statistics of a region on the processor
+    struct Stat {
+        //! number of calls
+        int numb_calls;
+        //! time spent (s)
+        double time;
+    };
+
+    bool g_enabled = true;
+
+//! @internal events in order of opening
+    std::vector<Event> g_events;
+
+//! @internal event currently open (-1: none)
+    int g_event_open = -1;
+
+//! @internal origin of the timestamps (MPI_Wtime, s)
+    double g_origin = -1.;
+
+    ________________________________________________________________________________
+
+//! @internal reset the regions and the origin of the timestamps
+    int Initialize(
+            MPI_Comm &mpi_comm) {
+
+        g_events.clear();
+        g_event_open = -1;
+        MPI_Barrier(mpi_comm);
+        g_origin = MPI_Wtime();
+
+        return 0;
+    }
+
+    ________________________________________________________________________________
+
+//! @internal open a region
+    int Begin(
+            const char *name) {
+
+        if (!g_enabled) {
+            return 0;
+        }
+        double t = MPI_Wtime();
+        if (g_origin < 0.) {
+            g_origin = t;
+        }
+
+        Event event;
+        event.name = name;
+        event.parent = g_event_open;
+        event.t_begin = t - g_origin;
+        event.t_end = -1.;
+        g_events.push_back(event);
+        g_event_open = (int) g_events.size() - 1;
+
+        return 0;
+    }
+
+    ________________________________________________________________________________
+
+//! @internal close the region opened last
+    int End() {
+
+        if (!g_enabled || g_event_open < 0) {
+            return 0;
+        }
+
+        Event &event = g_events[g_event_open];
+        event.t_end = MPI_Wtime() - g_origin;
+        g_event_open = event.parent;
+
+        return 0;
+    }
+
+    ________________________________________________________________________________
+
+//! @internal path of an event: names of the enclosing regions, separated by '/'
+    std::string EventPath(
+            int idx) {
+
+        std::string path = g_events[idx].name;
+        for (int p = g_events[idx].parent; p >= 0; p = g_events[p].parent) {
+            path = std::string(g_events[p].name) + "/" + path;
+        }
+
+        return path;
+    }
+
+    ________________________________________________________________________________
+
+//! @internal gather strings of all processors on root
+    int GatherText(
+            std::string &text_all,
+            const std::string &text,
+            int root,
+            MPI_Comm &mpi_comm) {
+
+        int rank, nproc;
+        MPI_Comm_rank(mpi_comm, &rank);
+        MPI_Comm_size(mpi_comm, &nproc);
+
+        int size = (int) text.size();
+        int sizes[nproc];
+        int shifts[nproc];
+        MPI_Gather(&size, 1, MPI_INT, sizes, 1, MPI_INT, root, mpi_comm);
+
+        int total_size = 0;
+        if (rank == root) {
+            for (int p = 0; p < nproc; p++) {
+                shifts[p] = total_size;
+                total_size += sizes[p];
+            }
+        }
+        text_all.assign(total_size, '\0');
+        MPI_Gatherv(text.data(), size, MPI_CHAR, &text_all[0], sizes, shifts,
+                    MPI_CHAR, root, mpi_comm);
+
+        return 0;
+    }
+
+    ________________________________________________________________________________
+
+//! @internal write the Chrome trace (JSON) of all processors
+    int WriteChromeTrace(
+            const char *file_name,
+            int root,
+            MPI_Comm &mpi_comm) {
+
+        int rank;
+        MPI_Comm_rank(mpi_comm, &rank);
+
+        // -- one complete event ("ph":"X") per region, pid = processor
+        std::string text;
+        char line[512];
+        for (size_t k = 0; k < g_events.size(); k++) {
+            const Event &event = g_events[k];
+            if (event.t_end < 0.) {
+                continue;
+            }
+            snprintf(line, sizeof(line),
+                     ",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":%d,\"tid\":0,"
+                     "\"ts\":%.3f,\"dur\":%.3f}",
+                     event.name, rank, event.t_begin * 1.e6,
+                     (event.t_end - event.t_begin) * 1.e6);
+            text += line;
+        }
+
+        std::string text_all;
+        GatherText(text_all, text, root, mpi_comm);
+
+        int error = 0;
+        if (rank == root) {
+            FILE *file = fopen(file_name, "w");
+            if (file == NULL) {
+                error = 1;
+            } else {
+                fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+                fprintf(file, "{\"name\":\"process_sort_index\",\"ph\":\"M\",\"pid\":0,"
+                              "\"args\":{\"sort_index\":0}}");
+                fwrite(text_all.data(), 1, text_all.size(), file);
+                fprintf(file, "\n]}\n");
+                error = (fclose(file) != 0);
+            }
+        }
+        MPI_Bcast(&error, 1, MPI_INT, root, mpi_comm);
+
+        return error;
+    }
+
+    ________________________________________________________________________________
+
+//! @internal aggregate the regions over the processors and print them
+    int Finalize(
+            MPI_Comm &mpi_comm,
+            const char *file_name) {
+
+        int rank, nproc;
+        MPI_Comm_rank(mpi_comm, &rank);
+        MPI_Comm_size(mpi_comm, &nproc);
+        const int root = 0;
+
+        // -- local statistics by path
+        std::map<std::string, Stat> stats;
+        for (size_t k = 0; k < g_events.size(); k++) {
+            if (g_events[k].t_end < 0.) {
+                continue;
+            }
+            Stat &stat = stats[EventPath((int) k)];
+            stat.numb_calls++;
+            stat.time += g_events[k].t_end - g_events[k].t_begin;
+        }
+
+        // -- paths of all processors (a processor may skip a region)
+        std::string text;
+        std::map<std::string, Stat>::iterator it;
+        for (it = stats.begin(); it != stats.end(); ++it) {
+            text += it->first + "\n";
+        }
+        std::string text_all;
+        GatherText(text_all, text, root, mpi_comm);
+        std::set<std::string> path_set;
+        size_t pos = 0;
+        while (pos < text_all.size()) {
+            size_t end = text_all.find('\n', pos);
+            path_set.insert(text_all.substr(pos, end - pos));
+            pos = end + 1;
+        }
+        text.clear();
+        std::set<std::string>::iterator it_path;
+        for (it_path = path_set.begin(); it_path != path_set.end(); ++it_path) {
+            text += *it_path + "\n";
+        }
+        int size = (int) text.size();
+        MPI_Bcast(&size, 1, MPI_INT, root, mpi_comm);
+        text.resize(size);
+        MPI_Bcast(&text[0], size, MPI_CHAR, root, mpi_comm);
+
+        std::vector<std::string> paths;
+        pos = 0;
+        while (pos < text.size()) {
+            size_t end = text.find('\n', pos);
+            paths.push_back(text.substr(pos, end - pos));
+            pos = end + 1;
+        }
+        int numb_paths = (int) paths.size();
+
+        // -- min, max and sum over the processors
+        std::vector<double> times(numb_paths, 0.);
+        std::vector<int> numb_calls(numb_paths, 0);
+        for (int k = 0; k < numb_paths; k++) {
+            it = stats.find(paths[k]);
+            if (it != stats.end()) {
+                times[k] = it->second.time;
+                numb_calls[k] = it->second.numb_calls;
+            }
+        }
+        std::vector<double> times_min(numb_paths), times_max(numb_paths), times_sum(numb_paths);
+        std::vector<int> numb_calls_sum(numb_paths);
+        MPI_Reduce(times.data(), times_min.data(), numb_paths, MPI_DOUBLE, MPI_MIN, root, mpi_comm);
+        MPI_Reduce(times.data(), times_max.data(), numb_paths, MPI_DOUBLE, MPI_MAX, root, mpi_comm);
+        MPI_Reduce(times.data(), times_sum.data(), numb_paths, MPI_DOUBLE, MPI_SUM, root, mpi_comm);
+        MPI_Reduce(numb_calls.data(), numb_calls_sum.data(), numb_paths, MPI_INT, MPI_SUM,
+                   root, mpi_comm);
+
+        if (rank == root && numb_paths > 0) {
+            iomrg::printf("-- trace [numb_procs: %d]\n", nproc);
+            iomrg::printf("%-48s %8s %12s %12s %12s\n", "region", "calls",
+                          "min (s)", "mean (s)", "max (s)");
+            for (int k = 0; k < numb_paths; k++) {
+                // -- nested regions are indented under their parent
+                int depth = 0;
+                size_t slash = paths[k].find_last_of('/');
+                for (size_t c = 0; c < paths[k].size(); c++) {
+                    depth += (paths[k][c] == '/');
+                }
+                std::string name = std::string(2 * depth, ' ')
+                                   + paths[k].substr((slash == std::string::npos) ? 0 : slash + 1);
+                iomrg::printf("%-48s %8d %12.6f %12.6f %12.6f\n", name.c_str(),
+                              numb_calls_sum[k], times_min[k], times_sum[k] / nproc,
+                              times_max[k]);
+            }
+        }
+
+        int error = 0;
+        if (file_name != NULL) {
+            error = WriteChromeTrace(file_name, root, mpi_comm);
+        }
+
+        g_events.clear();
+        g_event_open = -1;
+
+        return error;
+    }
+
+    ________________________________________________________________________________
+
+} // namespace Trace {
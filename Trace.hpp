@@ -0,0 +1,96 @@
+/*!
+*  @file Trace.hpp
+*  @brief header of Trace (timed regions of the library)
+*  @author Abal-Kassim Cheik Ahamed, Frédéric Magoulès, Sonia Toubaline
+*  @date Tue Nov 24 16:16:48 CET 2015
+*  @version 1.0
+*  @remarks regions are compiled only with TD1_TRACE (cmake -DTD1_TRACE=ON),
+*           TRACE_SCOPE, TRACE_BEGIN and TRACE_END expand to nothing otherwise
+*/
+
+#ifndef GUARD_TRACE_HPP_
+#define GUARD_TRACE_HPP_
+
+// basic packages
+#include <mpi.h>
+
+// project packages
+#include "dllmrg.hpp"
+
+// third-party packages
+
+
+//! @namespace Trace
+namespace Trace {
+
+//! record the regions (runtime switch, default: true)
+extern bool g_enabled;
+
+//! @brief reset the regions and the origin of the timestamps
+//! @param [in] mpi_comm = MPI communicator (the origin follows a barrier)
+//! @return error code
+int Initialize (
+        MPI_Comm& mpi_comm ) ;
+
+//! @brief open a region, nested in the region currently open
+//! @param [in] name = name of the region (string literal, kept by address)
+//! @return error code
+int Begin (
+        const char* name ) ;
+
+//! @brief close the region opened last
+//! @return error code
+int End ( ) ;
+
+//! @brief aggregate the regions over the processors and print them
+//! @param [in] mpi_comm = MPI communicator
+//! @param [in] file_name = Chrome trace (JSON) of all processors, NULL: none
+//! @remarks collective; for each region (path of nested names): calls summed
+//           over the processors, min, mean and max of the time spent
+//           in the region; the recorded regions are cleared
+//! @return error code
+int Finalize (
+        MPI_Comm& mpi_comm,
+        const char* file_name = NULL ) ;
+
+//! @class Scope
+//! @brief region open from its construction to its destruction
+class Scope {
+
+ public:
+
+  //! @brief constructor: open the region
+  //! @param [in] name = name of the region (string literal)
+  explicit Scope (
+        const char* name ) {
+    Begin( name );
+  }
+
+  //! @brief destructor: close the region
+  ~Scope ( ) {
+    End( );
+  }
+
+} ; // class Scope {
+
+} // namespace Trace {
+
+
+#define TRACE_CONCAT_( a, b ) a##b
+#define TRACE_CONCAT( a, b ) TRACE_CONCAT_( a, b )
+
+#ifdef TD1_TRACE
+//! region open until the end of the enclosing block
+#define TRACE_SCOPE( name ) Trace::Scope TRACE_CONCAT( trace_scope_, __LINE__ )( name )
+//! open a region
+#define TRACE_BEGIN( name ) Trace::Begin( name )
+//! close the region opened last
+#define TRACE_END( ) Trace::End( )
+#else
+#define TRACE_SCOPE( name )
+#define TRACE_BEGIN( name )
+#define TRACE_END( )
+#endif
+
+
+#endif // GUARD_TRACE_HPP_
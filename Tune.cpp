@@ -0,0 +1,401 @@
+/*!
+*  @file Tune.cpp
+*  @internal source of Tune (parameters of the kernels and of the communications)
+*  @author Abal-Kassim Cheik Ahamed, Frédéric Magoulès, Sonia Toubaline
+*  @date Tue Nov 24 16:16:48 CET 2015
+*  @version 1.0
+*  @remarks
+*/
+
+// basic packages
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <algorithm>
+#include <functional>
+#include <vector>
+
+// project packages
+#include "Tune.hpp"
+#include "Vector.hpp"
+#include "MatrixDense.hpp"
+#include "DataTopology.hpp"
+#include "BlasMpi.hpp"
+
+// third-party packages
+
+
+//! @namespace Tune
+namespace Tune {
+
+    ________________________________________________________________________________
+
+//! @internal generation of the parameters in use, incremented by Set
+    int g_generation = 0;
+
+//! @internal parameters in use: cache file of the host, then $TD1_TUNE
+    Parameters &Current() {
+
+        static Parameters params = [] () {
+            Parameters loaded;
+            Default(loaded);
+            std::string file_name;
+            CacheFileName(file_name);
+            Load(loaded, file_name.c_str());
+            const char *text = getenv("TD1_TUNE");
+            if (text != NULL) {
+                Parse(loaded, text);
+            }
+            return loaded;
+        }();
+
+        return params;
+    }
+
+    ________________________________________________________________________________
+
+//! @internal parameters in use
+    const Parameters &Get() {
+
+        return Current();
+    }
+
+    ________________________________________________________________________________
+
+//! @internal replace the parameters in use
+    int Set(
+            const Parameters &params) {
+
+        Current() = params;
+        g_generation++;
+
+        return 0;
+    }
+
+    ________________________________________________________________________________
+
+//! @internal default parameters (untuned kernels)
+    int Default(
+            Parameters &params) {
+
+        params.mmp_tile = 0;
+        params.mvp_unroll = 1;
+        params.summa_panel = 0;
+        params.allgather_chunks = 1;
+
+        return 0;
+    }
+
+    ________________________________________________________________________________
+
+//! @internal cache file of the host
+    int CacheFileName(
+            std::string &file_name) {
+
+        const char *name = getenv("TD1_TUNE_FILE");
+        if (name != NULL) {
+            file_name = name;
+            return 0;
+        }
+
+        const char *dir = getenv("TD1_TUNE_DIR");
+        if (dir == NULL) {
+            dir = getenv("HOME");
+        }
+        char host_name[256] = "localhost";
+        gethostname(host_name, sizeof(host_name) - 1);
+        file_name = std::string((dir != NULL) ? dir : ".") + "/.td1_tune_" + host_name;
+
+        return 0;
+    }
+
+    ________________________________________________________________________________
+
+//! @internal read "name=value" pairs separated by commas or new lines
+    int Parse(
+            Parameters &params,
+            const char *text) {
+
+        const char *pos = text;
+        while (*pos != '\0') {
+            size_t length = strcspn(pos, ",\n");
+            std::string pair(pos, length);
+            size_t equal = pair.find('=');
+            if (equal != std::string::npos && pair[0] != '#') {
+                std::string name = pair.substr(0, equal);
+                int value = atoi(pair.c_str() + equal + 1);
+                if (name == "mmp_tile") {
+                    params.mmp_tile = std::max(value, 0);
+                } else if (name == "mvp_unroll") {
+                    params.mvp_unroll = (value >= 8) ? 8 : (value >= 4) ? 4 : (value >= 2) ? 2 : 1;
+                } else if (name == "summa_panel") {
+                    params.summa_panel = std::max(value, 0);
+                } else if (name == "allgather_chunks") {
+                    params.allgather_chunks = std::max(value, 1);
+                }
+            }
+            pos += length;
+            if (*pos != '\0') {
+                pos++;
+            }
+        }
+
+        return 0;
+    }
+
+    ________________________________________________________________________________
+
+//! @internal read the parameters from a cache file
+    int Load(
+            Parameters &params,
+            const char *file_name) {
+
+        FILE *file = fopen(file_name, "r");
+        if (file == NULL) {
+            return 1;
+        }
+        std::string text;
+        char line[256];
+        while (fgets(line, sizeof(line), file) != NULL) {
+            text += line;
+        }
+        fclose(file);
+        Parse(params, text.c_str());
+
+        return 0;
+    }
+
+    ________________________________________________________________________________
+
+//! @internal write the parameters into a cache file
+    int Save(
+            const Parameters &params,
+            const char *file_name) {
+
+        FILE *file = fopen(file_name, "w");
+        if (file == NULL) {
+            return 1;
+        }
+        char host_name[256] = "localhost";
+        gethostname(host_name, sizeof(host_name) - 1);
+        fprintf(file, "# td1 autotune, host %s\n", host_name);
+        fprintf(file, "mmp_tile=%d\n", params.mmp_tile);
+        fprintf(file, "mvp_unroll=%d\n", params.mvp_unroll);
+        fprintf(file, "summa_panel=%d\n", params.summa_panel);
+        fprintf(file, "allgather_chunks=%d\n", params.allgather_chunks);
+        fclose(file);
+
+        return 0;
+    }
+
+    ________________________________________________________________________________
+
+//! @internal use the parameters of root on all processors
+    int Sync(
+            MPI_Comm &mpi_comm,
+            int root) {
+
+        Parameters params = Get();
+        int values[4] = {params.mmp_tile, params.mvp_unroll,
+                         params.summa_panel, params.allgather_chunks};
+        MPI_Bcast(values, 4, MPI_INT, root, mpi_comm);
+        params.mmp_tile = values[0];
+        params.mvp_unroll = values[1];
+        params.summa_panel = values[2];
+        params.allgather_chunks = values[3];
+
+        return Set(params);
+    }
+
+    ________________________________________________________________________________
+
+//! @internal parameters in use, those shaping the messages equal on all processors
+    int Agree(
+            Parameters &params,
+            MPI_Comm &mpi_comm,
+            MPI_Comm mpi_comm_other) {
+
+        // -- agreed once per communicator, until the next Set
+        DataTopology::Context *context;
+        DataTopology::GetContext(context, mpi_comm);
+        DataTopology::ContextTune &tune = context->tunes[mpi_comm_other];
+        if (tune.generation == g_generation) {
+            params = tune.params;
+            return tune.error;
+        }
+
+        params = Get();
+        tune.generation = g_generation;
+        tune.params = params;
+        tune.error = 0;
+        // -- max of v and of -v: min and max over the processors
+        int values[4] = {params.summa_panel, -params.summa_panel,
+                         params.allgather_chunks, -params.allgather_chunks};
+        MPI_Allreduce(MPI_IN_PLACE, values, 4, MPI_INT, MPI_MAX, mpi_comm);
+        if (mpi_comm_other != MPI_COMM_NULL) {
+            MPI_Allreduce(MPI_IN_PLACE, values, 4, MPI_INT, MPI_MAX, mpi_comm_other);
+        }
+        if (values[0] == -values[1] && values[2] == -values[3]) {
+            return 0;
+        }
+
+        Parameters defaults;
+        Default(defaults);
+        params.summa_panel = defaults.summa_panel;
+        params.allgather_chunks = defaults.allgather_chunks;
+        tune.params = params;
+        tune.error = 1;
+
+        return 1;
+    }
+
+    ________________________________________________________________________________
+
+//! @internal element of the trial matrices
+    double TrialElement(
+            int idx,
+            int idy,
+            void *data) {
+
+        return 1. / (1. + idx + idy);
+    }
+
+    ________________________________________________________________________________
+
+//! @internal median over a few runs of the time of the slowest processor
+    double Trial(
+            const std::function<void()> &run,
+            MPI_Comm &mpi_comm) {
+
+        const int numb_runs = 5;
+        std::vector<double> times;
+        run();
+        for (int r = 0; r < numb_runs; r++) {
+            MPI_Barrier(mpi_comm);
+            double t0 = MPI_Wtime();
+            run();
+            double time = MPI_Wtime() - t0;
+            MPI_Allreduce(MPI_IN_PLACE, &time, 1, MPI_DOUBLE, MPI_MAX, mpi_comm);
+            times.push_back(time);
+        }
+        std::sort(times.begin(), times.end());
+
+        return times[numb_runs / 2];
+    }
+
+    ________________________________________________________________________________
+
+//! @internal best value of a parameter among candidates (others fixed)
+    int Search(
+            Parameters &params,
+            int &value,
+            const std::vector<int> &candidates,
+            const std::function<void()> &run,
+            const char *name,
+            MPI_Comm &mpi_comm) {
+
+        int best = value;
+        double time_best = -1.;
+        for (size_t c = 0; c < candidates.size(); c++) {
+            value = candidates[c];
+            Set(params);
+            double time = Trial(run, mpi_comm);
+            iomrg::printf("-- autotune %-17s: %5d %12.6f s\n", name, value, time);
+            if (time_best < 0. || time < time_best) {
+                best = value;
+                time_best = time;
+            }
+        }
+        value = best;
+        Set(params);
+
+        return 0;
+    }
+
+    ________________________________________________________________________________
+
+//! @internal search the parameters on the current hosts with short timed trials
+    int Autotune(
+            Parameters &params,
+            MPI_Comm &mpi_comm,
+            int size,
+            const char *file_name) {
+
+        int rank, nproc;
+        MPI_Comm_rank(mpi_comm, &rank);
+        MPI_Comm_size(mpi_comm, &nproc);
+        params = Get();
+
+        // -- sequential kernels, the same matrix on every processor
+        int size_mmp = std::min(size, 256);
+        MatrixDense<double, int> A(size, size);
+        Vector<double, int> x(size);
+        Vector<double, int> y(size);
+        for (int i = 0; i < size; i++) {
+            for (int j = 0; j < size; j++) {
+                A(i, j) = TrialElement(i, j, NULL);
+            }
+            x(i) = 1.;
+        }
+        MatrixDense<double, int> B(size_mmp, size_mmp);
+        MatrixDense<double, int> C(size_mmp, size_mmp);
+        for (int i = 0; i < size_mmp; i++) {
+            for (int j = 0; j < size_mmp; j++) {
+                B(i, j) = TrialElement(i, j, NULL);
+            }
+        }
+
+        Search(params, params.mvp_unroll, {1, 2, 4, 8},
+               [&]() { A.MatrixVectorProduct(y, x, Get().mvp_unroll); }, "mvp_unroll", mpi_comm);
+        Search(params, params.mmp_tile, {0, 16, 32, 64, 128},
+               [&]() { B.MatrixMatrixProduct(C, B, Get().mmp_tile); }, "mmp_tile", mpi_comm);
+
+        // -- band-row matrix-vector product, built in place
+        DataTopology::Distribution dist;
+        DataTopology::CreateDistribution(dist, DataTopology::distribution::c_BAND_ROW,
+                                         size, size, mpi_comm);
+        MatrixDense<double, int> A_local;
+        DataTopology::CreateMatrix(A_local, dist, TrialElement);
+        Vector<double, int> x_local(DataTopology::BandSize(rank, nproc, size));
+        Vector<double, int> y_local(A_local.GetNumbRows());
+        for (int i = 0; i < x_local.GetSize(); i++) {
+            x_local(i) = 1.;
+        }
+        Search(params, params.allgather_chunks, {1, 2, 4, 8},
+               [&]() { BlasMpi::MatrixVectorProductBandRow(y_local, A_local, x_local, mpi_comm); },
+               "allgather_chunks", mpi_comm);
+
+        // -- SUMMA on blocks of 64, panels of part of a block
+        const int block_size = 64;
+        MPI_Comm mpi_comm_rows;
+        MPI_Comm mpi_comm_columns;
+        DataTopology::GridCartesianComm(mpi_comm_rows, mpi_comm_columns, mpi_comm,
+                                        size_mmp, size_mmp, DataTopology::operation::c_GEMM);
+        DataTopology::CreateDistribution(dist, DataTopology::distribution::c_BLOCK_CYCLIC,
+                                         size_mmp, size_mmp, mpi_comm_rows, mpi_comm_columns,
+                                         block_size, block_size);
+        MatrixDense<double, int> B_local;
+        MatrixDense<double, int> C_local;
+        DataTopology::CreateMatrix(B_local, dist, TrialElement);
+        Search(params, params.summa_panel, {8, 16, 32, 0},
+               [&]() {
+                   BlasMpi::MatrixMatrixProductBlockCyclic(C_local, B_local, B_local, block_size,
+                                                           mpi_comm_rows, mpi_comm_columns);
+               }, "summa_panel", mpi_comm);
+
+        // -- processor 0 decides for all
+        Sync(mpi_comm, 0);
+        params = Get();
+        int error = 0;
+        if (file_name != NULL && rank == 0) {
+            error = Save(params, file_name);
+        }
+        MPI_Bcast(&error, 1, MPI_INT, 0, mpi_comm);
+
+        return error;
+    }
+
+    ________________________________________________________________________________
+
+} // namespace Tune {
@@ -0,0 +1,138 @@
+/*!
+*  @file Tune.hpp
+*  @brief header of Tune (parameters of the kernels and of the communications)
+*  @author Abal-Kassim Cheik Ahamed, Frédéric Magoulès, Sonia Toubaline
+*  @date Tue Nov 24 16:16:48 CET 2015
+*  @version 1.0
+*  @remarks the parameters are loaded on first use from the cache file of the
+*           host (written by Autotune), then overridden by $TD1_TUNE,
+*           e.g. TD1_TUNE="mmp_tile=64,mvp_unroll=4"; mmp_tile and mvp_unroll
+*           may differ between hosts, summa_panel and allgather_chunks are
+*           checked by the collectives (see Agree)
+*/
+
+#ifndef GUARD_TUNE_HPP_
+#define GUARD_TUNE_HPP_
+
+// basic packages
+#include <string>
+#include <mpi.h>
+
+// project packages
+#include "dllmrg.hpp"
+
+// third-party packages
+
+
+//! @namespace Tune
+namespace Tune {
+
+//! @struct Parameters
+//! @brief parameters of the kernels and of the communications
+//! @remarks the default values are the untuned kernels
+struct Parameters {
+  //! tile size of MatrixDense::MatrixMatrixProduct (0: no tiling)
+  int mmp_tile;
+  //! accumulators of MatrixDense::MatrixVectorProduct (1, 2, 4 or 8)
+  int mvp_unroll;
+  //! panel width of MatrixMatrixProductBlockCyclic (0: block size)
+  int summa_panel;
+  //! chunks of the allgather of MatrixVectorProductBandRow (1: one allgather)
+  int allgather_chunks;
+} ; // struct Parameters {
+
+//! @brief parameters in use
+//! @remarks loaded on first call: cache file of the host, then $TD1_TUNE
+//! @return parameters
+const Parameters& Get ( ) ;
+
+//! @brief replace the parameters in use
+//! @param [in] params = parameters
+//! @remarks to be called on all processors of the communicators of the
+//           collectives (as Sync and Autotune do): the agreed parameters
+//           cached on the communicators are checked again after it
+//! @return error code
+int Set (
+        const Parameters& params ) ;
+
+//! @brief default parameters (untuned kernels)
+//! @param [in,out] params = parameters
+//! @return error code
+int Default (
+        Parameters& params ) ;
+
+//! @brief cache file of the host
+//! @param [in,out] file_name = $TD1_TUNE_FILE, or
+//           ${TD1_TUNE_DIR:-$HOME}/.td1_tune_<host name>
+//! @return error code
+int CacheFileName (
+        std::string& file_name ) ;
+
+//! @brief read "name=value" pairs separated by commas or new lines
+//! @param [in,out] params = parameters (unknown names are ignored)
+//! @param [in] text = pairs
+//! @return error code
+int Parse (
+        Parameters& params,
+        const char* text ) ;
+
+//! @brief read the parameters from a cache file
+//! @param [in,out] params = parameters
+//! @param [in] file_name = cache file
+//! @return error code (1: no file)
+int Load (
+        Parameters& params,
+        const char* file_name ) ;
+
+//! @brief write the parameters into a cache file
+//! @param [in] params = parameters
+//! @param [in] file_name = cache file
+//! @return error code
+int Save (
+        const Parameters& params,
+        const char* file_name ) ;
+
+//! @brief use the parameters of root on all processors
+//! @param [in] mpi_comm = MPI communicator
+//! @param [in] root = root processor
+//! @remarks collective; summa_panel and allgather_chunks shape the messages,
+//           they must be equal on all processors (hosts of different cache files)
+//! @return error code
+int Sync (
+        MPI_Comm& mpi_comm,
+        int root = 0 ) ;
+
+//! @brief parameters in use, those shaping the messages equal on all processors
+//! @param [in,out] params = parameters in use; summa_panel and allgather_chunks
+//           are set to their default value unless equal on all processors
+//! @param [in] mpi_comm = MPI communicator
+//! @param [in] mpi_comm_other = second communicator of a grid (MPI_COMM_NULL:
+//           none), the check then covers all processors of the grid
+//! @remarks collective on the first call with mpi_comm and mpi_comm_other,
+//           and on the first call after Set; the result is cached in the
+//           context of mpi_comm (see DataTopology::Context), later calls do
+//           not communicate; called by the collectives before their messages
+//! @return error code (1: parameters differ, defaults used)
+int Agree (
+        Parameters& params,
+        MPI_Comm& mpi_comm,
+        MPI_Comm mpi_comm_other = MPI_COMM_NULL ) ;
+
+//! @brief search the parameters on the current hosts with short timed trials
+//! @param [in,out] params = best parameters (in use on return)
+//! @param [in] mpi_comm = MPI communicator
+//! @param [in] size = size of the trial matrices
+//! @param [in] file_name = cache file written by processor 0, NULL: none
+//! @remarks collective; one parameter at a time, the others fixed; a trial
+//           is the median of a few runs on the slowest processor
+//! @return error code
+int Autotune (
+        Parameters& params,
+        MPI_Comm& mpi_comm,
+        int size = 512,
+        const char* file_name = NULL ) ;
+
+} // namespace Tune {
+
+
+#endif // GUARD_TUNE_HPP_
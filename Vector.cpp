@@ -15,6 +15,8 @@
 
 // project packages
 #include "Vector.hpp"
+#include "PerfCounter.hpp"
+#include "Memory.hpp"
 
 // third-party packages
 
@@ -29,6 +31,11 @@ Vector<T, U>::Vector ( void ) {
   m_size = 0;
   // set pointer to NULL
   m_coef = NULL;
+  // not mapped
+  m_map_base = NULL;
+  m_map_size = 0;
+  // nothing allocated
+  m_tag = NULL;
 
 }
 
@@ -43,6 +50,10 @@ Vector<T, U>::Vector (
   m_size = size;
   // allocate elements array
   m_coef = new T[size];
+  m_tag = Memory::Allocated( sizeof( T ) * size, "Vector" );
+  // not mapped
+  m_map_base = NULL;
+  m_map_size = 0;
 
 }
 
@@ -52,11 +63,7 @@ ________________________________________________________________________________
 template <class T, class U>
 Vector<T, U>::~Vector ( void ) {
 
-  if ( m_coef != NULL ) {
-    m_size = 0;
-    delete [] m_coef;
-    m_coef = NULL;
-  }
+  this->Deallocate( );
 
 }
 
@@ -116,6 +123,7 @@ int Vector<T, U>::Allocate (
   m_size = size;
   // allocate elements array
   m_coef = new T[size];
+  m_tag = Memory::Allocated( sizeof( T ) * size, "Vector" );
 
   return 0;
 }
@@ -126,7 +134,15 @@ ________________________________________________________________________________
 template <class T, class U>
 int Vector<T, U>::Deallocate ( void ) {
 
-  if ( m_coef != NULL ) {
+  if ( m_map_base != NULL ) {
+    // -- elements belong to the mapped file
+    m_size = 0;
+    iomrg::UnmapFileBinary( m_map_base, m_map_size );
+    m_map_base = NULL;
+    m_map_size = 0;
+    m_coef = NULL;
+  } else if ( m_coef != NULL ) {
+    Memory::Freed( sizeof( T ) * m_size, m_tag );
     m_size = 0;
     delete [] m_coef;
     m_coef = NULL;
@@ -144,6 +160,7 @@ Vector<T,U>& Vector<T, U>::operator= (
 
   // if current object is different with the copy object
   if( this != &copy_v ) {
+    PERF_SCOPE( "Vector::operator=", 0., 2. * sizeof( T ) * copy_v.GetSize( ) );
     // copy elements;
     for ( U i = 0; i < copy_v.GetSize( ); i++ ) {
       m_coef[i] = copy_v.m_coef[i];
@@ -233,33 +250,40 @@ int Vector<T, U>::ReadFromFileCsv (
 
   iomrg::printf( ".r. Reading csv file (vector): %s \n", file_name );
 
-  // -- open file
-  std::ifstream file(file_name, std::ios::in);
-
-  // read mrg information
-  std::string current_line;
+  // -- map file
+  const char* text = NULL;
+  size_t text_size = 0;
+  if ( iomrg::MapFileText( text, text_size, file_name ) != 0 ) {
+    return 1;
+  }
+  const char* text_end = text + text_size;
 
-  // -- read new line
-  std::getline( file, current_line );
-  std::stringstream ss_current_line(current_line);
-  // first line
+  // -- read first line
+  const char* line_end = static_cast<const char*>( memchr( text, '\n', text_size ) );
+  if ( line_end == NULL ) {
+    line_end = text_end;
+  }
   U size;
-  ss_current_line >> size;
+  if ( iomrg::ParseCsv( &size, 1, text, line_end, 1 ) != 0 ) {
+    iomrg::UnmapFileText( text, text_size );
+    return 1;
+  }
+  // if already allocated, deallocate first
+  this->Deallocate( );
   // -- update size
   m_size = size;
 
   // -- read elements
   // allocate elements array
   m_coef = new T[m_size];
-  // read elements
-  for (U i = 0; i < m_size; i++) {
-    file >> m_coef[i];
-  }
+  m_tag = Memory::Allocated( sizeof( T ) * m_size, "Vector" );
+  // read elements (chunks parsed by threads)
+  int error = iomrg::ParseCsv( m_coef, (size_t) m_size, line_end, text_end );
 
-  // -- close file
-  file.close();
+  // -- unmap file
+  iomrg::UnmapFileText( text, text_size );
 
-  return 0;
+  return error;
 }
 
 ________________________________________________________________________________
@@ -270,13 +294,11 @@ int Vector<T, U>::WriteToFileCsv (
         const char* file_name,
         const char separator,
         const U idx_begin,
-        const U idx_end ) const {
+        const U idx_end,
+        const int precision ) const {
 
   iomrg::printf( ".w. Writing csv file (vector): %s \n", file_name );
 
-  // -- open file
-  std::ofstream file(file_name, std::ios::out | std::ios::trunc);
-
   // dimension of the array
   U size = m_size;
 
@@ -288,23 +310,54 @@ int Vector<T, U>::WriteToFileCsv (
     _idx_end = idx_end;
   }
 
-  // -- write dimension
-  file << size << std::endl;
+  // -- dimension
+  std::string header = std::to_string( size );
+  // -- write elements as a single row (blocks formatted by threads)
+  return iomrg::WriteFileCsv( file_name, header.c_str( ), m_coef + _idx_begin,
+                              1, _idx_end - _idx_begin + 1,
+                              separator, '\n', precision );
+}
 
-  // -- write elements
-  if ( separator != '\0' ) {
-    for ( U i = _idx_begin; i < _idx_end; i++ ) {
-      file << m_coef[i] << separator;
-    }
-  } else {
-    for ( U i = _idx_begin; i < _idx_end; i++ ) {
-      file << m_coef[i];
-    }
+________________________________________________________________________________
+
+//! @internal write vector into a binary file
+template <class T, class U>
+int Vector<T, U>::WriteToFileBinary (
+        const char* file_name ) const {
+
+  iomrg::printf( ".w. Writing binary file (vector): %s \n", file_name );
+
+  return iomrg::WriteFileBinary( file_name, m_coef, m_size, 1 );
+}
+
+________________________________________________________________________________
+
+//! @internal map vector from a binary file, without copy nor parsing
+template <class T, class U>
+int Vector<T, U>::MapFromFileBinary (
+        const char* file_name,
+        const int opt_map,
+        const bool opt_check ) {
+
+  iomrg::printf( ".r. Mapping binary file (vector): %s \n", file_name );
+
+  // if already allocated, deallocate first
+  this->Deallocate( );
+
+  void* map_base = NULL;
+  size_t map_size = 0;
+  iomrg::BinaryHeader header;
+  if ( iomrg::MapFileBinary( map_base, map_size, header, file_name,
+                             opt_map, opt_check ) != 0 ) {
+    return 1;
   }
-  file << m_coef[_idx_end] << std::endl;
 
-  // -- close file
-  file.close();
+  m_map_base = map_base;
+  m_map_size = map_size;
+  // -- update size
+  m_size = header.numb_rows * header.numb_columns;
+  // elements are read in place
+  m_coef = reinterpret_cast<T*>( static_cast<char*>(map_base) + header.data_offset );
 
   return 0;
 }
@@ -33,6 +33,12 @@ class Vector {
     U m_size;
     //! elements of the vector
     T* m_coef;
+    //! address of the mapped file (NULL if elements are allocated)
+    void* m_map_base;
+    //! size of the mapped file
+    size_t m_map_size;
+    //! allocation-site tag of the elements (see Memory)
+    const char* m_tag;
 
   public:
 
@@ -158,12 +164,34 @@ class Vector {
     //! @brief write vector into a csv ascii file
     //! @param [in] file_name = name of the file
     //! @param [in] separator = format separator
+    //! @param [in] idx_begin = first index written
+    //! @param [in] idx_end = last index written (0 = last element)
+    //! @param [in] precision = significant digits (0 = shortest round-trip)
     //! @return error code
     int WriteToFileCsv (
         const char* file_name,
         const char separator = ' ',
         const U idx_begin = 0,
-        const U idx_end = 0 ) const ;
+        const U idx_end = 0,
+        const int precision = 0 ) const ;
+
+    //! @brief write vector into a binary file (iomrg::BinaryHeader)
+    //! @param [in] file_name = name of the file
+    //! @return error code
+    int WriteToFileBinary (
+        const char* file_name ) const ;
+
+    //! @brief map vector from a binary file, without copy nor parsing
+    //! @param [in] file_name = name of the file
+    //! @param [in] opt_map = paging policy (iomrg::binary::map_enum)
+    //! @param [in] opt_check = verify the checksum (touches every page)
+    //! @remarks elements point into a private mapping (copy on write),
+    //           released by Deallocate
+    //! @return error code
+    int MapFromFileBinary (
+        const char* file_name,
+        const int opt_map = iomrg::binary::c_MAP_LAZY,
+        const bool opt_check = false ) ;
 
 }; // class Vector {
 
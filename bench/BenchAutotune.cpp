@@ -0,0 +1,136 @@
+// basic packages
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <mpi.h>
+
+// project packages
+#include "Vector.hpp"
+#include "MatrixDense.hpp"
+#include "Tune.hpp"
+
+// third-party packages
+
+//! @brief time of the sequential kernels with the parameters in use
+int TimeKernels (
+        double& time_mvp,
+        double& time_mmp,
+        int size ) {
+
+  MatrixDense<double,int> A( size, size );
+  MatrixDense<double,int> C( size, size );
+  Vector<double,int> x( size );
+  Vector<double,int> y( size );
+  for ( int i = 0; i < size; i++ ) {
+    for ( int j = 0; j < size; j++ ) {
+      A(i,j) = 1. / ( 1. + i + j );
+    }
+    x(i) = 1.;
+  }
+  double t0 = MPI_Wtime( );
+  for ( int r = 0; r < 10; r++ ) {
+    A.MatrixVectorProduct( y, x, Tune::Get( ).mvp_unroll );
+  }
+  double t1 = MPI_Wtime( );
+  A.MatrixMatrixProduct( C, A, Tune::Get( ).mmp_tile );
+  double t2 = MPI_Wtime( );
+  time_mvp = ( t1 - t0 ) / 10;
+  time_mmp = t2 - t1;
+  return 0;
+}
+
+int main (
+        int argc,
+        char** argv ) {
+
+  // ---------------------------------------------------------------------------
+  // -- initialize MPI
+  // ---------------------------------------------------------------------------
+
+  // -- number of processors
+  int numb_procs;
+  // -- process number (process rank)
+  int proc_numb;
+  // -- starts MPI
+  MPI_Init( &argc, &argv );
+  // -- get the communicator
+  MPI_Comm mpi_comm = MPI_COMM_WORLD;
+  // -- get number of processes
+  MPI_Comm_size( mpi_comm, &numb_procs );
+  // -- get current process rank
+  MPI_Comm_rank( mpi_comm, &proc_numb );
+
+  // -- help for io printing
+  iomrg::g_log_numb_procs = numb_procs;
+  iomrg::g_log_proc_numb = proc_numb;
+  iomrg::g_enabled_stdout = ( proc_numb == 0 );
+
+  // ---------------------------------------------------------------------------
+  // -- pre-processing
+  // ---------------------------------------------------------------------------
+
+  // -- size of the trial matrices
+  const int size = (argc > 1) ? atoi(argv[1]) : 512;
+  // -- cache file (default: the cache file of the host)
+  std::string file_name;
+  Tune::CacheFileName( file_name );
+  if ( argc > 2 ) {
+    file_name = argv[2];
+  }
+  iomrg::printf( "-- problem size: %d [cache file: %s]\n\n", size, file_name.c_str( ) );
+
+  // -- reference: untuned kernels
+  Tune::Parameters params;
+  Tune::Default( params );
+  Tune::Set( params );
+  double time_mvp_ref, time_mmp_ref;
+  TimeKernels( time_mvp_ref, time_mmp_ref, ( size < 256 ) ? size : 256 );
+
+  // ---------------------------------------------------------------------------
+  // -- processing
+  // ---------------------------------------------------------------------------
+
+  double t0 = MPI_Wtime( );
+  int numb_errors = Tune::Autotune( params, mpi_comm, size, file_name.c_str( ) );
+  double time_tune = MPI_Wtime( ) - t0;
+
+  // -- the cache file gives back the parameters found
+  Tune::Parameters loaded;
+  Tune::Default( loaded );
+  if ( proc_numb == 0 ) {
+    numb_errors += Tune::Load( loaded, file_name.c_str( ) );
+    numb_errors += ( loaded.mmp_tile != params.mmp_tile ||
+                     loaded.mvp_unroll != params.mvp_unroll ||
+                     loaded.summa_panel != params.summa_panel ||
+                     loaded.allgather_chunks != params.allgather_chunks );
+  }
+  MPI_Bcast( &numb_errors, 1, MPI_INT, 0, mpi_comm );
+
+  double time_mvp, time_mmp;
+  TimeKernels( time_mvp, time_mmp, ( size < 256 ) ? size : 256 );
+
+  // ---------------------------------------------------------------------------
+  // -- post-processing
+  // ---------------------------------------------------------------------------
+
+  iomrg::printf( "\n" );
+  iomrg::printf( "mmp_tile              : %12d\n", params.mmp_tile );
+  iomrg::printf( "mvp_unroll            : %12d\n", params.mvp_unroll );
+  iomrg::printf( "summa_panel           : %12d\n", params.summa_panel );
+  iomrg::printf( "allgather_chunks      : %12d\n", params.allgather_chunks );
+  iomrg::printf( "autotune              : %12.6f s\n", time_tune );
+  iomrg::printf( "mvp (default)         : %12.6f s\n", time_mvp_ref );
+  iomrg::printf( "mvp (tuned)           : %12.6f s\n", time_mvp );
+  iomrg::printf( "mmp (default)         : %12.6f s\n", time_mmp_ref );
+  iomrg::printf( "mmp (tuned)           : %12.6f s\n", time_mmp );
+  iomrg::printf( "errors                : %12d\n", numb_errors );
+
+  // ---------------------------------------------------------------------------
+  // -- finalize MPI
+  // ---------------------------------------------------------------------------
+
+  // -- finalizes MPI
+  MPI_Finalize( );
+
+  return ( numb_errors == 0 ) ? 0 : 1;
+}
@@ -0,0 +1,155 @@
+// basic packages
+#include <stdio.h>
+#include <stdlib.h>
+#include <mpi.h>
+
+// project packages
+#include "Vector.hpp"
+#include "MatrixDense.hpp"
+#include "DataTopology.hpp"
+
+// third-party packages
+
+//! @brief reference grid creation: cartesian communicator and two splits per call
+//! @param [in,out] mpi_comm_rows = grid rows communicator
+//! @param [in,out] mpi_comm_columns = grid columns communicator
+//! @param [in,out] mpi_comm_cart = grid communicator (cartesian)
+//! @param [in] mpi_comm = MPI communicator
+//! @return error code
+int GridCartesianCommUncached (
+        MPI_Comm& mpi_comm_rows,
+        MPI_Comm& mpi_comm_columns,
+        MPI_Comm& mpi_comm_cart,
+        MPI_Comm& mpi_comm ) {
+
+  int numb_procs;
+  MPI_Comm_size( mpi_comm, &numb_procs );
+  int grid_dims[2] = { 0, 0 };
+  int periods[2] = { 0, 0 };
+  MPI_Dims_create( numb_procs, 2, grid_dims );
+  MPI_Cart_create( mpi_comm, 2, grid_dims, periods, 1, &mpi_comm_cart );
+
+  int grid_proc_numb;
+  int grid_coords[2];
+  MPI_Comm_rank( mpi_comm_cart, &grid_proc_numb );
+  MPI_Cart_coords( mpi_comm_cart, grid_proc_numb, 2, grid_coords );
+  MPI_Comm_split( mpi_comm_cart, grid_coords[0], grid_coords[1], &mpi_comm_rows );
+  MPI_Comm_split( mpi_comm_cart, grid_coords[1], grid_coords[0], &mpi_comm_columns );
+
+  return 0;
+}
+
+int main (
+        int argc,
+        char** argv ) {
+
+  // ---------------------------------------------------------------------------
+  // -- initialize MPI
+  // ---------------------------------------------------------------------------
+
+  // -- number of processors
+  int numb_procs;
+  // -- process number (process rank)
+  int proc_numb;
+  // -- starts MPI
+  MPI_Init( &argc, &argv );
+  // -- get the communicator
+  MPI_Comm mpi_comm = MPI_COMM_WORLD;
+  // -- get number of processes
+  MPI_Comm_size( mpi_comm, &numb_procs );
+  // -- get current process rank
+  MPI_Comm_rank( mpi_comm, &proc_numb );
+
+  // -- help for io printing
+  iomrg::g_log_numb_procs = numb_procs;
+  iomrg::g_log_proc_numb = proc_numb;
+  iomrg::g_enabled_stdout = ( proc_numb == 0 );
+
+  // ---------------------------------------------------------------------------
+  // -- pre-processing
+  // ---------------------------------------------------------------------------
+
+  // -- number of calls
+  const int numb_calls = (argc > 1) ? atoi(argv[1]) : 100;
+  iomrg::printf("-- number of calls: %d\n\n", numb_calls );
+
+  // -- communicator of the library context (freed explicitly below)
+  MPI_Comm mpi_comm_dup;
+  MPI_Comm_dup( mpi_comm, &mpi_comm_dup );
+
+  // ---------------------------------------------------------------------------
+  // -- processing
+  // ---------------------------------------------------------------------------
+
+  int numb_errors = 0;
+
+  // -- reference: new communicators on every call (freed, unlike the old code)
+  MPI_Barrier( mpi_comm );
+  double t0 = MPI_Wtime( );
+  for ( int c = 0; c < numb_calls; c++ ) {
+    MPI_Comm mpi_comm_rows, mpi_comm_columns, mpi_comm_cart;
+    GridCartesianCommUncached( mpi_comm_rows, mpi_comm_columns, mpi_comm_cart, mpi_comm_dup );
+    MPI_Comm_free( &mpi_comm_rows );
+    MPI_Comm_free( &mpi_comm_columns );
+    MPI_Comm_free( &mpi_comm_cart );
+  }
+  MPI_Barrier( mpi_comm );
+  double t1 = MPI_Wtime( );
+
+  // -- context: the grid is created by the first call only
+  MPI_Comm mpi_comm_rows_first, mpi_comm_columns_first;
+  DataTopology::GridCartesianComm( mpi_comm_rows_first, mpi_comm_columns_first, mpi_comm_dup );
+  MPI_Barrier( mpi_comm );
+  double t2 = MPI_Wtime( );
+  for ( int c = 0; c < numb_calls; c++ ) {
+    MPI_Comm mpi_comm_rows, mpi_comm_columns;
+    DataTopology::GridCartesianComm( mpi_comm_rows, mpi_comm_columns, mpi_comm_dup );
+    numb_errors += ( mpi_comm_rows != mpi_comm_rows_first ||
+                     mpi_comm_columns != mpi_comm_columns_first );
+  }
+  MPI_Barrier( mpi_comm );
+  double t3 = MPI_Wtime( );
+
+  // -- cached communicators and scratch buffers work
+  int numb_procs_rows, numb_procs_columns;
+  MPI_Comm_size( mpi_comm_rows_first, &numb_procs_rows );
+  MPI_Comm_size( mpi_comm_columns_first, &numb_procs_columns );
+  numb_errors += ( numb_procs_rows * numb_procs_columns != numb_procs );
+  double* buffer_0;
+  double* buffer_1;
+  DataTopology::ScratchBuffer( buffer_0, 1000, mpi_comm_rows_first, 0 );
+  DataTopology::ScratchBuffer( buffer_1, 10, mpi_comm_rows_first, 1 );
+  buffer_0[999] = 1.;
+  buffer_1[9] = 2.;
+  double* buffer_again;
+  DataTopology::ScratchBuffer( buffer_again, 500, mpi_comm_rows_first, 0 );
+  numb_errors += ( buffer_again != buffer_0 || buffer_0[999] != 1. || buffer_1[9] != 2. );
+
+  // -- deterministic release: the context goes with its communicators
+  DataTopology::FreeContext( mpi_comm_dup );
+  MPI_Comm mpi_comm_rows, mpi_comm_columns;
+  DataTopology::GridCartesianComm( mpi_comm_rows, mpi_comm_columns, mpi_comm_dup );
+  MPI_Comm_size( mpi_comm_rows, &numb_procs_rows );
+  numb_errors += ( numb_procs_rows * numb_procs_columns != numb_procs );
+  MPI_Comm_free( &mpi_comm_dup );
+
+  MPI_Allreduce( MPI_IN_PLACE, &numb_errors, 1, MPI_INT, MPI_SUM, mpi_comm );
+
+  // ---------------------------------------------------------------------------
+  // -- post-processing
+  // ---------------------------------------------------------------------------
+
+  iomrg::printf( "create per call  : %12.3f us\n", ( t1 - t0 ) / numb_calls * 1.e6 );
+  iomrg::printf( "cached           : %12.3f us\n", ( t3 - t2 ) / numb_calls * 1.e6 );
+  iomrg::printf( "speedup          : %12.2f\n", ( t1 - t0 ) / ( t3 - t2 ) );
+  iomrg::printf( "errors           : %12d\n", numb_errors );
+
+  // ---------------------------------------------------------------------------
+  // -- finalize MPI
+  // ---------------------------------------------------------------------------
+
+  // -- finalizes MPI (releases the remaining contexts)
+  MPI_Finalize( );
+
+  return ( numb_errors == 0 ) ? 0 : 1;
+}
@@ -0,0 +1,163 @@
+// basic packages
+#include <stdio.h>
+#include <stdlib.h>
+#include <mpi.h>
+
+// project packages
+#include "Vector.hpp"
+#include "MatrixDense.hpp"
+#include "DataTopology.hpp"
+
+// third-party packages
+
+//! @brief reference band-column distribution: one MPI_Scatterv per row
+//! @param [in,out] A_local = local matrix
+//! @param [in] A = global matrix
+//! @param [in] root = root processor
+//! @param [in] mpi_comm = MPI communicator
+//! @return error code
+int DistributeMatrixBandColumnPerRow (
+        MatrixDense<double,int>& A_local,
+        const MatrixDense<double,int>& A,
+        int root,
+        MPI_Comm& mpi_comm ) {
+
+  int proc_numb, numb_procs;
+  MPI_Comm_rank( mpi_comm, &proc_numb );
+  MPI_Comm_size( mpi_comm, &numb_procs );
+
+  int dims[2];
+  if ( proc_numb == root ) {
+    dims[0] = A.GetNumbRows( );
+    dims[1] = A.GetNumbColumns( );
+  }
+  MPI_Bcast( dims, 2, MPI_INT, root, mpi_comm );
+
+  int* sendcounts = new int[numb_procs];
+  int* shifts = new int[numb_procs];
+  for ( int k = 0; k < numb_procs; k++ ) {
+    sendcounts[k] = DataTopology::BandSize( k, numb_procs, dims[1] );
+    shifts[k] = ( k == 0 ) ? 0 : shifts[k-1] + sendcounts[k-1];
+  }
+
+  A_local.Allocate( dims[0], sendcounts[proc_numb] );
+  for ( int i = 0; i < dims[0]; i++ ) {
+    const double* A_i = ( proc_numb == root ) ? A.GetCoef( i ) : NULL;
+    MPI_Scatterv( A_i, sendcounts, shifts, MPI_DOUBLE,
+                  A_local.GetCoef( i ), sendcounts[proc_numb], MPI_DOUBLE,
+                  root, mpi_comm );
+  }
+
+  delete [] sendcounts;
+  delete [] shifts;
+
+  return 0;
+}
+
+int main (
+        int argc,
+        char** argv ) {
+
+  // ---------------------------------------------------------------------------
+  // -- initialize MPI
+  // ---------------------------------------------------------------------------
+
+  // -- number of processors
+  int numb_procs;
+  // -- process number (process rank)
+  int proc_numb;
+  // -- starts MPI
+  MPI_Init( &argc, &argv );
+  // -- get the communicator
+  MPI_Comm mpi_comm = MPI_COMM_WORLD;
+  // -- get number of processes
+  MPI_Comm_size( mpi_comm, &numb_procs );
+  // -- get current process rank
+  MPI_Comm_rank( mpi_comm, &proc_numb );
+
+  // -- help for io printing
+  iomrg::g_log_numb_procs = numb_procs;
+  iomrg::g_log_proc_numb = proc_numb;
+  iomrg::g_enabled_stdout = ( proc_numb == 0 );
+
+  // ---------------------------------------------------------------------------
+  // -- pre-processing
+  // ---------------------------------------------------------------------------
+
+  // -- size of problem
+  const int size = (argc > 1) ? atoi(argv[1]) : 2000;
+  // -- number of repetitions
+  const int numb_reps = (argc > 2) ? atoi(argv[2]) : 5;
+  const int proc_root = 0;
+  iomrg::printf("-- problem size: %d [numb_reps: %d]\n\n", size, numb_reps );
+
+  MatrixDense<double,int> A_global;
+  if ( proc_numb == proc_root ) {
+    A_global.Allocate( size, size );
+    for( int i = 0; i < size; i++ ) {
+      for( int j = 0; j < size; j++ ) {
+        A_global(i,j) = i * size + j;
+      }
+    }
+  }
+
+  // ---------------------------------------------------------------------------
+  // -- processing
+  // ---------------------------------------------------------------------------
+
+  MatrixDense<double,int> A_local;
+  MatrixDense<double,int> A_local_ref;
+  double time_ref = 0.;
+  double time_new = 0.;
+
+  for ( int r = 0; r < numb_reps; r++ ) {
+    MPI_Barrier( mpi_comm );
+    double t0 = MPI_Wtime( );
+    DistributeMatrixBandColumnPerRow( A_local_ref, A_global, proc_root, mpi_comm );
+    MPI_Barrier( mpi_comm );
+    double t1 = MPI_Wtime( );
+    DataTopology::DistributeMatrixBandColumn( A_local, A_global, proc_root, mpi_comm );
+    MPI_Barrier( mpi_comm );
+    double t2 = MPI_Wtime( );
+    time_ref += t1 - t0;
+    time_new += t2 - t1;
+  }
+
+  // -- both distributions must agree
+  int numb_errors = 0;
+  for ( int i = 0; i < A_local.GetNumbRows( ) * A_local.GetNumbColumns( ); i++ ) {
+    if ( A_local.GetCoef( )[i] != A_local_ref.GetCoef( )[i] ) {
+      numb_errors++;
+    }
+  }
+  MPI_Allreduce( MPI_IN_PLACE, &numb_errors, 1, MPI_INT, MPI_SUM, mpi_comm );
+
+  // -- round trip through the assemble
+  MatrixDense<double,int> A_assembled;
+  DataTopology::AssembleMatrixBandColumn( A_assembled, A_local, proc_root, mpi_comm );
+  if ( proc_numb == proc_root ) {
+    for ( int i = 0; i < size * size; i++ ) {
+      if ( A_assembled.GetCoef( )[i] != A_global.GetCoef( )[i] ) {
+        numb_errors++;
+      }
+    }
+  }
+
+  // ---------------------------------------------------------------------------
+  // -- post-processing
+  // ---------------------------------------------------------------------------
+
+  iomrg::printf( "per-row scatter  : %12.6f s\n", time_ref / numb_reps );
+  iomrg::printf( "band datatype    : %12.6f s\n", time_new / numb_reps );
+  iomrg::printf( "speedup          : %12.2f\n", time_ref / time_new );
+  iomrg::printf( "errors           : %12d\n", numb_errors );
+
+  // ---------------------------------------------------------------------------
+  // -- finalize MPI
+  // ---------------------------------------------------------------------------
+
+  // -- finalizes MPI
+  MPI_Finalize( );
+
+  return ( numb_errors == 0 ) ? 0 : 1;
+}
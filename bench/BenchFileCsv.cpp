@@ -0,0 +1,215 @@
+// basic packages
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <mpi.h>
+
+// project packages
+#include "Vector.hpp"
+#include "MatrixDense.hpp"
+
+// third-party packages
+
+//! @brief reference csv reader: std::ifstream >> element by element
+//! @param [in,out] A = matrix
+//! @param [in] file_name = name of the file
+//! @return error code
+int ReadMatrixFromFileCsvStream (
+        MatrixDense<double,int>& A,
+        const char* file_name ) {
+
+  std::ifstream file(file_name, std::ios::in);
+
+  std::string current_line;
+  std::getline( file, current_line );
+  std::stringstream ss_current_line(current_line);
+  int numb_rows;
+  int numb_columns;
+  ss_current_line >> numb_rows >> numb_columns;
+
+  A.Allocate( numb_rows, numb_columns );
+  double* coef = A.GetCoef( );
+  for ( int i = 0; i < numb_rows * numb_columns; i++ ) {
+    file >> coef[i];
+  }
+
+  file.close();
+
+  return 0;
+}
+
+//! @brief reference csv writer: std::ofstream << element by element
+//! @param [in] A = matrix
+//! @param [in] file_name = name of the file
+//! @param [in] precision = significant digits
+//! @return error code
+int WriteMatrixToFileCsvStream (
+        const MatrixDense<double,int>& A,
+        const char* file_name,
+        const int precision ) {
+
+  std::ofstream file(file_name, std::ios::out | std::ios::trunc);
+  file.precision( precision );
+
+  file << A.GetNumbRows( ) << " " << A.GetNumbColumns( ) << std::endl;
+  for ( int i = 0; i < A.GetNumbRows( ); i++ ) {
+    for ( int j = 0; j < A.GetNumbColumns( ) - 1; j++ ) {
+      file << A(i,j) << ' ';
+    }
+    file << A(i,A.GetNumbColumns( )-1) << '\n';
+  }
+
+  file.close();
+
+  return 0;
+}
+
+//! @brief size of a file
+//! @param [in] file_name = name of the file
+//! @return size of the file (bytes)
+double FileSize (
+        const char* file_name ) {
+
+  struct stat file_stat;
+  if ( stat( file_name, &file_stat ) != 0 ) {
+    return 0.;
+  }
+  return file_stat.st_size;
+}
+
+int main (
+        int argc,
+        char** argv ) {
+
+  // ---------------------------------------------------------------------------
+  // -- initialize MPI
+  // ---------------------------------------------------------------------------
+
+  // -- number of processors
+  int numb_procs;
+  // -- process number (process rank)
+  int proc_numb;
+  // -- starts MPI
+  MPI_Init( &argc, &argv );
+  // -- get the communicator
+  MPI_Comm mpi_comm = MPI_COMM_WORLD;
+  // -- get number of processes
+  MPI_Comm_size( mpi_comm, &numb_procs );
+  // -- get current process rank
+  MPI_Comm_rank( mpi_comm, &proc_numb );
+
+  // -- help for io printing
+  iomrg::g_log_numb_procs = numb_procs;
+  iomrg::g_log_proc_numb = proc_numb;
+  iomrg::g_enabled_stdout = ( proc_numb == 0 );
+
+  // ---------------------------------------------------------------------------
+  // -- pre-processing
+  // ---------------------------------------------------------------------------
+
+  // -- size of problem
+  const int size = (argc > 1) ? atoi(argv[1]) : 2000;
+  // -- number of repetitions
+  const int numb_reps = (argc > 2) ? atoi(argv[2]) : 3;
+  // -- number of threads (0 = hardware concurrency)
+  iomrg::g_csv_numb_threads = (argc > 3) ? atoi(argv[3]) : 0;
+  // -- csv files are written by a single processor
+  const int proc_root = 0;
+  const char* file_name_ref = "bench_csv_ref.csv";
+  const char* file_name_new = "bench_csv_new.csv";
+  iomrg::printf("-- problem size: %d [numb_reps: %d, numb_threads: %d]\n\n",
+                size, numb_reps, iomrg::g_csv_numb_threads );
+
+  int numb_errors = 0;
+  if ( proc_numb == proc_root ) {
+
+    MatrixDense<double,int> A;
+    A.Allocate( size, size );
+    for( int i = 0; i < size; i++ ) {
+      for( int j = 0; j < size; j++ ) {
+        A(i,j) = 1. / ( 1. + i ) - 3. * j;
+      }
+    }
+
+    // -------------------------------------------------------------------------
+    // -- processing
+    // -------------------------------------------------------------------------
+
+    MatrixDense<double,int> A_ref;
+    MatrixDense<double,int> A_new;
+    double time_write_ref = 0.;
+    double time_write_new = 0.;
+    double time_read_ref = 0.;
+    double time_read_new = 0.;
+
+    // -- same (round-trip) precision for both writers
+    const int precision = 17;
+    iomrg::g_enabled_stdout = false;
+    for ( int r = 0; r < numb_reps; r++ ) {
+      double t0 = MPI_Wtime( );
+      WriteMatrixToFileCsvStream( A, file_name_ref, precision );
+      double t1 = MPI_Wtime( );
+      A.WriteToFileCsv( file_name_new, ' ', '\n', precision );
+      double t2 = MPI_Wtime( );
+      ReadMatrixFromFileCsvStream( A_ref, file_name_ref );
+      double t3 = MPI_Wtime( );
+      numb_errors += A_new.ReadFromFileCsv( file_name_new );
+      double t4 = MPI_Wtime( );
+      time_write_ref += t1 - t0;
+      time_write_new += t2 - t1;
+      time_read_ref += t3 - t2;
+      time_read_new += t4 - t3;
+    }
+    iomrg::g_enabled_stdout = true;
+
+    // -- both readers must give back the original elements
+    for ( int i = 0; i < size * size; i++ ) {
+      if ( A_ref.GetCoef( )[i] != A.GetCoef( )[i] ||
+           A_new.GetCoef( )[i] != A.GetCoef( )[i] ) {
+        numb_errors++;
+      }
+    }
+
+    // -- shortest round-trip output reads back exactly as well
+    iomrg::g_enabled_stdout = false;
+    A.WriteToFileCsv( file_name_new );
+    numb_errors += A_new.ReadFromFileCsv( file_name_new );
+    iomrg::g_enabled_stdout = true;
+    for ( int i = 0; i < size * size; i++ ) {
+      if ( A_new.GetCoef( )[i] != A.GetCoef( )[i] ) {
+        numb_errors++;
+      }
+    }
+
+    // -------------------------------------------------------------------------
+    // -- post-processing
+    // -------------------------------------------------------------------------
+
+    const double giga_bytes_ref = FileSize( file_name_ref ) * numb_reps / 1.e9;
+    const double giga_bytes_new = FileSize( file_name_new ) * numb_reps / 1.e9;
+    iomrg::printf( "file size (shortest) : %12.3f MB\n", giga_bytes_new / numb_reps * 1.e3 );
+    iomrg::printf( "write ofstream       : %12.3f GB/s\n", giga_bytes_ref / time_write_ref );
+    iomrg::printf( "write to_chars       : %12.3f GB/s\n", giga_bytes_ref / time_write_new );
+    iomrg::printf( "read ifstream        : %12.3f GB/s\n", giga_bytes_ref / time_read_ref );
+    iomrg::printf( "read from_chars      : %12.3f GB/s\n", giga_bytes_ref / time_read_new );
+    iomrg::printf( "speedup write        : %12.2f\n", time_write_ref / time_write_new );
+    iomrg::printf( "speedup read         : %12.2f\n", time_read_ref / time_read_new );
+    iomrg::printf( "errors               : %12d\n", numb_errors );
+
+    remove( file_name_ref );
+    remove( file_name_new );
+  }
+  MPI_Bcast( &numb_errors, 1, MPI_INT, proc_root, mpi_comm );
+
+  // ---------------------------------------------------------------------------
+  // -- finalize MPI
+  // ---------------------------------------------------------------------------
+
+  // -- finalizes MPI
+  MPI_Finalize( );
+
+  return ( numb_errors == 0 ) ? 0 : 1;
+}
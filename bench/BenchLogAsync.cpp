@@ -0,0 +1,164 @@
+// basic packages
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <thread>
+#include <vector>
+#include <mpi.h>
+
+// project packages
+#include "dllmrg.hpp"
+
+// third-party packages
+
+//! @brief print numb_messages messages from numb_threads threads
+double PrintMessages (
+        int numb_threads,
+        int numb_messages ) {
+
+  double t0 = MPI_Wtime( );
+  std::vector<std::thread> threads;
+  for ( int t = 0; t < numb_threads; t++ ) {
+    threads.push_back( std::thread( [t, numb_messages] ( ) {
+      for ( int m = 0; m < numb_messages; m++ ) {
+        iomrg::printf( ".r. thread %d message %d of %d\n", t, m, numb_messages );
+      }
+    } ) );
+  }
+  for ( int t = 0; t < numb_threads; t++ ) {
+    threads[t].join( );
+  }
+  return MPI_Wtime( ) - t0;
+}
+
+//! @brief number of lines of a file
+long long CountLines (
+        const char* file_name ) {
+
+  FILE* file = fopen( file_name, "r" );
+  if ( file == NULL ) {
+    return -1;
+  }
+  long long numb_lines = 0;
+  int c;
+  while ( ( c = fgetc( file ) ) != EOF ) {
+    numb_lines += ( c == '\n' );
+  }
+  fclose( file );
+  return numb_lines;
+}
+
+int main (
+        int argc,
+        char** argv ) {
+
+  // ---------------------------------------------------------------------------
+  // -- initialize MPI
+  // ---------------------------------------------------------------------------
+
+  // -- number of processors
+  int numb_procs;
+  // -- process number (process rank)
+  int proc_numb;
+  // -- starts MPI
+  MPI_Init( &argc, &argv );
+  // -- get the communicator
+  MPI_Comm mpi_comm = MPI_COMM_WORLD;
+  // -- get number of processes
+  MPI_Comm_size( mpi_comm, &numb_procs );
+  // -- get current process rank
+  MPI_Comm_rank( mpi_comm, &proc_numb );
+
+  // -- help for io printing
+  iomrg::g_log_numb_procs = numb_procs;
+  iomrg::g_log_proc_numb = proc_numb;
+  iomrg::g_enabled_stdout = ( proc_numb == 0 );
+
+  // ---------------------------------------------------------------------------
+  // -- pre-processing
+  // ---------------------------------------------------------------------------
+
+  // -- messages per thread
+  const int numb_messages = (argc > 1) ? atoi(argv[1]) : 20000;
+  // -- threads per processor (the main thread waits)
+  const int numb_threads = (argc > 2) ? atoi(argv[2]) : 2;
+  // -- records per ring
+  const int capacity = (argc > 3) ? atoi(argv[3]) : 4096;
+  const char* file_group_name = "bench_log";
+  iomrg::printf( "-- messages: %d [numb_threads: %d, capacity: %d]\n\n",
+                 numb_messages, numb_threads, capacity );
+
+  char file_name_sync[64];
+  char file_name_async[64];
+  snprintf( file_name_sync, sizeof( file_name_sync ), "%s_sync_%03d.log",
+            file_group_name, proc_numb );
+  snprintf( file_name_async, sizeof( file_name_async ), "%s_%03d.log",
+            file_group_name, proc_numb );
+  const long long numb_total = (long long) numb_threads * numb_messages;
+
+  // ---------------------------------------------------------------------------
+  // -- processing
+  // ---------------------------------------------------------------------------
+
+  // -- synchronous log file (the historical path, shared buffers: one thread)
+  iomrg::g_log_project = true;
+  iomrg::SetLogProjectName( "Bench" );
+  iomrg::SetLogFileName( file_name_sync );
+  iomrg::g_log_file_reset = true;
+  iomrg::g_enabled_logout = true;
+  iomrg::g_enabled_stdout = false;
+  MPI_Barrier( mpi_comm );
+  double time_sync = PrintMessages( 1, numb_threads * numb_messages );
+  iomrg::g_enabled_logout = false;
+  iomrg::SetLogFinalize( );
+
+  // -- asynchronous, backpressure: every record reaches the file
+  int numb_errors = iomrg::SetLogAsync( file_group_name, capacity,
+                                        iomrg::log_policy::c_BLOCK );
+  MPI_Barrier( mpi_comm );
+  double time_block = PrintMessages( numb_threads, numb_messages );
+  double t0 = MPI_Wtime( );
+  iomrg::SetLogFinalize( );
+  double time_block_drain = MPI_Wtime( ) - t0;
+  numb_errors += ( CountLines( file_name_async ) != numb_total );
+
+  // -- asynchronous, drop: the records written and dropped add up
+  numb_errors += iomrg::SetLogAsync( file_group_name, capacity,
+                                     iomrg::log_policy::c_DROP );
+  MPI_Barrier( mpi_comm );
+  double time_drop = PrintMessages( numb_threads, numb_messages );
+  long long numb_dropped = iomrg::GetLogNumbDropped( );
+  iomrg::SetLogFinalize( );
+  long long numb_lines = CountLines( file_name_async ) - ( numb_dropped > 0 );
+  numb_errors += ( numb_lines + numb_dropped != numb_total );
+
+  MPI_Allreduce( MPI_IN_PLACE, &numb_errors, 1, MPI_INT, MPI_SUM, mpi_comm );
+  MPI_Allreduce( MPI_IN_PLACE, &time_sync, 1, MPI_DOUBLE, MPI_MAX, mpi_comm );
+  MPI_Allreduce( MPI_IN_PLACE, &time_block, 1, MPI_DOUBLE, MPI_MAX, mpi_comm );
+  MPI_Allreduce( MPI_IN_PLACE, &time_drop, 1, MPI_DOUBLE, MPI_MAX, mpi_comm );
+
+  // ---------------------------------------------------------------------------
+  // -- post-processing
+  // ---------------------------------------------------------------------------
+
+  iomrg::g_enabled_stdout = ( proc_numb == 0 );
+  iomrg::printf( "printf sync (file)    : %12.6f s\n", time_sync );
+  iomrg::printf( "printf async (block)  : %12.6f s [drain at finalize: %.6f s]\n",
+                 time_block, time_block_drain );
+  iomrg::printf( "printf async (drop)   : %12.6f s [dropped: %lld]\n",
+                 time_drop, numb_dropped );
+  iomrg::printf( "speedup (block)       : %12.2f\n", time_sync / time_block );
+  iomrg::printf( "errors                : %12d\n", numb_errors );
+
+  remove( file_name_sync );
+  remove( file_name_async );
+
+  // ---------------------------------------------------------------------------
+  // -- finalize MPI
+  // ---------------------------------------------------------------------------
+
+  // -- finalizes MPI
+  MPI_Finalize( );
+
+  return ( numb_errors == 0 ) ? 0 : 1;
+}
@@ -0,0 +1,149 @@
+// basic packages
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include <mpi.h>
+
+// project packages
+#include "dllmrg.hpp"
+#include "LogCollect.hpp"
+
+// third-party packages
+
+//! @brief lines printed by every processor between two sync points
+void PrintLines (
+        int numb_lines,
+        int proc_numb ) {
+
+  for ( int l = 0; l < numb_lines; l++ ) {
+    iomrg::printf( ".r. Reading csv file: data_%03d.csv \n", l );
+  }
+  iomrg::printf( "-- local size: %d\n", 1000 + proc_numb );
+  iomrg::printf( "-- parity: %s\n", ( proc_numb % 2 == 0 ) ? "even" : "odd" );
+}
+
+//! @brief number of lines of a file, and the lines starting with prefix
+long long CountLines (
+        const char* file_name,
+        const char* prefix,
+        long long& numb_prefix ) {
+
+  FILE* file = fopen( file_name, "r" );
+  if ( file == NULL ) {
+    return -1;
+  }
+  long long numb_lines = 0;
+  numb_prefix = 0;
+  char line[1024];
+  while ( fgets( line, sizeof( line ), file ) != NULL ) {
+    numb_lines++;
+    numb_prefix += ( strncmp( line, prefix, strlen( prefix ) ) == 0 );
+  }
+  fclose( file );
+  return numb_lines;
+}
+
+int main (
+        int argc,
+        char** argv ) {
+
+  // ---------------------------------------------------------------------------
+  // -- initialize MPI
+  // ---------------------------------------------------------------------------
+
+  // -- number of processors
+  int numb_procs;
+  // -- process number (process rank)
+  int proc_numb;
+  // -- starts MPI
+  MPI_Init( &argc, &argv );
+  // -- get the communicator
+  MPI_Comm mpi_comm = MPI_COMM_WORLD;
+  // -- get number of processes
+  MPI_Comm_size( mpi_comm, &numb_procs );
+  // -- get current process rank
+  MPI_Comm_rank( mpi_comm, &proc_numb );
+
+  // -- help for io printing
+  iomrg::g_log_numb_procs = numb_procs;
+  iomrg::g_log_proc_numb = proc_numb;
+  iomrg::g_enabled_stdout = ( proc_numb == 0 );
+
+  // ---------------------------------------------------------------------------
+  // -- pre-processing
+  // ---------------------------------------------------------------------------
+
+  // -- lines per processor between two sync points
+  const int numb_lines = (argc > 1) ? atoi(argv[1]) : 100;
+  // -- number of sync points
+  const int numb_syncs = (argc > 2) ? atoi(argv[2]) : 5;
+  const int proc_root = 0;
+  const char* file_name = "bench_log_collect.log";
+  iomrg::printf( "-- lines: %d [numb_syncs: %d]\n\n", numb_lines, numb_syncs );
+
+  // ---------------------------------------------------------------------------
+  // -- processing
+  // ---------------------------------------------------------------------------
+
+  // -- every processor prints, root writes the merged lines
+  FILE* stream = ( proc_numb == proc_root ) ? fopen( file_name, "w" ) : NULL;
+  iomrg::g_enabled_stdout = true;
+  iomrg::g_log_collect = true;
+  double time_print = 0.;
+  double time_sync = 0.;
+  for ( int s = 0; s < numb_syncs; s++ ) {
+    MPI_Barrier( mpi_comm );
+    double t0 = MPI_Wtime( );
+    PrintLines( numb_lines, proc_numb );
+    double t1 = MPI_Wtime( );
+    LogCollect::Sync( mpi_comm, proc_root, stream );
+    double t2 = MPI_Wtime( );
+    time_print += t1 - t0;
+    time_sync += t2 - t1;
+  }
+  iomrg::g_log_collect = false;
+  iomrg::g_enabled_stdout = ( proc_numb == 0 );
+
+  // -- common lines once per sync point, "[0-(numb_procs-1)] " in front,
+  //    one line per processor for the size, two for the parity
+  int numb_errors = 0;
+  if ( proc_numb == proc_root ) {
+    fclose( stream );
+    char prefix[32];
+    snprintf( prefix, sizeof( prefix ), "[0-%d] .r.", numb_procs - 1 );
+    if ( numb_procs == 1 ) {
+      snprintf( prefix, sizeof( prefix ), "[0] .r." );
+    }
+    long long numb_common;
+    long long numb_lines_file = CountLines( file_name, prefix, numb_common );
+    long long numb_expected = (long long) numb_syncs *
+                              ( numb_lines + numb_procs + ( ( numb_procs > 1 ) ? 2 : 1 ) );
+    numb_errors += ( numb_lines_file != numb_expected );
+    numb_errors += ( numb_common != (long long) numb_syncs * numb_lines );
+    iomrg::printf( "lines printed         : %12lld\n",
+                   (long long) numb_syncs * ( numb_lines + 2 ) * numb_procs );
+    iomrg::printf( "lines written         : %12lld\n", numb_lines_file );
+    remove( file_name );
+  }
+  MPI_Allreduce( MPI_IN_PLACE, &time_sync, 1, MPI_DOUBLE, MPI_MAX, mpi_comm );
+  MPI_Allreduce( MPI_IN_PLACE, &numb_errors, 1, MPI_INT, MPI_SUM, mpi_comm );
+
+  // ---------------------------------------------------------------------------
+  // -- post-processing
+  // ---------------------------------------------------------------------------
+
+  iomrg::printf( "printf (collect)      : %12.6f s\n", time_print / numb_syncs );
+  iomrg::printf( "sync                  : %12.6f s\n", time_sync / numb_syncs );
+  iomrg::printf( "errors                : %12d\n", numb_errors );
+
+  // ---------------------------------------------------------------------------
+  // -- finalize MPI
+  // ---------------------------------------------------------------------------
+
+  // -- finalizes MPI
+  MPI_Finalize( );
+
+  return ( numb_errors == 0 ) ? 0 : 1;
+}
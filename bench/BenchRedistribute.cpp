@@ -0,0 +1,177 @@
+// basic packages
+#include <stdio.h>
+#include <stdlib.h>
+#include <mpi.h>
+
+// project packages
+#include "Vector.hpp"
+#include "MatrixDense.hpp"
+#include "DataTopology.hpp"
+
+// third-party packages
+
+//! @brief element (i,j) of the matrix
+double GenerateMatrix (
+        int idx,
+        int idy,
+        void* data ) {
+
+  int size = *static_cast<int*>(data);
+  return idx * size + idy;
+}
+
+//! @brief element (i) of the vector
+double GenerateVector (
+        int idx,
+        void* data ) {
+
+  return idx;
+}
+
+//! @brief number of elements that differ between two local matrices
+int CountErrors (
+        const MatrixDense<double,int>& A,
+        const MatrixDense<double,int>& B ) {
+
+  if ( A.GetNumbRows( ) != B.GetNumbRows( ) ||
+       A.GetNumbColumns( ) != B.GetNumbColumns( ) ) {
+    return 1;
+  }
+  int numb_errors = 0;
+  for ( int i = 0; i < A.GetNumbRows( ) * A.GetNumbColumns( ); i++ ) {
+    if ( A.GetCoef( )[i] != B.GetCoef( )[i] ) {
+      numb_errors++;
+    }
+  }
+  return numb_errors;
+}
+
+int main (
+        int argc,
+        char** argv ) {
+
+  // ---------------------------------------------------------------------------
+  // -- initialize MPI
+  // ---------------------------------------------------------------------------
+
+  // -- number of processors
+  int numb_procs;
+  // -- process number (process rank)
+  int proc_numb;
+  // -- starts MPI
+  MPI_Init( &argc, &argv );
+  // -- get the communicator
+  MPI_Comm mpi_comm = MPI_COMM_WORLD;
+  // -- get number of processes
+  MPI_Comm_size( mpi_comm, &numb_procs );
+  // -- get current process rank
+  MPI_Comm_rank( mpi_comm, &proc_numb );
+
+  // -- help for io printing
+  iomrg::g_log_numb_procs = numb_procs;
+  iomrg::g_log_proc_numb = proc_numb;
+  iomrg::g_enabled_stdout = ( proc_numb == 0 );
+
+  // -- grid of processors
+  MPI_Comm mpi_comm_rows, mpi_comm_columns;
+  DataTopology::GridCartesianComm( mpi_comm_rows, mpi_comm_columns, mpi_comm );
+
+  // ---------------------------------------------------------------------------
+  // -- pre-processing
+  // ---------------------------------------------------------------------------
+
+  // -- size of problem
+  int size = (argc > 1) ? atoi(argv[1]) : 2000;
+  // -- number of repetitions
+  const int numb_reps = (argc > 2) ? atoi(argv[2]) : 5;
+  // -- block size (block-cyclic)
+  const int block_size = (argc > 3) ? atoi(argv[3]) : 16;
+  const int proc_root = 0;
+  iomrg::printf("-- problem size: %d [numb_reps: %d, block_size: %d]\n\n",
+                size, numb_reps, block_size );
+
+  namespace dt = DataTopology;
+  dt::Distribution dist_row, dist_column, dist_block, dist_cyclic;
+  dt::CreateDistribution( dist_row, dt::distribution::c_BAND_ROW, size, size, mpi_comm );
+  dt::CreateDistribution( dist_column, dt::distribution::c_BAND_COLUMN, size, size, mpi_comm );
+  dt::CreateDistribution( dist_block, dt::distribution::c_BLOCK, size, size,
+                          mpi_comm_rows, mpi_comm_columns );
+  dt::CreateDistribution( dist_cyclic, dt::distribution::c_BLOCK_CYCLIC, size, size,
+                          mpi_comm_rows, mpi_comm_columns, block_size, block_size );
+
+  MatrixDense<double,int> A_row;
+  dt::CreateMatrix( A_row, dist_row, GenerateMatrix, &size );
+
+  // ---------------------------------------------------------------------------
+  // -- processing
+  // ---------------------------------------------------------------------------
+
+  MatrixDense<double,int> A_global;
+  MatrixDense<double,int> A_block_ref;
+  MatrixDense<double,int> A_block;
+  double time_ref = 0.;
+  double time_new = 0.;
+
+  for ( int r = 0; r < numb_reps; r++ ) {
+    MPI_Barrier( mpi_comm );
+    double t0 = MPI_Wtime( );
+    dt::AssembleMatrixBandRow( A_global, A_row, proc_root, mpi_comm );
+    dt::DistributeMatrixBlock( A_block_ref, A_global, proc_root,
+                               mpi_comm_rows, mpi_comm_columns );
+    MPI_Barrier( mpi_comm );
+    double t1 = MPI_Wtime( );
+    dt::RedistributeMatrix( A_block, dist_block, A_row, dist_row, mpi_comm );
+    MPI_Barrier( mpi_comm );
+    double t2 = MPI_Wtime( );
+    time_ref += t1 - t0;
+    time_new += t2 - t1;
+  }
+
+  // -- band-row -> block agrees with the trip through root
+  int numb_errors = CountErrors( A_block, A_block_ref );
+
+  // -- block -> block-cyclic -> band-column -> band-row
+  MatrixDense<double,int> A_cyclic, A_column, A_row_back, A_expected;
+  dt::RedistributeMatrix( A_cyclic, dist_cyclic, A_block, dist_block, mpi_comm );
+  dt::CreateMatrix( A_expected, dist_cyclic, GenerateMatrix, &size );
+  numb_errors += CountErrors( A_cyclic, A_expected );
+  dt::RedistributeMatrix( A_column, dist_column, A_cyclic, dist_cyclic, mpi_comm );
+  dt::CreateMatrix( A_expected, dist_column, GenerateMatrix, &size );
+  numb_errors += CountErrors( A_column, A_expected );
+  dt::RedistributeMatrix( A_row_back, dist_row, A_column, dist_column, mpi_comm );
+  numb_errors += CountErrors( A_row_back, A_row );
+
+  // -- vector: band-row (n x 1) -> block-cyclic row vector (1 x n, replicated)
+  dt::Distribution dist_x_row, dist_x_cyclic;
+  dt::CreateDistribution( dist_x_row, dt::distribution::c_BAND_ROW, size, 1, mpi_comm );
+  dt::CreateDistribution( dist_x_cyclic, dt::distribution::c_BLOCK_CYCLIC, 1, size,
+                          mpi_comm_rows, mpi_comm_columns, 1, block_size );
+  Vector<double,int> x_row, x_cyclic, x_expected;
+  dt::CreateVector( x_row, dist_x_row, GenerateVector );
+  dt::RedistributeVector( x_cyclic, dist_x_cyclic, x_row, dist_x_row, mpi_comm );
+  dt::CreateVector( x_expected, dist_x_cyclic, GenerateVector );
+  numb_errors += ( x_cyclic.GetSize( ) != x_expected.GetSize( ) );
+  for ( int i = 0; i < x_cyclic.GetSize( ) && i < x_expected.GetSize( ); i++ ) {
+    numb_errors += ( x_cyclic(i) != x_expected(i) );
+  }
+
+  MPI_Allreduce( MPI_IN_PLACE, &numb_errors, 1, MPI_INT, MPI_SUM, mpi_comm );
+
+  // ---------------------------------------------------------------------------
+  // -- post-processing
+  // ---------------------------------------------------------------------------
+
+  iomrg::printf( "assemble + distribute : %12.6f s\n", time_ref / numb_reps );
+  iomrg::printf( "redistribute          : %12.6f s\n", time_new / numb_reps );
+  iomrg::printf( "speedup               : %12.2f\n", time_ref / time_new );
+  iomrg::printf( "errors                : %12d\n", numb_errors );
+
+  // ---------------------------------------------------------------------------
+  // -- finalize MPI
+  // ---------------------------------------------------------------------------
+
+  // -- finalizes MPI
+  MPI_Finalize( );
+
+  return ( numb_errors == 0 ) ? 0 : 1;
+}
@@ -0,0 +1,465 @@
+// basic packages
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <functional>
+#include <string>
+#include <vector>
+#include <mpi.h>
+
+// project packages
+#include "Vector.hpp"
+#include "MatrixDense.hpp"
+#include "DataTopology.hpp"
+#include "BlasMpi.hpp"
+
+// third-party packages
+
+//! @brief timings of an operation (line of the baseline file)
+struct RegressionTiming {
+  //! operation (mvp, mmp, distribute, assemble)
+  std::string operation;
+  //! distribution (band-row, band-column, block, block-cyclic)
+  std::string distribution;
+  //! size of the matrices (size x size)
+  int size;
+  //! number of processors
+  int numb_procs;
+  //! median time of the repetitions (slowest processor)
+  double time_median;
+  //! median absolute deviation of the times
+  double time_mad;
+} ; // struct RegressionTiming {
+
+//! @brief median of values
+double Median (
+        std::vector<double> values ) {
+
+  std::sort( values.begin( ), values.end( ) );
+  size_t n = values.size( );
+  return ( n % 2 == 1 ) ? values[n/2] : 0.5 * ( values[n/2-1] + values[n/2] );
+}
+
+//! @brief largest difference between two arrays, relative to the largest value of ref
+double RelativeError (
+        const double* values,
+        const double* ref,
+        int size ) {
+
+  double error = 0.;
+  double norm = 0.;
+  for ( int i = 0; i < size; i++ ) {
+    error = std::max( error, fabs( values[i] - ref[i] ) );
+    norm = std::max( norm, fabs( ref[i] ) );
+  }
+  return ( norm > 0. ) ? error / norm : error;
+}
+
+//! @brief read the baseline file (csv, header on the first line)
+int ReadBaseline (
+        std::vector<RegressionTiming>& timings,
+        const char* file_name ) {
+
+  timings.clear( );
+  FILE* file = fopen( file_name, "r" );
+  if ( file == NULL ) {
+    return 1;
+  }
+  char line[256];
+  char operation[64];
+  char distribution[64];
+  while ( fgets( line, sizeof( line ), file ) != NULL ) {
+    RegressionTiming timing;
+    if ( sscanf( line, "%63[^,],%63[^,],%d,%d,%lf,%lf", operation, distribution,
+                 &timing.size, &timing.numb_procs,
+                 &timing.time_median, &timing.time_mad ) == 6 ) {
+      timing.operation = operation;
+      timing.distribution = distribution;
+      timings.push_back( timing );
+    }
+  }
+  fclose( file );
+  return 0;
+}
+
+//! @brief write the baseline file, sorted by processors, size and operation
+int WriteBaseline (
+        std::vector<RegressionTiming>& timings,
+        const char* file_name ) {
+
+  std::stable_sort( timings.begin( ), timings.end( ),
+                    [] ( const RegressionTiming& a, const RegressionTiming& b ) {
+                      if ( a.numb_procs != b.numb_procs ) return a.numb_procs < b.numb_procs;
+                      return a.size < b.size;
+                    } );
+  FILE* file = fopen( file_name, "w" );
+  if ( file == NULL ) {
+    return 1;
+  }
+  fprintf( file, "operation,distribution,size,numb_procs,time_median,time_mad\n" );
+  for ( size_t k = 0; k < timings.size( ); k++ ) {
+    const RegressionTiming& t = timings[k];
+    fprintf( file, "%s,%s,%d,%d,%.9f,%.9f\n", t.operation.c_str( ),
+             t.distribution.c_str( ), t.size, t.numb_procs, t.time_median, t.time_mad );
+  }
+  fclose( file );
+  return 0;
+}
+
+//! @brief run an operation, check its result against the sequential kernel
+//! @param [in,out] timing = timing (operation, distribution and size set)
+//! @param [out] error = relative error of the result on root
+//! @param [in] numb_reps = number of timed runs (after one untimed run)
+//! @param [in] mpi_comm = MPI communicator
+//! @remarks distribute is checked by assembling its result, assemble by
+//           comparing with the matrix distributed
+//! @return error code
+int RunCase (
+        RegressionTiming& timing,
+        double& error,
+        int numb_reps,
+        MPI_Comm& mpi_comm ) {
+
+  const std::string& operation = timing.operation;
+  const std::string& distribution = timing.distribution;
+  const int size = timing.size;
+  const int block_size = 16;
+  const int proc_root = 0;
+  int proc_numb;
+  MPI_Comm_rank( mpi_comm, &proc_numb );
+  MPI_Comm_size( mpi_comm, &timing.numb_procs );
+
+  // -- global operands and sequential results on root
+  MatrixDense<double,int> A_global;
+  MatrixDense<double,int> B_global;
+  MatrixDense<double,int> C_ref;
+  Vector<double,int> x_global;
+  Vector<double,int> y_ref;
+  if ( proc_numb == proc_root ) {
+    A_global.Allocate( size, size );
+    B_global.Allocate( size, size );
+    x_global.Allocate( size );
+    for( int i = 0; i < size; i++ ) {
+      for( int j = 0; j < size; j++ ) {
+        A_global(i,j) = 1. / ( 1. + i + 2. * j );
+        B_global(i,j) = ( ( i * 7 + j * 3 ) % 11 ) - 5.;
+      }
+      x_global(i) = 1. + ( i % 5 );
+    }
+    if ( operation == "mvp" ) {
+      y_ref.Allocate( size );
+      A_global.MatrixVectorProduct( y_ref, x_global );
+    } else if ( operation == "mmp" ) {
+      C_ref.Allocate( size, size );
+      A_global.MatrixMatrixProduct( C_ref, B_global );
+    }
+  }
+
+  MPI_Comm mpi_comm_rows = MPI_COMM_NULL;
+  MPI_Comm mpi_comm_columns = MPI_COMM_NULL;
+  if ( distribution == "block" || distribution == "block-cyclic" ) {
+    DataTopology::GridCartesianComm( mpi_comm_rows, mpi_comm_columns, mpi_comm,
+                                     size, size,
+                                     ( operation == "mmp" ) ?
+                                     DataTopology::operation::c_GEMM :
+                                     DataTopology::operation::c_GEMV );
+  }
+
+  // -- distribute and assemble of each distribution
+  std::function<int ( MatrixDense<double,int>&, const MatrixDense<double,int>& )> distribute;
+  std::function<int ( MatrixDense<double,int>&, const MatrixDense<double,int>& )> assemble;
+  if ( distribution == "band-row" ) {
+    distribute = [&] ( MatrixDense<double,int>& A_local, const MatrixDense<double,int>& A ) {
+      return DataTopology::DistributeMatrixBandRow( A_local, A, proc_root, mpi_comm );
+    };
+    assemble = [&] ( MatrixDense<double,int>& A, const MatrixDense<double,int>& A_local ) {
+      return DataTopology::AssembleMatrixBandRow( A, A_local, proc_root, mpi_comm );
+    };
+  } else if ( distribution == "band-column" ) {
+    distribute = [&] ( MatrixDense<double,int>& A_local, const MatrixDense<double,int>& A ) {
+      return DataTopology::DistributeMatrixBandColumn( A_local, A, proc_root, mpi_comm );
+    };
+    assemble = [&] ( MatrixDense<double,int>& A, const MatrixDense<double,int>& A_local ) {
+      return DataTopology::AssembleMatrixBandColumn( A, A_local, proc_root, mpi_comm );
+    };
+  } else if ( distribution == "block" ) {
+    distribute = [&] ( MatrixDense<double,int>& A_local, const MatrixDense<double,int>& A ) {
+      return DataTopology::DistributeMatrixBlock( A_local, A, proc_root,
+                                                  mpi_comm_rows, mpi_comm_columns );
+    };
+    assemble = [&] ( MatrixDense<double,int>& A, const MatrixDense<double,int>& A_local ) {
+      return DataTopology::AssembleMatrixBlock( A, A_local, proc_root,
+                                                mpi_comm_rows, mpi_comm_columns );
+    };
+  } else {
+    distribute = [&] ( MatrixDense<double,int>& A_local, const MatrixDense<double,int>& A ) {
+      return DataTopology::DistributeMatrixBlockCyclic( A_local, A, block_size, block_size,
+                                                        proc_root,
+                                                        mpi_comm_rows, mpi_comm_columns );
+    };
+    assemble = [&] ( MatrixDense<double,int>& A, const MatrixDense<double,int>& A_local ) {
+      return DataTopology::AssembleMatrixBlockCyclic( A, A_local, block_size, block_size,
+                                                      proc_root,
+                                                      mpi_comm_rows, mpi_comm_columns );
+    };
+  }
+
+  // -- operands of the timed operation, prepared outside the timings
+  MatrixDense<double,int> A_local;
+  MatrixDense<double,int> B_local;
+  MatrixDense<double,int> C_local;
+  MatrixDense<double,int> C_global;
+  Vector<double,int> x_local;
+  Vector<double,int> y_local;
+  Vector<double,int> y_global;
+  std::function<int ( )> run;
+  std::function<int ( )> check;
+  error = 0.;
+
+  if ( operation == "distribute" ) {
+    run = [&] ( ) { return distribute( A_local, A_global ); };
+    check = [&] ( ) {
+      assemble( C_global, A_local );
+      if ( proc_numb == proc_root ) {
+        error = RelativeError( C_global.GetCoef( ), A_global.GetCoef( ), size * size );
+      }
+      return 0;
+    };
+  } else if ( operation == "assemble" ) {
+    distribute( A_local, A_global );
+    run = [&] ( ) { return assemble( C_global, A_local ); };
+    check = [&] ( ) {
+      if ( proc_numb == proc_root ) {
+        error = RelativeError( C_global.GetCoef( ), A_global.GetCoef( ), size * size );
+      }
+      return 0;
+    };
+  } else if ( operation == "mvp" && distribution == "band-row" ) {
+    distribute( A_local, A_global );
+    DataTopology::DistributeVectorBand( x_local, x_global, proc_root, mpi_comm );
+    y_local.Allocate( A_local.GetNumbRows( ) );
+    run = [&] ( ) {
+      return BlasMpi::MatrixVectorProductBandRow( y_local, A_local, x_local, mpi_comm );
+    };
+    check = [&] ( ) {
+      DataTopology::AssembleVectorBand( y_global, y_local, proc_root, mpi_comm );
+      if ( proc_numb == proc_root ) {
+        error = RelativeError( y_global.GetCoef( ), y_ref.GetCoef( ), size );
+      }
+      return 0;
+    };
+  } else if ( operation == "mvp" && distribution == "block-cyclic" ) {
+    distribute( A_local, A_global );
+    DataTopology::DistributeVectorBlockCyclic( x_local, x_global, block_size, proc_root,
+                                               mpi_comm_rows, mpi_comm_columns );
+    y_local.Allocate( A_local.GetNumbRows( ) );
+    run = [&] ( ) {
+      return BlasMpi::MatrixVectorProductBlockCyclic( y_local, A_local, x_local,
+                                                      mpi_comm_rows, mpi_comm_columns );
+    };
+    check = [&] ( ) {
+      DataTopology::AssembleVectorBlockCyclic( y_global, y_local, block_size, proc_root,
+                                               mpi_comm_rows, mpi_comm_columns );
+      if ( proc_numb == proc_root ) {
+        error = RelativeError( y_global.GetCoef( ), y_ref.GetCoef( ), size );
+      }
+      return 0;
+    };
+  } else if ( operation == "mmp" && distribution == "block-cyclic" ) {
+    distribute( A_local, A_global );
+    distribute( B_local, B_global );
+    run = [&] ( ) {
+      return BlasMpi::MatrixMatrixProductBlockCyclic( C_local, A_local, B_local, block_size,
+                                                      mpi_comm_rows, mpi_comm_columns );
+    };
+    check = [&] ( ) {
+      assemble( C_global, C_local );
+      if ( proc_numb == proc_root ) {
+        error = RelativeError( C_global.GetCoef( ), C_ref.GetCoef( ), size * size );
+      }
+      return 0;
+    };
+  } else {
+    return 1;
+  }
+
+  // -- one untimed run, time of a repetition: slowest processor
+  std::vector<double> times;
+  for ( int r = 0; r <= numb_reps; r++ ) {
+    MPI_Barrier( mpi_comm );
+    double t0 = MPI_Wtime( );
+    run( );
+    double time = MPI_Wtime( ) - t0;
+    MPI_Allreduce( MPI_IN_PLACE, &time, 1, MPI_DOUBLE, MPI_MAX, mpi_comm );
+    if ( r > 0 ) {
+      times.push_back( time );
+    }
+  }
+  check( );
+
+  timing.time_median = Median( times );
+  for ( size_t k = 0; k < times.size( ); k++ ) {
+    times[k] = fabs( times[k] - timing.time_median );
+  }
+  timing.time_mad = Median( times );
+
+  return 0;
+}
+
+int main (
+        int argc,
+        char** argv ) {
+
+  // ---------------------------------------------------------------------------
+  // -- initialize MPI
+  // ---------------------------------------------------------------------------
+
+  // -- number of processors
+  int numb_procs;
+  // -- process number (process rank)
+  int proc_numb;
+  // -- starts MPI
+  MPI_Init( &argc, &argv );
+  // -- get the communicator
+  MPI_Comm mpi_comm = MPI_COMM_WORLD;
+  // -- get number of processes
+  MPI_Comm_size( mpi_comm, &numb_procs );
+  // -- get current process rank
+  MPI_Comm_rank( mpi_comm, &proc_numb );
+
+  // -- help for io printing
+  iomrg::g_log_numb_procs = numb_procs;
+  iomrg::g_log_proc_numb = proc_numb;
+  iomrg::g_enabled_stdout = ( proc_numb == 0 );
+
+  // ---------------------------------------------------------------------------
+  // -- pre-processing
+  // ---------------------------------------------------------------------------
+
+  // -- baseline file (csv)
+  const char* file_name = (argc > 1) ? argv[1] : "BenchRegression.csv";
+  // -- check: compare with the baseline, record: replace the baseline lines
+  //    of this number of processors and size
+  const bool opt_record = (argc > 2) && strcmp( argv[2], "record" ) == 0;
+  // -- size of problem
+  const int size = (argc > 3) ? atoi(argv[3]) : 256;
+  // -- number of timed runs
+  const int numb_reps = (argc > 4) ? atoi(argv[4]) : 11;
+  // -- relative slowdown above which a significant change is a regression
+  const double tolerance = (argc > 5) ? atof(argv[5]) : 0.25;
+  // -- regressions fail (1) or are only reported (0)
+  const bool opt_strict = (argc > 6) ? atoi(argv[6]) != 0 : false;
+  // -- relative error of the results against the sequential kernel
+  const double tolerance_error = 1.e-10;
+  iomrg::printf( "-- problem size: %d [numb_procs: %d, numb_reps: %d, tolerance: %.2f, %s]\n\n",
+                 size, numb_procs, numb_reps, tolerance, opt_record ? "record" : "check" );
+
+  // -- MatrixVectorProductBandColumn (no reduction of the partial products),
+  //    MatrixVectorProductBlock and MatrixMatrixProductBlock are not complete
+  const char* cases[][2] = {
+    { "distribute", "band-row" }, { "assemble", "band-row" }, { "mvp", "band-row" },
+    { "distribute", "band-column" }, { "assemble", "band-column" },
+    { "distribute", "block" }, { "assemble", "block" },
+    { "distribute", "block-cyclic" }, { "assemble", "block-cyclic" },
+    { "mvp", "block-cyclic" }, { "mmp", "block-cyclic" }
+  };
+  const int numb_cases = sizeof( cases ) / sizeof( cases[0] );
+
+  std::vector<RegressionTiming> baseline;
+  if ( proc_numb == 0 && ReadBaseline( baseline, file_name ) != 0 && !opt_record ) {
+    iomrg::printf( "-- no baseline: %s\n\n", file_name );
+  }
+
+  // ---------------------------------------------------------------------------
+  // -- processing
+  // ---------------------------------------------------------------------------
+
+  std::vector<RegressionTiming> timings;
+  std::vector<double> errors;
+  for ( int c = 0; c < numb_cases; c++ ) {
+    RegressionTiming timing;
+    timing.operation = cases[c][0];
+    timing.distribution = cases[c][1];
+    timing.size = size;
+    double error;
+    RunCase( timing, error, numb_reps, mpi_comm );
+    timings.push_back( timing );
+    errors.push_back( error );
+  }
+
+  // ---------------------------------------------------------------------------
+  // -- post-processing
+  // ---------------------------------------------------------------------------
+
+  // -- delta report: significant when the difference of the medians exceeds
+  //    the tolerance and three deviations (MAD scaled to a normal deviation)
+  int numb_errors = 0;
+  int numb_regressions = 0;
+  if ( proc_numb == 0 ) {
+    iomrg::printf( "%-10s %-12s %5s %12s %12s %9s %10s  %s\n", "operation", "distribution",
+                   "procs", "base (s)", "median (s)", "delta", "error", "status" );
+    for ( int c = 0; c < numb_cases; c++ ) {
+      const RegressionTiming& t = timings[c];
+      const RegressionTiming* base = NULL;
+      for ( size_t k = 0; k < baseline.size( ); k++ ) {
+        if ( baseline[k].operation == t.operation && baseline[k].distribution == t.distribution &&
+             baseline[k].size == t.size && baseline[k].numb_procs == t.numb_procs ) {
+          base = &baseline[k];
+        }
+      }
+      const char* status = "ok";
+      double delta = 0.;
+      if ( !( errors[c] <= tolerance_error ) ) {
+        status = "WRONG";
+        numb_errors++;
+      } else if ( base == NULL ) {
+        status = "new";
+      } else {
+        delta = ( t.time_median - base->time_median ) / base->time_median;
+        double noise = 3. * 1.4826 * sqrt( t.time_mad * t.time_mad +
+                                           base->time_mad * base->time_mad );
+        bool significant = fabs( t.time_median - base->time_median ) > noise;
+        if ( significant && delta > tolerance ) {
+          status = "REGRESSION";
+          numb_regressions++;
+        } else if ( significant && delta < -tolerance ) {
+          status = "faster";
+        }
+      }
+      iomrg::printf( "%-10s %-12s %5d %12.6f %12.6f %8.1f%% %10.2e  %s\n",
+                     t.operation.c_str( ), t.distribution.c_str( ), t.numb_procs,
+                     ( base != NULL ) ? base->time_median : 0., t.time_median,
+                     100. * delta, errors[c], status );
+    }
+
+    if ( opt_record ) {
+      std::vector<RegressionTiming> merged;
+      for ( size_t k = 0; k < baseline.size( ); k++ ) {
+        if ( baseline[k].numb_procs != numb_procs || baseline[k].size != size ) {
+          merged.push_back( baseline[k] );
+        }
+      }
+      merged.insert( merged.end( ), timings.begin( ), timings.end( ) );
+      numb_errors += WriteBaseline( merged, file_name );
+      iomrg::printf( "\n-- baseline recorded: %s\n", file_name );
+    }
+    if ( opt_strict && !opt_record ) {
+      numb_errors += numb_regressions;
+    }
+    iomrg::printf( "\nregressions           : %12d%s\n", numb_regressions,
+                   opt_strict ? "" : " (reported only)" );
+    iomrg::printf( "errors                : %12d\n", numb_errors );
+  }
+  MPI_Bcast( &numb_errors, 1, MPI_INT, 0, mpi_comm );
+
+  // ---------------------------------------------------------------------------
+  // -- finalize MPI
+  // ---------------------------------------------------------------------------
+
+  // -- finalizes MPI
+  MPI_Finalize( );
+
+  return ( numb_errors == 0 ) ? 0 : 1;
+}
@@ -0,0 +1,191 @@
+// basic packages
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <mpi.h>
+
+// project packages
+#include "Vector.hpp"
+#include "MatrixDense.hpp"
+#include "DataTopology.hpp"
+
+// third-party packages
+
+//! @brief element (i,j) of the matrix
+double GenerateMatrix (
+        int idx,
+        int idy,
+        void* data ) {
+
+  int size = *static_cast<int*>(data);
+  return 1. / ( 1. + idx ) - 3. * idy + size;
+}
+
+//! @brief number of elements that differ between two local matrices
+int CountErrors (
+        const MatrixDense<double,int>& A,
+        const MatrixDense<double,int>& B ) {
+
+  if ( A.GetNumbRows( ) != B.GetNumbRows( ) ||
+       A.GetNumbColumns( ) != B.GetNumbColumns( ) ) {
+    return 1;
+  }
+  int numb_errors = 0;
+  for ( int i = 0; i < A.GetNumbRows( ) * A.GetNumbColumns( ); i++ ) {
+    if ( A.GetCoef( )[i] != B.GetCoef( )[i] ) {
+      numb_errors++;
+    }
+  }
+  return numb_errors;
+}
+
+int main (
+        int argc,
+        char** argv ) {
+
+  // ---------------------------------------------------------------------------
+  // -- initialize MPI
+  // ---------------------------------------------------------------------------
+
+  // -- number of processors
+  int numb_procs;
+  // -- process number (process rank)
+  int proc_numb;
+  // -- starts MPI
+  MPI_Init( &argc, &argv );
+  // -- get the communicator
+  MPI_Comm mpi_comm = MPI_COMM_WORLD;
+  // -- get number of processes
+  MPI_Comm_size( mpi_comm, &numb_procs );
+  // -- get current process rank
+  MPI_Comm_rank( mpi_comm, &proc_numb );
+
+  // -- help for io printing
+  iomrg::g_log_numb_procs = numb_procs;
+  iomrg::g_log_proc_numb = proc_numb;
+  iomrg::g_enabled_stdout = ( proc_numb == 0 );
+
+  // -- grid of processors (shard r belongs to the rank r of the grid)
+  MPI_Comm mpi_comm_rows, mpi_comm_columns, mpi_comm_grid;
+  DataTopology::GridCartesianComm( mpi_comm_rows, mpi_comm_columns, mpi_comm );
+  DataTopology::GridComm( mpi_comm_grid, mpi_comm_rows );
+
+  // ---------------------------------------------------------------------------
+  // -- pre-processing
+  // ---------------------------------------------------------------------------
+
+  // -- size of problem
+  int size = (argc > 1) ? atoi(argv[1]) : 2000;
+  // -- number of repetitions
+  const int numb_reps = (argc > 2) ? atoi(argv[2]) : 3;
+  const char* file_group_name_csv = "bench_shards";
+  const char* file_group_name = "bench_shards_bin";
+  iomrg::printf("-- problem size: %d [numb_reps: %d]\n\n", size, numb_reps );
+
+  namespace dt = DataTopology;
+  dt::Distribution dist_block;
+  dt::CreateDistribution( dist_block, dt::distribution::c_BLOCK, size, size,
+                          mpi_comm_rows, mpi_comm_columns );
+  const int numb_procs_i = dist_block.numb_procs_i;
+  const int numb_procs_j = dist_block.numb_procs_j;
+  int proc_numb_grid;
+  MPI_Comm_rank( mpi_comm_grid, &proc_numb_grid );
+
+  // -- csv shards with the historical names (e.g. bench_shards_4_2x2_001.csv)
+  MatrixDense<double,int> A_block;
+  dt::CreateMatrix( A_block, dist_block, GenerateMatrix, &size );
+  std::string file_name_csv = dt::GetProcFilename( file_group_name_csv, "csv",
+                                                   proc_numb_grid,
+                                                   numb_procs_i, numb_procs_j );
+  iomrg::g_enabled_stdout = false;
+  A_block.WriteToFileCsv( file_name_csv.c_str( ), ' ', '\n', 17 );
+  iomrg::g_enabled_stdout = ( proc_numb == 0 );
+
+  // ---------------------------------------------------------------------------
+  // -- processing
+  // ---------------------------------------------------------------------------
+
+  int numb_errors = dt::ConvertShardsFromFileCsv( file_group_name_csv, "csv",
+                                                  file_group_name,
+                                                  numb_procs_i, numb_procs_j,
+                                                  mpi_comm_grid );
+
+  MatrixDense<double,int> A_csv;
+  MatrixDense<double,int> A_shard;
+  dt::Distribution dist_shard;
+  double time_ref = 0.;
+  double time_new = 0.;
+
+  iomrg::g_enabled_stdout = false;
+  for ( int r = 0; r < numb_reps; r++ ) {
+    MPI_Barrier( mpi_comm );
+    double t0 = MPI_Wtime( );
+    numb_errors += A_csv.ReadFromFileCsv( file_name_csv.c_str( ) );
+    MPI_Barrier( mpi_comm );
+    double t1 = MPI_Wtime( );
+    numb_errors += dt::ReadMatrixFromShards( A_shard, dist_shard, file_group_name,
+                                             mpi_comm_grid );
+    MPI_Barrier( mpi_comm );
+    double t2 = MPI_Wtime( );
+    time_ref += t1 - t0;
+    time_new += t2 - t1;
+  }
+  iomrg::g_enabled_stdout = ( proc_numb == 0 );
+
+  // -- the shards give back the parts of the block distribution
+  numb_errors += CountErrors( A_csv, A_block );
+  numb_errors += CountErrors( A_shard, A_block );
+  numb_errors += ( dist_shard.type != dist_block.type ||
+                   dist_shard.numb_rows != size || dist_shard.numb_columns != size ||
+                   dist_shard.proc_numb_i != dist_block.proc_numb_i ||
+                   dist_shard.proc_numb_j != dist_block.proc_numb_j );
+
+  // -- a corrupted shard is detected
+  if ( proc_numb_grid == 0 && size > 0 ) {
+    std::string file_name = dt::GetProcFilename( file_group_name, "bin", numb_procs - 1,
+                                                 numb_procs_i, numb_procs_j );
+    FILE* file = fopen( file_name.c_str( ), "r+b" );
+    if ( file != NULL ) {
+      fseek( file, -1, SEEK_END );
+      int c = fgetc( file );
+      fseek( file, -1, SEEK_END );
+      fputc( c ^ 0xff, file );
+      fclose( file );
+    }
+  }
+  MPI_Barrier( mpi_comm );
+  iomrg::g_enabled_stdout = false;
+  numb_errors += ( size > 0 &&
+                   dt::ReadMatrixFromShards( A_shard, dist_shard, file_group_name,
+                                             mpi_comm_grid ) == 0 );
+  iomrg::g_enabled_stdout = ( proc_numb == 0 );
+
+  MPI_Allreduce( MPI_IN_PLACE, &numb_errors, 1, MPI_INT, MPI_SUM, mpi_comm );
+
+  // ---------------------------------------------------------------------------
+  // -- post-processing
+  // ---------------------------------------------------------------------------
+
+  const double giga_bytes = 8. * size * size / 1.e9;
+  iomrg::printf( "read csv shards       : %12.6f s\n", time_ref / numb_reps );
+  iomrg::printf( "read binary shards    : %12.6f s\n", time_new / numb_reps );
+  iomrg::printf( "bandwidth shards      : %12.3f GB/s\n", giga_bytes * numb_reps / time_new );
+  iomrg::printf( "speedup               : %12.2f\n", time_ref / time_new );
+  iomrg::printf( "errors                : %12d\n", numb_errors );
+
+  remove( file_name_csv.c_str( ) );
+  remove( dt::GetProcFilename( file_group_name, "bin", proc_numb_grid,
+                               numb_procs_i, numb_procs_j ).c_str( ) );
+  if ( proc_numb == 0 ) {
+    remove( ( std::string( file_group_name ) + ".manifest" ).c_str( ) );
+  }
+
+  // ---------------------------------------------------------------------------
+  // -- finalize MPI
+  // ---------------------------------------------------------------------------
+
+  // -- finalizes MPI
+  MPI_Finalize( );
+
+  return ( numb_errors == 0 ) ? 0 : 1;
+}
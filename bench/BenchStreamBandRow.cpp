@@ -0,0 +1,137 @@
+// basic packages
+#include <stdio.h>
+#include <stdlib.h>
+#include <mpi.h>
+
+// project packages
+#include "Vector.hpp"
+#include "MatrixDense.hpp"
+#include "DataTopology.hpp"
+
+// third-party packages
+
+//! @brief element (i,j) of the matrix
+double GenerateMatrix (
+        int idx,
+        int idy,
+        void* data ) {
+
+  int size = *static_cast<int*>(data);
+  return idx * size + idy;
+}
+
+int main (
+        int argc,
+        char** argv ) {
+
+  // ---------------------------------------------------------------------------
+  // -- initialize MPI
+  // ---------------------------------------------------------------------------
+
+  // -- number of processors
+  int numb_procs;
+  // -- process number (process rank)
+  int proc_numb;
+  // -- starts MPI
+  MPI_Init( &argc, &argv );
+  // -- get the communicator
+  MPI_Comm mpi_comm = MPI_COMM_WORLD;
+  // -- get number of processes
+  MPI_Comm_size( mpi_comm, &numb_procs );
+  // -- get current process rank
+  MPI_Comm_rank( mpi_comm, &proc_numb );
+
+  // -- help for io printing
+  iomrg::g_log_numb_procs = numb_procs;
+  iomrg::g_log_proc_numb = proc_numb;
+  iomrg::g_enabled_stdout = ( proc_numb == 0 );
+
+  // ---------------------------------------------------------------------------
+  // -- pre-processing
+  // ---------------------------------------------------------------------------
+
+  // -- size of problem
+  int size = (argc > 1) ? atoi(argv[1]) : 2000;
+  // -- memory of root for the file (MB)
+  const double buffer_mb = (argc > 2) ? atof(argv[2]) : 1.;
+  // -- number of repetitions
+  const int numb_reps = (argc > 3) ? atoi(argv[3]) : 3;
+  const int proc_root = 0;
+  const char* file_name = "bench_stream_band_row.bin";
+  const size_t buffer_size = (size_t) ( buffer_mb * ( 1 << 20 ) );
+  iomrg::printf("-- problem size: %d [buffer: %.2f MB, numb_reps: %d]\n\n",
+                size, buffer_mb, numb_reps );
+
+  // -- input file, written in parallel (no processor holds the matrix)
+  DataTopology::Distribution dist;
+  DataTopology::CreateDistribution( dist, DataTopology::distribution::c_BAND_ROW,
+                                    size, size, mpi_comm );
+  MatrixDense<double,int> A_expected;
+  DataTopology::CreateMatrix( A_expected, dist, GenerateMatrix, &size );
+  DataTopology::WriteMatrixToFileBinary( A_expected, dist, file_name, mpi_comm );
+
+  // ---------------------------------------------------------------------------
+  // -- processing
+  // ---------------------------------------------------------------------------
+
+  MatrixDense<double,int> A_ref;
+  MatrixDense<double,int> A_local;
+  double time_ref = 0.;
+  double time_new = 0.;
+
+  iomrg::g_enabled_stdout = false;
+  for ( int r = 0; r < numb_reps; r++ ) {
+    MPI_Barrier( mpi_comm );
+    double t0 = MPI_Wtime( );
+    // -- reference: root loads the whole matrix, then scatters it
+    MatrixDense<double,int> A_global;
+    if ( proc_numb == proc_root ) {
+      A_global.MapFromFileBinary( file_name, iomrg::binary::c_MAP_PREFAULT );
+    }
+    DataTopology::DistributeMatrixBandRow( A_ref, A_global, proc_root, mpi_comm );
+    MPI_Barrier( mpi_comm );
+    double t1 = MPI_Wtime( );
+    DataTopology::StreamMatrixBandRowFromFile( A_local, file_name, proc_root, mpi_comm,
+                                              buffer_size );
+    MPI_Barrier( mpi_comm );
+    double t2 = MPI_Wtime( );
+    time_ref += t1 - t0;
+    time_new += t2 - t1;
+  }
+  iomrg::g_enabled_stdout = ( proc_numb == 0 );
+
+  // -- both must give back the generated band
+  int numb_errors = 0;
+  for ( int i = 0; i < A_expected.GetNumbRows( ) * A_expected.GetNumbColumns( ); i++ ) {
+    if ( A_local.GetCoef( )[i] != A_expected.GetCoef( )[i] ||
+         A_ref.GetCoef( )[i] != A_expected.GetCoef( )[i] ) {
+      numb_errors++;
+    }
+  }
+  numb_errors += ( A_local.GetNumbRows( ) != A_expected.GetNumbRows( ) );
+  MPI_Allreduce( MPI_IN_PLACE, &numb_errors, 1, MPI_INT, MPI_SUM, mpi_comm );
+
+  // ---------------------------------------------------------------------------
+  // -- post-processing
+  // ---------------------------------------------------------------------------
+
+  iomrg::printf( "root memory (load)   : %12.2f MB\n", 8. * size * size / ( 1 << 20 ) );
+  iomrg::printf( "root memory (stream) : %12.2f MB\n", buffer_mb );
+  iomrg::printf( "load + scatter       : %12.6f s\n", time_ref / numb_reps );
+  iomrg::printf( "stream               : %12.6f s\n", time_new / numb_reps );
+  iomrg::printf( "speedup              : %12.2f\n", time_ref / time_new );
+  iomrg::printf( "errors               : %12d\n", numb_errors );
+
+  if ( proc_numb == proc_root ) {
+    remove( file_name );
+  }
+
+  // ---------------------------------------------------------------------------
+  // -- finalize MPI
+  // ---------------------------------------------------------------------------
+
+  // -- finalizes MPI
+  MPI_Finalize( );
+
+  return ( numb_errors == 0 ) ? 0 : 1;
+}
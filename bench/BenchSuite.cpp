@@ -0,0 +1,477 @@
+// basic packages
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <functional>
+#include <string>
+#include <vector>
+#include <mpi.h>
+
+// project packages
+#include "Vector.hpp"
+#include "MatrixDense.hpp"
+#include "DataTopology.hpp"
+#include "BlasMpi.hpp"
+#include "Tune.hpp"
+#include "Roofline.hpp"
+
+// third-party packages
+
+//! @brief timings of an operation on a distribution, a size and processors
+struct BenchResult {
+  //! operation (copy, mvp, mmp, distribute, assemble)
+  std::string operation;
+  //! distribution (sequential, band-row, band-column, block, block-cyclic)
+  std::string distribution;
+  //! size of the matrices (size x size)
+  int size;
+  //! number of processors
+  int numb_procs;
+  //! times of the repetitions (slowest processor), sorted
+  std::vector<double> times;
+  //! floating point operations of one repetition
+  double flops;
+  //! bytes read, written or moved by one repetition
+  double bytes;
+  //! shortest time of one repetition allowed by the peaks of the host
+  double time_roof;
+} ; // struct BenchResult {
+
+//! @brief list of integers separated by commas ("128,256,512")
+int ParseList (
+        std::vector<int>& values,
+        const char* list ) {
+
+  values.clear( );
+  const char* pos = list;
+  while ( *pos != '\0' ) {
+    values.push_back( atoi( pos ) );
+    pos = strchr( pos, ',' );
+    if ( pos == NULL ) {
+      break;
+    }
+    pos++;
+  }
+  return 0;
+}
+
+//! @brief percentile p in [0, 1] of sorted values (linear interpolation)
+double Percentile (
+        const std::vector<double>& sorted,
+        double p ) {
+
+  if ( sorted.empty( ) ) {
+    return 0.;
+  }
+  double pos = p * ( sorted.size( ) - 1 );
+  size_t k = (size_t) pos;
+  if ( k + 1 >= sorted.size( ) ) {
+    return sorted.back( );
+  }
+  return sorted[k] + ( pos - k ) * ( sorted[k+1] - sorted[k] );
+}
+
+//! @brief kernel of the roofline of an operation
+int KernelType (
+        const std::string& operation ) {
+
+  if ( operation == "copy" ) {
+    return Roofline::kernel::c_COPY;
+  } else if ( operation == "mvp" ) {
+    return Roofline::kernel::c_GEMV;
+  } else if ( operation == "mmp" ) {
+    return Roofline::kernel::c_GEMM;
+  } else if ( operation == "distribute" ) {
+    return Roofline::kernel::c_DISTRIBUTE;
+  }
+  return Roofline::kernel::c_ASSEMBLE;
+}
+
+//! @brief run an operation numb_warmup + numb_reps times on mpi_comm
+//! @param [in,out] result = result (operation, distribution and size set)
+//! @param [in] numb_warmup = number of untimed runs
+//! @param [in] numb_reps = number of timed runs
+//! @param [in] block_size = size of the blocks (block-cyclic)
+//! @param [in] mpi_comm = MPI communicator
+//! @return 0 if the operation exists for the distribution, 1 otherwise
+int RunCase (
+        BenchResult& result,
+        int numb_warmup,
+        int numb_reps,
+        int block_size,
+        MPI_Comm& mpi_comm ) {
+
+  const std::string& operation = result.operation;
+  const std::string& distribution = result.distribution;
+  const int size = result.size;
+  const int proc_root = 0;
+  int proc_numb;
+  MPI_Comm_rank( mpi_comm, &proc_numb );
+  MPI_Comm_size( mpi_comm, &result.numb_procs );
+
+  // -- global operands on root
+  MatrixDense<double,int> A_global;
+  MatrixDense<double,int> B_global;
+  Vector<double,int> x_global;
+  if ( proc_numb == proc_root ) {
+    A_global.Allocate( size, size );
+    B_global.Allocate( size, size );
+    x_global.Allocate( size );
+    for( int i = 0; i < size; i++ ) {
+      for( int j = 0; j < size; j++ ) {
+        A_global(i,j) = ( i + j ) % 7;
+        B_global(i,j) = ( i * j ) % 5;
+      }
+      x_global(i) = i % 3;
+    }
+  }
+
+  // -- grid of the block distributions
+  MPI_Comm mpi_comm_rows = MPI_COMM_NULL;
+  MPI_Comm mpi_comm_columns = MPI_COMM_NULL;
+  if ( distribution == "block" || distribution == "block-cyclic" ) {
+    DataTopology::GridCartesianComm( mpi_comm_rows, mpi_comm_columns, mpi_comm,
+                                     size, size,
+                                     ( operation == "mmp" ) ?
+                                     DataTopology::operation::c_GEMM :
+                                     DataTopology::operation::c_GEMV );
+  }
+
+  // -- operands of the timed operation, prepared outside the timings
+  MatrixDense<double,int> A_local;
+  MatrixDense<double,int> B_local;
+  MatrixDense<double,int> C_local;
+  Vector<double,int> x_local;
+  Vector<double,int> y_local;
+  std::function<int ( )> run;
+
+  if ( distribution == "sequential" ) {
+    if ( operation == "copy" ) {
+      // -- BLAS-1 on size x size elements, as much memory as the matrices
+      x_local.Allocate( size * size );
+      y_local.Allocate( size * size );
+      x_local.SetCoef( A_global.GetCoef( ) );
+      run = [&] ( ) { y_local = x_local; return 0; };
+    } else if ( operation == "mvp" ) {
+      y_local.Allocate( size );
+      run = [&] ( ) { return A_global.MatrixVectorProduct( y_local, x_global,
+                                                           Tune::Get( ).mvp_unroll ); };
+    } else if ( operation == "mmp" ) {
+      C_local.Allocate( size, size );
+      run = [&] ( ) { return A_global.MatrixMatrixProduct( C_local, B_global,
+                                                           Tune::Get( ).mmp_tile ); };
+    }
+  } else if ( distribution == "band-row" ) {
+    if ( operation == "distribute" ) {
+      run = [&] ( ) {
+        return DataTopology::DistributeMatrixBandRow( A_local, A_global, proc_root, mpi_comm );
+      };
+    } else if ( operation == "assemble" ) {
+      DataTopology::DistributeMatrixBandRow( A_local, A_global, proc_root, mpi_comm );
+      run = [&] ( ) {
+        return DataTopology::AssembleMatrixBandRow( B_global, A_local, proc_root, mpi_comm );
+      };
+    } else if ( operation == "mvp" ) {
+      DataTopology::DistributeMatrixBandRow( A_local, A_global, proc_root, mpi_comm );
+      DataTopology::DistributeVectorBand( x_local, x_global, proc_root, mpi_comm );
+      y_local.Allocate( A_local.GetNumbRows( ) );
+      run = [&] ( ) {
+        return BlasMpi::MatrixVectorProductBandRow( y_local, A_local, x_local, mpi_comm );
+      };
+    }
+  } else if ( distribution == "band-column" ) {
+    // -- MatrixVectorProductBandColumn does not reduce the partial products:
+    //    not timed (as in BenchRegression)
+    if ( operation == "distribute" ) {
+      run = [&] ( ) {
+        return DataTopology::DistributeMatrixBandColumn( A_local, A_global, proc_root, mpi_comm );
+      };
+    } else if ( operation == "assemble" ) {
+      DataTopology::DistributeMatrixBandColumn( A_local, A_global, proc_root, mpi_comm );
+      run = [&] ( ) {
+        return DataTopology::AssembleMatrixBandColumn( B_global, A_local, proc_root, mpi_comm );
+      };
+    }
+  } else if ( distribution == "block" ) {
+    // -- MatrixVectorProductBlock and MatrixMatrixProductBlock are not
+    //    implemented: the products of the grid are timed on block-cyclic
+    if ( operation == "distribute" ) {
+      run = [&] ( ) {
+        return DataTopology::DistributeMatrixBlock( A_local, A_global, proc_root,
+                                                    mpi_comm_rows, mpi_comm_columns );
+      };
+    } else if ( operation == "assemble" ) {
+      DataTopology::DistributeMatrixBlock( A_local, A_global, proc_root,
+                                           mpi_comm_rows, mpi_comm_columns );
+      run = [&] ( ) {
+        return DataTopology::AssembleMatrixBlock( B_global, A_local, proc_root,
+                                                  mpi_comm_rows, mpi_comm_columns );
+      };
+    }
+  } else if ( distribution == "block-cyclic" ) {
+    if ( operation == "distribute" ) {
+      run = [&] ( ) {
+        return DataTopology::DistributeMatrixBlockCyclic( A_local, A_global,
+                                                          block_size, block_size, proc_root,
+                                                          mpi_comm_rows, mpi_comm_columns );
+      };
+    } else if ( operation == "assemble" ) {
+      DataTopology::DistributeMatrixBlockCyclic( A_local, A_global,
+                                                 block_size, block_size, proc_root,
+                                                 mpi_comm_rows, mpi_comm_columns );
+      run = [&] ( ) {
+        return DataTopology::AssembleMatrixBlockCyclic( B_global, A_local,
+                                                        block_size, block_size, proc_root,
+                                                        mpi_comm_rows, mpi_comm_columns );
+      };
+    } else if ( operation == "mvp" ) {
+      DataTopology::DistributeMatrixBlockCyclic( A_local, A_global,
+                                                 block_size, block_size, proc_root,
+                                                 mpi_comm_rows, mpi_comm_columns );
+      DataTopology::DistributeVectorBlockCyclic( x_local, x_global, block_size, proc_root,
+                                                 mpi_comm_rows, mpi_comm_columns );
+      y_local.Allocate( A_local.GetNumbRows( ) );
+      run = [&] ( ) {
+        return BlasMpi::MatrixVectorProductBlockCyclic( y_local, A_local, x_local,
+                                                        mpi_comm_rows, mpi_comm_columns );
+      };
+    } else if ( operation == "mmp" ) {
+      DataTopology::DistributeMatrixBlockCyclic( A_local, A_global,
+                                                 block_size, block_size, proc_root,
+                                                 mpi_comm_rows, mpi_comm_columns );
+      DataTopology::DistributeMatrixBlockCyclic( B_local, B_global,
+                                                 block_size, block_size, proc_root,
+                                                 mpi_comm_rows, mpi_comm_columns );
+      run = [&] ( ) {
+        return BlasMpi::MatrixMatrixProductBlockCyclic( C_local, A_local, B_local, block_size,
+                                                        mpi_comm_rows, mpi_comm_columns );
+      };
+    }
+  }
+  if ( !run ) {
+    return 1;
+  }
+
+  // -- time of a repetition: slowest processor
+  result.times.clear( );
+  for ( int r = 0; r < numb_warmup + numb_reps; r++ ) {
+    MPI_Barrier( mpi_comm );
+    double t0 = MPI_Wtime( );
+    run( );
+    double time = MPI_Wtime( ) - t0;
+    MPI_Allreduce( MPI_IN_PLACE, &time, 1, MPI_DOUBLE, MPI_MAX, mpi_comm );
+    if ( r >= numb_warmup ) {
+      result.times.push_back( time );
+    }
+  }
+  std::sort( result.times.begin( ), result.times.end( ) );
+  Roofline::Counts( result.flops, result.bytes, KernelType( operation ), size );
+
+  return 0;
+}
+
+//! @brief write the results (json)
+int WriteJson (
+        const char* file_name,
+        const std::vector<BenchResult>& results,
+        int numb_warmup,
+        int numb_reps ) {
+
+  FILE* file = fopen( file_name, "w" );
+  if ( file == NULL ) {
+    return 1;
+  }
+  fprintf( file, "{\n  \"numb_warmup\": %d,\n  \"numb_reps\": %d,\n  \"results\": [\n",
+           numb_warmup, numb_reps );
+  for ( size_t k = 0; k < results.size( ); k++ ) {
+    const BenchResult& r = results[k];
+    double median = Percentile( r.times, 0.5 );
+    fprintf( file, "    {\"operation\": \"%s\", \"distribution\": \"%s\", "
+                   "\"size\": %d, \"numb_procs\": %d, "
+                   "\"time_min\": %.9f, \"time_p10\": %.9f, \"time_median\": %.9f, "
+                   "\"time_p90\": %.9f, \"time_max\": %.9f, "
+                   "\"gflops\": %.6f, \"gbytes\": %.6f, \"roof_percent\": %.3f}%s\n",
+             r.operation.c_str( ), r.distribution.c_str( ), r.size, r.numb_procs,
+             r.times.front( ), Percentile( r.times, 0.1 ), median,
+             Percentile( r.times, 0.9 ), r.times.back( ),
+             r.flops / median * 1.e-9, r.bytes / median * 1.e-9,
+             100. * r.time_roof / median, ( k + 1 < results.size( ) ) ? "," : "" );
+  }
+  fprintf( file, "  ]\n}\n" );
+  fclose( file );
+  return 0;
+}
+
+//! @brief write the results (csv, one line per result)
+int WriteCsv (
+        const char* file_name,
+        const std::vector<BenchResult>& results ) {
+
+  FILE* file = fopen( file_name, "w" );
+  if ( file == NULL ) {
+    return 1;
+  }
+  fprintf( file, "operation,distribution,size,numb_procs,"
+                 "time_min,time_p10,time_median,time_p90,time_max,gflops,gbytes,"
+                 "roof_percent\n" );
+  for ( size_t k = 0; k < results.size( ); k++ ) {
+    const BenchResult& r = results[k];
+    double median = Percentile( r.times, 0.5 );
+    fprintf( file, "%s,%s,%d,%d,%.9f,%.9f,%.9f,%.9f,%.9f,%.6f,%.6f,%.3f\n",
+             r.operation.c_str( ), r.distribution.c_str( ), r.size, r.numb_procs,
+             r.times.front( ), Percentile( r.times, 0.1 ), median,
+             Percentile( r.times, 0.9 ), r.times.back( ),
+             r.flops / median * 1.e-9, r.bytes / median * 1.e-9,
+             100. * r.time_roof / median );
+  }
+  fclose( file );
+  return 0;
+}
+
+int main (
+        int argc,
+        char** argv ) {
+
+  // ---------------------------------------------------------------------------
+  // -- initialize MPI
+  // ---------------------------------------------------------------------------
+
+  // -- number of processors
+  int numb_procs;
+  // -- process number (process rank)
+  int proc_numb;
+  // -- starts MPI
+  MPI_Init( &argc, &argv );
+  // -- get the communicator
+  MPI_Comm mpi_comm = MPI_COMM_WORLD;
+  // -- get number of processes
+  MPI_Comm_size( mpi_comm, &numb_procs );
+  // -- get current process rank
+  MPI_Comm_rank( mpi_comm, &proc_numb );
+
+  // -- help for io printing
+  iomrg::g_log_numb_procs = numb_procs;
+  iomrg::g_log_proc_numb = proc_numb;
+  iomrg::g_enabled_stdout = ( proc_numb == 0 );
+
+  // ---------------------------------------------------------------------------
+  // -- pre-processing
+  // ---------------------------------------------------------------------------
+
+  // -- sizes of the matrices (comma separated)
+  std::vector<int> sizes;
+  ParseList( sizes, (argc > 1) ? argv[1] : "128,256" );
+  // -- number of untimed runs
+  const int numb_warmup = (argc > 2) ? atoi(argv[2]) : 1;
+  // -- number of timed runs
+  const int numb_reps = (argc > 3) ? atoi(argv[3]) : 5;
+  // -- results into <file_group_name>.json and <file_group_name>.csv
+  const std::string file_group_name = (argc > 4) ? argv[4] : "bench_suite";
+  // -- size of the blocks (block-cyclic)
+  const int block_size = (argc > 5) ? atoi(argv[5]) : 32;
+  // -- measure the peaks even if the cache file of the host exists
+  const bool opt_probe = (argc > 6) ? atoi(argv[6]) != 0 : false;
+
+  // -- peaks of the host, all processors running (cache file or probe)
+  Roofline::Machine machine;
+  int numb_errors = Roofline::Get( machine, mpi_comm, opt_probe );
+  std::string roofline_file_name;
+  Roofline::CacheFileName( roofline_file_name );
+  iomrg::printf( "-- roofline: %.3f GFLOP/s per processor, %.3f GFLOP/s host "
+                 "[cache file: %s]\n", machine.flops * 1.e-9, machine.flops_host * 1.e-9,
+                 roofline_file_name.c_str( ) );
+  std::string levels;
+  for ( int k = 0; k < machine.numb_levels; k++ ) {
+    char level[64];
+    snprintf( level, sizeof( level ), " %.0f KiB: %.3f", machine.level_bytes[k] / 1024.,
+              machine.bandwidth[k] * 1.e-9 );
+    levels += level;
+  }
+  iomrg::printf( "-- roofline: %.3f GB/s host, GB/s per processor by working set:%s\n",
+                 machine.bandwidth_host * 1.e-9, levels.c_str( ) );
+
+  // -- processors: powers of two up to numb_procs, and numb_procs
+  std::vector<int> procs;
+  for ( int p = 1; p < numb_procs; p *= 2 ) {
+    procs.push_back( p );
+  }
+  procs.push_back( numb_procs );
+
+  const char* distributions[] = { "sequential", "band-row", "band-column",
+                                  "block", "block-cyclic" };
+  const char* operations[] = { "copy", "mvp", "mmp", "distribute", "assemble" };
+  iomrg::printf( "-- sizes: %s [numb_procs: up to %d, numb_warmup: %d, numb_reps: %d]\n\n",
+                 (argc > 1) ? argv[1] : "128,256", numb_procs, numb_warmup, numb_reps );
+  iomrg::printf( "%-10s %-12s %6s %5s %12s %12s %12s %10s %10s %8s\n",
+                 "operation", "distribution", "size", "procs",
+                 "min (s)", "median (s)", "p90 (s)", "GFLOP/s", "GB/s", "roof %" );
+
+  // ---------------------------------------------------------------------------
+  // -- processing
+  // ---------------------------------------------------------------------------
+
+  // -- the first p processors run the case, the others wait
+  std::vector<BenchResult> results;
+  for ( size_t k = 0; k < procs.size( ); k++ ) {
+    MPI_Comm mpi_comm_sub;
+    MPI_Comm_split( mpi_comm, ( proc_numb < procs[k] ) ? 0 : MPI_UNDEFINED,
+                    proc_numb, &mpi_comm_sub );
+    for ( size_t s = 0; s < sizes.size( ); s++ ) {
+      for ( int d = 0; d < 5; d++ ) {
+        if ( procs[k] > 1 && strcmp( distributions[d], "sequential" ) == 0 ) {
+          continue;
+        }
+        for ( int o = 0; o < 5; o++ ) {
+          if ( mpi_comm_sub == MPI_COMM_NULL ) {
+            continue;
+          }
+          BenchResult result;
+          result.operation = operations[o];
+          result.distribution = distributions[d];
+          result.size = sizes[s];
+          if ( RunCase( result, numb_warmup, numb_reps, block_size, mpi_comm_sub ) != 0 ) {
+            continue;
+          }
+          double median = Percentile( result.times, 0.5 );
+          result.time_roof = Roofline::Time( machine, KernelType( result.operation ),
+                                             result.flops, result.bytes, result.numb_procs );
+          iomrg::printf( "%-10s %-12s %6d %5d %12.6f %12.6f %12.6f %10.3f %10.3f %8.1f\n",
+                         result.operation.c_str( ), result.distribution.c_str( ),
+                         result.size, result.numb_procs, result.times.front( ), median,
+                         Percentile( result.times, 0.9 ),
+                         result.flops / median * 1.e-9, result.bytes / median * 1.e-9,
+                         100. * result.time_roof / median );
+          results.push_back( result );
+        }
+      }
+    }
+    if ( mpi_comm_sub != MPI_COMM_NULL ) {
+      MPI_Comm_free( &mpi_comm_sub );
+    }
+    MPI_Barrier( mpi_comm );
+  }
+
+  // ---------------------------------------------------------------------------
+  // -- post-processing
+  // ---------------------------------------------------------------------------
+
+  // -- processor 0 belongs to every case
+  if ( proc_numb == 0 ) {
+    numb_errors += WriteJson( ( file_group_name + ".json" ).c_str( ), results,
+                              numb_warmup, numb_reps );
+    numb_errors += WriteCsv( ( file_group_name + ".csv" ).c_str( ), results );
+    iomrg::printf( "\n-- results: %s.json, %s.csv (%d cases)\n",
+                   file_group_name.c_str( ), file_group_name.c_str( ), (int) results.size( ) );
+  }
+  MPI_Bcast( &numb_errors, 1, MPI_INT, 0, mpi_comm );
+
+  // ---------------------------------------------------------------------------
+  // -- finalize MPI
+  // ---------------------------------------------------------------------------
+
+  // -- finalizes MPI
+  MPI_Finalize( );
+
+  return ( numb_errors == 0 ) ? 0 : 1;
+}
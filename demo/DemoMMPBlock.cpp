@@ -79,7 +79,8 @@ int main (
   //     for each row and each column of the grid
   MPI_Comm mpi_comm_rows;
   MPI_Comm mpi_comm_columns;
-  DataTopology::GridCartesianComm(mpi_comm_rows, mpi_comm_columns, mpi_comm);
+  DataTopology::GridCartesianComm(mpi_comm_rows, mpi_comm_columns, mpi_comm,
+                                  size, size, DataTopology::operation::c_GEMM);
 
   // -- distribute matrix band-row
   MatrixDense<double,int> A_local;
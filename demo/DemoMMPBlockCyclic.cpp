@@ -0,0 +1,191 @@
+// basic packages
+#include <stdio.h>
+#include <stdlib.h>
+#include <mpi.h>
+
+// project packages
+#include "Vector.hpp"
+#include "MatrixDense.hpp"
+#include "DataTopology.hpp"
+#include "BlasMpi.hpp"
+#include "Trace.hpp"
+#include "PerfCounter.hpp"
+#include "Memory.hpp"
+
+// third-party packages
+
+//! @brief generate the element (idx, idy) of A
+//! @param [in] idx = global row index
+//! @param [in] idy = global column index
+//! @param [in] data = size of problem (int*)
+//! @return A(idx,idy) = idx * size + idy
+double GenerateMatrix (
+        int idx,
+        int idy,
+        void* data ) {
+
+  const int size = *static_cast<const int*>(data);
+
+  return idx * size + idy;
+}
+
+int main (
+        int argc,
+        char** argv ) {
+
+  // ---------------------------------------------------------------------------
+  // -- initialize MPI
+  // ---------------------------------------------------------------------------
+
+  // -- number of processors
+  int numb_procs;
+  // -- process number (process rank)
+  int proc_numb;
+  // -- starts MPI
+  MPI_Init( &argc, &argv );
+  // -- get the communicator
+  MPI_Comm mpi_comm = MPI_COMM_WORLD;
+  // -- get number of processes
+  MPI_Comm_size( mpi_comm, &numb_procs );
+  // -- get current process rank
+  MPI_Comm_rank( mpi_comm, &proc_numb );
+
+  // -- help for io printing
+  iomrg::g_log_numb_procs = numb_procs;
+  iomrg::g_log_proc_numb = proc_numb;
+
+  // -- origin of the timed regions (compiled with cmake -DTD1_TRACE=ON)
+  Trace::Initialize( mpi_comm );
+
+  // ---------------------------------------------------------------------------
+  // -- pre-processing
+  // ---------------------------------------------------------------------------
+
+  // -- size of problem
+  const int size = (argv[1]!=NULL) ? atoi(argv[1]) : 5;
+  // -- root processor (default: 0)
+  const int proc_root = argv[2]!=NULL ? atoi(argv[2]) : 0;
+  // -- size of the blocks (default: 2)
+  const int block_size = (argv[2]!=NULL && argv[3]!=NULL) ? atoi(argv[3]) : 2;
+  // -- build local parts in place, without root nor scatter (default: 0)
+  const bool opt_generate = (argv[2]!=NULL && argv[3]!=NULL && argv[4]!=NULL) ?
+                            atoi(argv[4]) != 0 : false;
+  if( proc_numb == proc_root ) {
+    iomrg::printf("-- problem size: %d [proc_root: %d] [block_size: %d] [generate: %d]\n\n",
+                  size, proc_root, block_size, opt_generate );
+  }
+
+  // -- allocate and initialize Matrix and Vector
+  MatrixDense<double,int> A_global;
+  MatrixDense<double,int> B_global;
+
+  if ( proc_numb == proc_root && !opt_generate ) {
+    // -- global data: root only, counted apart from the local parts
+    MEMORY_TAG( "global (root)" );
+    // -- allocate and fill A
+    A_global.Allocate( size, size );
+    for( int i = 0; i < size; i++ ) {
+      for( int j = 0; j < size; j++ ) {
+        A_global(i,j) = i * size + j;
+      }
+    }
+    // -- allocate and fill B
+    B_global.Allocate( size, size );
+    for( int i = 0; i < size; i++ ) {
+      for( int j = 0; j < size; j++ ) {
+        B_global(i,j) = i * size + j;
+      }
+    }
+
+  }
+
+  // -- try to wait all processors
+  MPI_Barrier( mpi_comm );
+
+  // -- consider a square matrix (first)
+
+  // -- creation of two-dimensional grid communicator and communicators
+  //     for each row and each column of the grid
+  MPI_Comm mpi_comm_rows;
+  MPI_Comm mpi_comm_columns;
+  DataTopology::GridCartesianComm(mpi_comm_rows, mpi_comm_columns, mpi_comm,
+                                  size, size, DataTopology::operation::c_GEMM);
+
+  MatrixDense<double,int> A_local;
+  MatrixDense<double,int> B_local;
+  if ( opt_generate ) {
+    // -- each processor builds its own blocks
+    DataTopology::Distribution dist;
+    DataTopology::CreateDistribution( dist, DataTopology::distribution::c_BLOCK_CYCLIC,
+                                      size, size, mpi_comm_rows, mpi_comm_columns,
+                                      block_size, block_size );
+    int size_data = size;
+    DataTopology::CreateMatrix( A_local, dist, GenerateMatrix, &size_data );
+    DataTopology::CreateMatrix( B_local, dist, GenerateMatrix, &size_data );
+  } else {
+    // -- distribute matrix block-cyclic
+    DataTopology::DistributeMatrixBlockCyclic( A_local, A_global,
+                                               block_size, block_size, proc_root,
+                                               mpi_comm_rows, mpi_comm_columns );
+
+    // -- distribute matrix block-cyclic
+    DataTopology::DistributeMatrixBlockCyclic( B_local, B_global,
+                                               block_size, block_size, proc_root,
+                                               mpi_comm_rows, mpi_comm_columns );
+  }
+
+  // ---------------------------------------------------------------------------
+  // -- processing
+  // ---------------------------------------------------------------------------
+
+  // -- compute C := A * B
+  MatrixDense<double,int> C_local;
+  BlasMpi::MatrixMatrixProductBlockCyclic( C_local, A_local, B_local, block_size,
+                                           mpi_comm_rows, mpi_comm_columns );
+
+  // ---------------------------------------------------------------------------
+  // -- post-processing
+  // ---------------------------------------------------------------------------
+
+  MatrixDense<double,int> C_global;
+  DataTopology::AssembleMatrixBlockCyclic( C_global, C_local,
+                                           block_size, block_size, proc_root,
+                                           mpi_comm_rows, mpi_comm_columns );
+
+  // -- print
+  if ( proc_numb == proc_root && size < 20 ) {
+    if ( !opt_generate ) {
+      iomrg::printf( ">>> print A \n" );
+      A_global.WriteToStdout( );
+      iomrg::printf( ">>> print B \n" );
+      B_global.WriteToStdout( );
+    }
+    iomrg::printf( ">>> print C \n" );
+    C_global.WriteToStdout( );
+  }
+  // -- write to csv
+  if ( proc_numb == proc_root ) {
+    C_global.WriteToFileCsv("mmp_block_cyclic.csv");
+  }
+
+  // ---------------------------------------------------------------------------
+  // -- finalize MPI
+  // ---------------------------------------------------------------------------
+
+  // -- timed regions over the processors, Chrome trace into $TD1_TRACE_FILE
+  Trace::Finalize( mpi_comm, getenv( "TD1_TRACE_FILE" ) );
+
+  // -- hardware counters of the kernels per processor (cmake -DTD1_PERF=ON)
+  PerfCounter::Report( mpi_comm );
+
+  // -- current and peak bytes per processor, by allocation site, if
+  //    $TD1_MEMORY_REPORT is set
+  if ( getenv( "TD1_MEMORY_REPORT" ) != NULL ) {
+    Memory::Report( mpi_comm );
+  }
+
+  // -- finalizes MPI
+  MPI_Finalize( );
+
+  return 0;
+}
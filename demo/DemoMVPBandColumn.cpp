@@ -11,6 +11,32 @@
 
 // third-party packages
 
+//! @brief generate the element (idx, idy) of A
+//! @param [in] idx = global row index
+//! @param [in] idy = global column index
+//! @param [in] data = size of problem (int*)
+//! @return A(idx,idy) = idx * size + idy
+double GenerateMatrix (
+        int idx,
+        int idy,
+        void* data ) {
+
+  const int size = *static_cast<const int*>(data);
+
+  return idx * size + idy;
+}
+
+//! @brief generate the element idx of x
+//! @param [in] idx = global index
+//! @param [in] data = unused
+//! @return x(idx) = 1
+double GenerateVector (
+        int idx,
+        void* data ) {
+
+  return 1;
+}
+
 int main (
         int argc,
         char** argv ) {
@@ -44,15 +70,18 @@ int main (
   const int size = (argv[1]!=NULL) ? atoi(argv[1]) : 5;
   // -- root processor (default: 0)
   const int proc_root = argv[2]!=NULL ? atoi(argv[2]) : 0;
+  // -- build local parts in place, without root nor scatter (default: 0)
+  const bool opt_generate = (argv[2]!=NULL && argv[3]!=NULL) ? atoi(argv[3]) != 0 : false;
   if( proc_numb == proc_root ) {
-    iomrg::printf("-- problem size: %d [proc_root: %d]\n\n", size, proc_root );
+    iomrg::printf("-- problem size: %d [proc_root: %d] [generate: %d]\n\n",
+                  size, proc_root, opt_generate );
   }
 
   // -- allocate and initialize Matrix and Vector
   MatrixDense<double,int> A_global;
   Vector<double,int> x_global;
 
-  if ( proc_numb == proc_root ) {
+  if ( proc_numb == proc_root && !opt_generate ) {
     // -- allocate and fill A
     A_global.Allocate( size, size );
     for( int i = 0; i < size; i++ ) {
@@ -70,13 +99,26 @@ int main (
   // -- try to wait all processors
   MPI_Barrier( mpi_comm );
 
-  // -- distribute matrix band-column
   MatrixDense<double,int> A_local;
-  DataTopology::DistributeMatrixBandColumn( A_local, A_global, proc_root, mpi_comm );
-
-  // -- distribute vector
   Vector<double,int> x_local;
-  DataTopology::DistributeVectorBand( x_local, x_global, proc_root, mpi_comm );
+  if ( opt_generate ) {
+    // -- each processor builds its own band
+    DataTopology::Distribution dist_A;
+    DataTopology::CreateDistribution( dist_A, DataTopology::distribution::c_BAND_COLUMN,
+                                      size, size, mpi_comm );
+    DataTopology::Distribution dist_x;
+    DataTopology::CreateDistribution( dist_x, DataTopology::distribution::c_BAND_ROW,
+                                      size, 1, mpi_comm );
+    int size_data = size;
+    DataTopology::CreateMatrix( A_local, dist_A, GenerateMatrix, &size_data );
+    DataTopology::CreateVector( x_local, dist_x, GenerateVector );
+  } else {
+    // -- distribute matrix band-column
+    DataTopology::DistributeMatrixBandColumn( A_local, A_global, proc_root, mpi_comm );
+
+    // -- distribute vector
+    DataTopology::DistributeVectorBand( x_local, x_global, proc_root, mpi_comm );
+  }
 
   // ---------------------------------------------------------------------------
   // -- processing
@@ -93,10 +135,12 @@ int main (
 
   // -- print
   if ( proc_numb == proc_root && size < 20 ) {
-    iomrg::printf( ">>> print A \n" );
-    A_global.WriteToStdout( );
-    iomrg::printf( ">>> print x \n" );
-    x_global.WriteToStdout( );
+    if ( !opt_generate ) {
+      iomrg::printf( ">>> print A \n" );
+      A_global.WriteToStdout( );
+      iomrg::printf( ">>> print x \n" );
+      x_global.WriteToStdout( );
+    }
     iomrg::printf( ">>> print y \n" );
     y_global.WriteToStdout( );
   }
@@ -0,0 +1,128 @@
+// basic packages
+#include <stdio.h>
+#include <stdlib.h>
+#include <mpi.h>
+
+// project packages
+#include "Vector.hpp"
+#include "MatrixDense.hpp"
+#include "DataTopology.hpp"
+
+// third-party packages
+
+int main (
+        int argc,
+        char** argv ) {
+
+  // ---------------------------------------------------------------------------
+  // -- initialize MPI
+  // ---------------------------------------------------------------------------
+
+  // -- number of processors
+  int numb_procs;
+  // -- process number (process rank)
+  int proc_numb;
+  // -- starts MPI
+  MPI_Init( &argc, &argv );
+  // -- get the communicator
+  MPI_Comm mpi_comm = MPI_COMM_WORLD;
+  // -- get number of processes
+  MPI_Comm_size( mpi_comm, &numb_procs );
+  // -- get current process rank
+  MPI_Comm_rank( mpi_comm, &proc_numb );
+
+  // -- help for io printing
+  iomrg::g_log_numb_procs = numb_procs;
+  iomrg::g_log_proc_numb = proc_numb;
+
+  // ---------------------------------------------------------------------------
+  // -- pre-processing
+  // ---------------------------------------------------------------------------
+
+  // -- size of problem
+  const int size = (argc > 1) ? atoi(argv[1]) : 5;
+  // -- root processor (default: 0)
+  const int proc_root = (argc > 2) ? atoi(argv[2]) : 0;
+  // -- number of chunks of each band (default: 4)
+  const int numb_chunks = (argc > 3) ? atoi(argv[3]) : 4;
+  if( proc_numb == proc_root ) {
+    iomrg::printf("-- problem size: %d [proc_root: %d] [numb_chunks: %d] \n\n",
+                  size, proc_root, numb_chunks);
+  }
+
+  // -- allocate and initialize Matrix and Vector
+  MatrixDense<double,int> A_global;
+  Vector<double,int> x( size );
+
+  if ( proc_numb == proc_root ) {
+    // -- allocate and fill A
+    A_global.Allocate( size, size );
+    for( int i = 0; i < size; i++ ) {
+      for( int j = 0; j < size; j++ ) {
+        A_global(i,j) = i * size + j;
+      }
+    }
+    // -- fill x
+    for( int i = 0; i < size; i++ ) {
+      x(i) = 1;
+    }
+  }
+
+  // -- start the distribution of the bands of A, chunk by chunk
+  MatrixDense<double,int> A_local;
+  DataTopology::Request request_A;
+  DataTopology::IDistributeMatrixBandRow( A_local, A_global, proc_root, mpi_comm,
+                                          request_A, numb_chunks );
+
+  // -- x is needed by every processor, sent while the bands are in flight
+  MPI_Bcast( x.GetCoef( ), size, MPI_DOUBLE, proc_root, mpi_comm );
+
+  // ---------------------------------------------------------------------------
+  // -- processing
+  // ---------------------------------------------------------------------------
+
+  // -- compute y := A * x, chunk by chunk as the rows arrive
+  Vector<double,int> y_local( A_local.GetNumbRows( ) );
+  for ( int c = 0; c < numb_chunks; c++ ) {
+    int row_begin, numb_rows;
+    DataTopology::WaitRequestChunk( request_A, c, row_begin, numb_rows );
+    for ( int i = row_begin; i < row_begin + numb_rows; i++ ) {
+      double res = 0.;
+      for ( int j = 0; j < size; j++ ) {
+        res += A_local(i,j) * x(j);
+      }
+      y_local(i) = res;
+    }
+  }
+  DataTopology::WaitRequest( request_A );
+
+  // ---------------------------------------------------------------------------
+  // -- post-processing
+  // ---------------------------------------------------------------------------
+
+  Vector<double,int> y_global;
+  DataTopology::Request request_y;
+  DataTopology::IAssembleVectorBand( y_global, y_local, proc_root, mpi_comm, request_y );
+  // -- ... the next input could be prepared here ...
+  DataTopology::WaitRequest( request_y );
+
+  // -- print
+  if ( proc_numb == proc_root && size < 20 ) {
+    iomrg::printf( ">>> print y \n" );
+    y_global.WriteToStdout( );
+  }
+
+  // -- write to csv
+  if ( proc_numb == proc_root ) {
+    y_global.WriteToFileCsv("mvp_band_row_overlap.csv");
+  }
+
+  // ---------------------------------------------------------------------------
+  // -- finalize MPI
+  // ---------------------------------------------------------------------------
+
+  // -- finalizes MPI
+  MPI_Finalize( );
+
+  return 0;
+}
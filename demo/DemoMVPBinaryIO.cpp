@@ -0,0 +1,148 @@
+// basic packages
+#include <stdio.h>
+#include <stdlib.h>
+#include <mpi.h>
+
+// project packages
+#include "Vector.hpp"
+#include "MatrixDense.hpp"
+#include "DataTopology.hpp"
+#include "BlasMpi.hpp"
+
+// third-party packages
+
+//! @brief generate the element (idx, idy) of A
+//! @param [in] idx = global row index
+//! @param [in] idy = global column index
+//! @param [in] data = size of problem (int*)
+//! @return A(idx,idy) = idx * size + idy
+double GenerateMatrix (
+        int idx,
+        int idy,
+        void* data ) {
+
+  const int size = *static_cast<const int*>(data);
+
+  return idx * size + idy;
+}
+
+//! @brief generate the element idx of x
+//! @param [in] idx = global index
+//! @param [in] data = unused
+//! @return x(idx) = idx
+double GenerateVector (
+        int idx,
+        void* data ) {
+
+  return idx;
+}
+
+int main (
+        int argc,
+        char** argv ) {
+
+  // ---------------------------------------------------------------------------
+  // -- initialize MPI
+  // ---------------------------------------------------------------------------
+
+  // -- number of processors
+  int numb_procs;
+  // -- process number (process rank)
+  int proc_numb;
+  // -- starts MPI
+  MPI_Init( &argc, &argv );
+  // -- get the communicator
+  MPI_Comm mpi_comm = MPI_COMM_WORLD;
+  // -- get number of processes
+  MPI_Comm_size( mpi_comm, &numb_procs );
+  // -- get current process rank
+  MPI_Comm_rank( mpi_comm, &proc_numb );
+
+  // -- help for io printing
+  iomrg::g_log_numb_procs = numb_procs;
+  iomrg::g_log_proc_numb = proc_numb;
+
+  // ---------------------------------------------------------------------------
+  // -- pre-processing
+  // ---------------------------------------------------------------------------
+
+  // -- size of problem
+  const int size = (argv[1]!=NULL) ? atoi(argv[1]) : 5;
+  // -- size of the blocks (default: 2)
+  const int block_size = (argv[1]!=NULL && argv[2]!=NULL) ? atoi(argv[2]) : 2;
+  if( proc_numb == 0 ) {
+    iomrg::printf("-- problem size: %d [block_size: %d]\n\n", size, block_size );
+  }
+
+  // -- write A and x from a band-row layout (built in place)
+  {
+    DataTopology::Distribution dist_A;
+    DataTopology::CreateDistribution( dist_A, DataTopology::distribution::c_BAND_ROW,
+                                      size, size, mpi_comm );
+    DataTopology::Distribution dist_x;
+    DataTopology::CreateDistribution( dist_x, DataTopology::distribution::c_BAND_ROW,
+                                      size, 1, mpi_comm );
+    MatrixDense<double,int> A_band;
+    Vector<double,int> x_band;
+    int size_data = size;
+    DataTopology::CreateMatrix( A_band, dist_A, GenerateMatrix, &size_data );
+    DataTopology::CreateVector( x_band, dist_x, GenerateVector );
+    DataTopology::WriteMatrixToFileBinary( A_band, dist_A, "mvp_A.bin", mpi_comm );
+    DataTopology::WriteVectorToFileBinary( x_band, dist_x, "mvp_x.bin", mpi_comm );
+  }
+
+  // -- creation of two-dimensional grid communicator and communicators
+  //     for each row and each column of the grid
+  MPI_Comm mpi_comm_rows;
+  MPI_Comm mpi_comm_columns;
+  DataTopology::GridCartesianComm( mpi_comm_rows, mpi_comm_columns, mpi_comm,
+                                   size, size, DataTopology::operation::c_GEMV );
+  MPI_Comm mpi_comm_grid;
+  DataTopology::GridComm( mpi_comm_grid, mpi_comm_rows );
+
+  // -- read A straight into a block-cyclic layout
+  DataTopology::Distribution dist_A;
+  DataTopology::CreateDistribution( dist_A, DataTopology::distribution::c_BLOCK_CYCLIC,
+                                    0, 0, mpi_comm_rows, mpi_comm_columns,
+                                    block_size, block_size );
+  MatrixDense<double,int> A_local;
+  DataTopology::ReadMatrixFromFileBinary( A_local, dist_A, "mvp_A.bin", mpi_comm_grid );
+
+  // -- read x following the columns of A (1 x n)
+  DataTopology::Distribution dist_x;
+  DataTopology::CreateDistribution( dist_x, DataTopology::distribution::c_BLOCK_CYCLIC,
+                                    1, 0, 1, dist_A.numb_procs_j,
+                                    0, dist_A.proc_numb_j, 1, block_size );
+  Vector<double,int> x_local;
+  DataTopology::ReadVectorFromFileBinary( x_local, dist_x, "mvp_x.bin", mpi_comm_grid );
+
+  // ---------------------------------------------------------------------------
+  // -- processing
+  // ---------------------------------------------------------------------------
+
+  // -- compute y := A * x
+  Vector<double,int> y_local( A_local.GetNumbRows( ) );
+  BlasMpi::MatrixVectorProductBlockCyclic( y_local, A_local, x_local,
+                                           mpi_comm_rows, mpi_comm_columns );
+
+  // ---------------------------------------------------------------------------
+  // -- post-processing
+  // ---------------------------------------------------------------------------
+
+  // -- write y following the rows of A (n x 1), without assemble on root
+  DataTopology::Distribution dist_y;
+  DataTopology::CreateDistribution( dist_y, DataTopology::distribution::c_BLOCK_CYCLIC,
+                                    dist_A.numb_rows, 1, dist_A.numb_procs_i, 1,
+                                    dist_A.proc_numb_i, 0, block_size, 1 );
+  DataTopology::WriteVectorToFileBinary( y_local, dist_y, "mvp_binary_io.bin",
+                                         mpi_comm_grid );
+
+  // ---------------------------------------------------------------------------
+  // -- finalize MPI
+  // ---------------------------------------------------------------------------
+
+  // -- finalizes MPI
+  MPI_Finalize( );
+
+  return 0;
+}
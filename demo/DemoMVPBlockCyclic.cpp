@@ -0,0 +1,193 @@
+// basic packages
+#include <stdio.h>
+#include <stdlib.h>
+#include <mpi.h>
+
+// project packages
+#include "Vector.hpp"
+#include "MatrixDense.hpp"
+#include "DataTopology.hpp"
+#include "BlasMpi.hpp"
+
+// third-party packages
+
+//! @brief generate the element (idx, idy) of A
+//! @param [in] idx = global row index
+//! @param [in] idy = global column index
+//! @param [in] data = size of problem (int*)
+//! @return A(idx,idy) = idx * size + idy
+double GenerateMatrix (
+        int idx,
+        int idy,
+        void* data ) {
+
+  const int size = *static_cast<const int*>(data);
+
+  return idx * size + idy;
+}
+
+//! @brief generate the element idx of x
+//! @param [in] idx = global index
+//! @param [in] data = unused
+//! @return x(idx) = idx
+double GenerateVector (
+        int idx,
+        void* data ) {
+
+  return idx;
+}
+
+int main (
+        int argc,
+        char** argv ) {
+
+  // ---------------------------------------------------------------------------
+  // -- initialize MPI
+  // ---------------------------------------------------------------------------
+
+  // -- number of processors
+  int numb_procs;
+  // -- process number (process rank)
+  int proc_numb;
+  // -- starts MPI
+  MPI_Init( &argc, &argv );
+  // -- get the communicator
+  MPI_Comm mpi_comm = MPI_COMM_WORLD;
+  // -- get number of processes
+  MPI_Comm_size( mpi_comm, &numb_procs );
+  // -- get current process rank
+  MPI_Comm_rank( mpi_comm, &proc_numb );
+
+  // -- help for io printing
+  iomrg::g_log_numb_procs = numb_procs;
+  iomrg::g_log_proc_numb = proc_numb;
+
+  // ---------------------------------------------------------------------------
+  // -- pre-processing
+  // ---------------------------------------------------------------------------
+
+  // -- size of problem
+  const int size = (argv[1]!=NULL) ? atoi(argv[1]) : 5;
+  // -- root processor (default: 0)
+  const int proc_root = argv[2]!=NULL ? atoi(argv[2]) : 0;
+  // -- size of the blocks (default: 2)
+  const int block_size = (argv[2]!=NULL && argv[3]!=NULL) ? atoi(argv[3]) : 2;
+  // -- build local parts in place, without root nor scatter (default: 0)
+  const bool opt_generate = (argv[2]!=NULL && argv[3]!=NULL && argv[4]!=NULL) ?
+                            atoi(argv[4]) != 0 : false;
+  if( proc_numb == proc_root ) {
+    iomrg::printf("-- problem size: %d [proc_root: %d] [block_size: %d] [generate: %d]\n\n",
+                  size, proc_root, block_size, opt_generate );
+  }
+
+  // -- allocate and initialize Matrix and Vector
+  MatrixDense<double,int> A_global;
+  Vector<double,int> x_global;
+
+  if ( proc_numb == proc_root && !opt_generate ) {
+    // -- allocate and fill A
+    A_global.Allocate( size, size );
+    for( int i = 0; i < size; i++ ) {
+      for( int j = 0; j < size; j++ ) {
+        A_global(i,j) = i * size + j;
+      }
+    }
+    // -- allocate and fill x
+    x_global.Allocate( size );
+    for( int i = 0; i < size; i++ ) {
+      x_global(i) = i;
+    }
+  }
+
+  // -- try to wait all processors
+  MPI_Barrier( mpi_comm );
+
+  // -- creation of two-dimensional grid communicator and communicators
+  //     for each row and each column of the grid
+  MPI_Comm mpi_comm_rows;
+  MPI_Comm mpi_comm_columns;
+  DataTopology::GridCartesianComm( mpi_comm_rows, mpi_comm_columns, mpi_comm,
+                                   size, size, DataTopology::operation::c_GEMV );
+
+  // -- placement of the grid on the nodes (pairs of processors of a row/column)
+  int edges_intra_rows, edges_inter_rows, edges_intra_columns, edges_inter_columns;
+  DataTopology::GridNodeEdges( edges_intra_rows, edges_inter_rows,
+                               edges_intra_columns, edges_inter_columns,
+                               mpi_comm_rows, mpi_comm_columns );
+  if( proc_numb == proc_root ) {
+    iomrg::printf("-- grid edges: rows [intra: %d] [inter: %d], columns [intra: %d] [inter: %d]\n\n",
+                  edges_intra_rows, edges_inter_rows, edges_intra_columns, edges_inter_columns );
+  }
+
+
+  MatrixDense<double,int> A_local;
+  Vector<double,int> x_local;
+  if ( opt_generate ) {
+    // -- each processor builds its own blocks
+    DataTopology::Distribution dist_A;
+    DataTopology::CreateDistribution( dist_A, DataTopology::distribution::c_BLOCK_CYCLIC,
+                                      size, size, mpi_comm_rows, mpi_comm_columns,
+                                      block_size, block_size );
+    // -- x follows the columns of A, replicated over the processor rows
+    DataTopology::Distribution dist_x;
+    DataTopology::CreateDistribution( dist_x, DataTopology::distribution::c_BLOCK_CYCLIC,
+                                      1, size, 1, dist_A.numb_procs_j,
+                                      0, dist_A.proc_numb_j, 1, block_size );
+    int size_data = size;
+    DataTopology::CreateMatrix( A_local, dist_A, GenerateMatrix, &size_data );
+    DataTopology::CreateVector( x_local, dist_x, GenerateVector );
+  } else {
+    // -- distribute matrix block-cyclic
+    DataTopology::DistributeMatrixBlockCyclic( A_local, A_global,
+                                               block_size, block_size, proc_root,
+                                               mpi_comm_rows, mpi_comm_columns );
+
+    // -- distribute vector
+    DataTopology::DistributeVectorBlockCyclic( x_local, x_global, block_size,
+                                               proc_root,
+                                               mpi_comm_rows, mpi_comm_columns );
+  }
+
+  // ---------------------------------------------------------------------------
+  // -- processing
+  // ---------------------------------------------------------------------------
+
+  // -- compute y := A * x
+  Vector<double,int> y_local( A_local.GetNumbRows( ) );
+  BlasMpi::MatrixVectorProductBlockCyclic( y_local, A_local, x_local,
+                                           mpi_comm_rows, mpi_comm_columns );
+
+  // ---------------------------------------------------------------------------
+  // -- post-processing
+  // ---------------------------------------------------------------------------
+
+  Vector<double,int> y_global;
+  DataTopology::AssembleVectorBlockCyclic( y_global, y_local, block_size,
+                                           proc_root,
+                                           mpi_comm_rows, mpi_comm_columns );
+
+  // -- print
+  if ( proc_numb == proc_root && size < 20 ) {
+    if ( !opt_generate ) {
+      iomrg::printf( ">>> print A \n" );
+      A_global.WriteToStdout( );
+      iomrg::printf( ">>> print x \n" );
+      x_global.WriteToStdout( );
+    }
+    iomrg::printf( ">>> print y \n" );
+    y_global.WriteToStdout( );
+  }
+  // -- write to csv
+  if ( proc_numb == proc_root ) {
+    y_global.WriteToFileCsv("mvp_block_cyclic.csv");
+  }
+
+  // ---------------------------------------------------------------------------
+  // -- finalize MPI
+  // ---------------------------------------------------------------------------
+
+  // -- finalizes MPI
+  MPI_Finalize( );
+
+  return 0;
+}
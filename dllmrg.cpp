@@ -11,7 +11,21 @@
 #include <string.h>
 #include <time.h>
 #include <sys/time.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
 #include <ctime>
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <type_traits>
 
 // project packages
 #include "dllmrg.hpp"
@@ -26,27 +40,14 @@ int CreateDims (
     int& dim_2,
     int dim ) {
 
+  // -- largest divisor not above sqrt(dim)
   dim_1 = dim;
   dim_2 = 1;
-  int i = 1;
-  int min = dim;
-  while ( i < dim ) {
-    int j = 1;
-    while ( j < dim ) {
-      int tmp = std::abs(i-j);
-      int prod = i * j;
-      if ( prod == dim && tmp < min ) {
-        dim_1 = i;
-        dim_2 = j;
-      }
-      j++;
+  for ( int i = 1; i * i <= dim; i++ ) {
+    if ( dim % i == 0 ) {
+      dim_1 = dim / i;
+      dim_2 = i;
     }
-    i++;
-  }
-  if ( dim_1 < dim_2 ) {
-    dim_1 = dim_1 ^ dim_2;
-    dim_2 = dim_1 ^ dim_2;
-    dim_1 = dim_1 ^ dim_2;
   }
 
   return 0;
@@ -91,6 +92,69 @@ bool g_is_log_project_name = false;
 char g_tmp_char64[64];
 char* g_tmp_char_v;
 
+// -- asynchronous log
+std::atomic<bool> g_log_async( false );
+
+//! @internal record of the asynchronous log (fixed slot of a ring)
+struct LogRecord {
+  //! time since SetLogAsync (s)
+  double time;
+  //! echo to stdout (g_enabled_stdout when printed)
+  bool is_stdout;
+  //! formatted message
+  char text[239];
+} ; // struct LogRecord {
+
+//! @internal ring of records of a thread (single producer, single consumer)
+//! @remarks head and tail on their own cache lines
+struct LogRing {
+  //! slots, size is a power of two
+  std::vector<LogRecord> records;
+  //! next slot written by the producer
+  alignas(64) std::atomic<size_t> head;
+  //! tail last seen by the producer (reloaded only when the ring looks full)
+  size_t tail_cached;
+  //! the thread has exited, the ring is freed once drained
+  std::atomic<bool> is_closed;
+  //! next slot read by the drain thread
+  alignas(64) std::atomic<size_t> tail;
+} ; // struct LogRing {
+
+//! @internal rings of all threads (registration only is locked)
+std::mutex g_log_rings_mutex;
+std::vector<std::unique_ptr<LogRing> > g_log_rings;
+int g_log_generation = 0;
+
+//! @internal ring of the calling thread, valid for g_log_generation,
+//           closed when the thread exits
+struct LogRingOwner {
+  LogRing* ring = NULL;
+  int generation = -1;
+  ~LogRingOwner ( ) {
+    std::lock_guard<std::mutex> lock( g_log_rings_mutex );
+    if ( ring != NULL && generation == g_log_generation ) {
+      ring->is_closed.store( true, std::memory_order_release );
+    }
+  }
+} ; // struct LogRingOwner {
+thread_local LogRingOwner g_log_ring;
+
+std::thread g_log_thread;
+std::atomic<bool> g_log_stop( false );
+std::atomic<long long> g_log_numb_dropped( 0 );
+//! @internal threads inside mrgprintfasync (rings are freed once it is 0)
+std::atomic<int> g_log_numb_producers( 0 );
+FILE* g_log_async_stream = NULL;
+size_t g_log_async_capacity = 0;
+int g_log_async_policy = log_policy::c_DROP;
+std::chrono::steady_clock::time_point g_log_async_origin;
+
+// -- collective log
+bool g_log_collect = false;
+std::mutex g_log_collect_mutex;
+std::vector<std::string> g_log_collected;
+std::string g_log_collect_pending;
+
 ________________________________________________________________________________
 
 //! @internal set log file name
@@ -133,6 +197,27 @@ ________________________________________________________________________________
 //! @internal finalize log
 int SetLogFinalize ( void ) {
 
+  // -- pending asynchronous records are written by the drain thread
+  if ( g_log_async ) {
+    // -- no new record, then wait for the records being pushed (the drain
+    //    thread still runs, a thread waiting on a full ring gets its slot)
+    g_log_async = false;
+    while ( g_log_numb_producers > 0 ) {
+      std::this_thread::yield( );
+    }
+    g_log_stop = true;
+    g_log_thread.join( );
+    if ( g_log_numb_dropped > 0 ) {
+      fprintf( g_log_async_stream, "-- %lld records dropped\n",
+               (long long) g_log_numb_dropped );
+    }
+    fclose( g_log_async_stream );
+    g_log_async_stream = NULL;
+    std::lock_guard<std::mutex> lock( g_log_rings_mutex );
+    g_log_rings.clear( );
+    g_log_generation++;
+  }
+
   if ( g_log_file_stream != NULL ) {
     fclose( g_log_file_stream );
     g_log_file_stream = NULL;
@@ -230,5 +315,762 @@ void mrgprintflog (
 
 ________________________________________________________________________________
 
+//! @internal write the records of all rings, return the number written
+int DrainLogRings ( void ) {
+
+  std::vector<LogRing*> rings;
+  {
+    std::lock_guard<std::mutex> lock( g_log_rings_mutex );
+    for ( size_t k = 0; k < g_log_rings.size( ); k++ ) {
+      rings.push_back( g_log_rings[k].get( ) );
+    }
+  }
+
+  int numb_records = 0;
+  int numb_closed = 0;
+  for ( size_t k = 0; k < rings.size( ); k++ ) {
+    LogRing& ring = *rings[k];
+    // -- closed before the last records are read: nothing is pushed after
+    bool is_closed = ring.is_closed.load( std::memory_order_acquire );
+    numb_closed += is_closed;
+    size_t mask = ring.records.size( ) - 1;
+    size_t tail = ring.tail.load( std::memory_order_relaxed );
+    size_t head = ring.head.load( std::memory_order_acquire );
+    for ( ; tail != head; tail++ ) {
+      const LogRecord& record = ring.records[tail & mask];
+      // -- time in microseconds, no floating-point formatting
+      char time[24];
+      char* end = std::to_chars( time, time + sizeof( time ) - 1,
+                                 (long long) ( record.time * 1.e6 ) ).ptr;
+      *end++ = ' ';
+      fwrite( time, 1, end - time, g_log_async_stream );
+      fputs( record.text, g_log_async_stream );
+      if ( record.is_stdout ) {
+        if ( g_log_numb_procs > 1 && 0 <= g_log_proc_numb ) {
+          fprintf( stdout, "[%d:%d] \b", g_log_proc_numb, g_log_numb_procs );
+        }
+        fputs( record.text, stdout );
+      }
+      numb_records++;
+    }
+    ring.tail.store( tail, std::memory_order_release );
+  }
+
+  // -- free the drained rings of the exited threads
+  if ( numb_closed > 0 ) {
+    std::lock_guard<std::mutex> lock( g_log_rings_mutex );
+    for ( size_t k = 0; k < g_log_rings.size( ); ) {
+      LogRing& ring = *g_log_rings[k];
+      if ( ring.is_closed.load( std::memory_order_acquire ) &&
+           ring.tail.load( std::memory_order_relaxed ) ==
+           ring.head.load( std::memory_order_acquire ) ) {
+        g_log_rings.erase( g_log_rings.begin( ) + k );
+      } else {
+        k++;
+      }
+    }
+  }
+
+  return numb_records;
+}
+
+________________________________________________________________________________
+
+//! @internal drain thread: write the records until SetLogFinalize
+void DrainLog ( void ) {
+
+  while ( !g_log_stop ) {
+    if ( DrainLogRings( ) == 0 ) {
+      std::this_thread::sleep_for( std::chrono::microseconds( 500 ) );
+    }
+  }
+  DrainLogRings( );
+  fflush( stdout );
+}
+
+________________________________________________________________________________
+
+//! @internal switch printf to an asynchronous log into a file per processor
+int SetLogAsync (
+        const char* file_group_name,
+        size_t capacity,
+        int policy ) {
+
+  if ( g_log_async ) {
+    return 1;
+  }
+
+  std::vector<char> file_name( strlen( file_group_name ) + 32 );
+  snprintf( file_name.data( ), file_name.size( ), "%s_%03d.log",
+            file_group_name, g_log_proc_numb );
+  g_log_async_stream = fopen( file_name.data( ), "w" );
+  if ( g_log_async_stream == NULL ) {
+    return 1;
+  }
+
+  g_log_async_capacity = 1;
+  while ( g_log_async_capacity < capacity ) {
+    g_log_async_capacity *= 2;
+  }
+  g_log_async_policy = policy;
+  g_log_numb_dropped = 0;
+  g_log_stop = false;
+  g_log_async_origin = std::chrono::steady_clock::now( );
+  g_log_thread = std::thread( DrainLog );
+  g_log_async = true;
+
+  return 0;
+}
+
+________________________________________________________________________________
+
+//! @internal number of records dropped by the asynchronous log so far
+long long GetLogNumbDropped ( void ) {
+
+  return g_log_numb_dropped;
+}
+
+________________________________________________________________________________
+
+//! @internal custom asynchronous mrg printf (record pushed to the thread ring)
+void mrgprintfasync (
+        const char* message,
+        va_list args ) {
+
+  // -- SetLogFinalize clears g_log_async before it reads the count
+  g_log_numb_producers++;
+  if ( !g_log_async ) {
+    g_log_numb_producers--;
+    return;
+  }
+
+  // -- first record of the thread: register its ring
+  if ( g_log_ring.generation != g_log_generation ) {
+    std::unique_ptr<LogRing> ring( new LogRing );
+    ring->records.resize( g_log_async_capacity );
+    ring->head = 0;
+    ring->tail_cached = 0;
+    ring->is_closed = false;
+    ring->tail = 0;
+    g_log_ring.ring = ring.get( );
+    g_log_ring.generation = g_log_generation;
+    std::lock_guard<std::mutex> lock( g_log_rings_mutex );
+    g_log_rings.push_back( std::move( ring ) );
+  }
+
+  LogRing& ring = *g_log_ring.ring;
+  size_t head = ring.head.load( std::memory_order_relaxed );
+  while ( head - ring.tail_cached >= ring.records.size( ) ) {
+    ring.tail_cached = ring.tail.load( std::memory_order_acquire );
+    if ( head - ring.tail_cached < ring.records.size( ) ) {
+      break;
+    }
+    if ( g_log_async_policy == log_policy::c_DROP ) {
+      g_log_numb_dropped++;
+      g_log_numb_producers--;
+      return;
+    }
+    std::this_thread::yield( );
+  }
+
+  LogRecord& record = ring.records[head & (ring.records.size( ) - 1)];
+  record.time = std::chrono::duration<double>( std::chrono::steady_clock::now( ) -
+                                               g_log_async_origin ).count( );
+  record.is_stdout = g_enabled_stdout;
+  vsnprintf( record.text, sizeof( record.text ), message, args );
+  ring.head.store( head + 1, std::memory_order_release );
+  g_log_numb_producers--;
+}
+
+________________________________________________________________________________
+
+//! @internal custom collective mrg printf (lines kept for LogCollect::Sync)
+void mrgprintfcollect (
+        const char* message,
+        va_list args ) {
+
+  if ( !g_enabled_stdout ) {
+    return;
+  }
+
+  va_list args_copy;
+  va_copy( args_copy, args );
+  char text[256];
+  int size = vsnprintf( text, sizeof( text ), message, args );
+  std::string text_long;
+  if ( size >= (int) sizeof( text ) ) {
+    text_long.resize( size + 1 );
+    vsnprintf( &text_long[0], size + 1, message, args_copy );
+    text_long.resize( size );
+  }
+  va_end( args_copy );
+  const char* begin = text_long.empty( ) ? text : text_long.c_str( );
+
+  // -- complete lines are kept, the rest waits for its '\n'
+  std::lock_guard<std::mutex> lock( g_log_collect_mutex );
+  const char* end;
+  while ( ( end = strchr( begin, '\n' ) ) != NULL ) {
+    g_log_collect_pending.append( begin, end - begin );
+    g_log_collected.push_back( g_log_collect_pending );
+    g_log_collect_pending.clear( );
+    begin = end + 1;
+  }
+  g_log_collect_pending.append( begin );
+}
+
+________________________________________________________________________________
+
+//! @internal take the lines kept by printf in collective log (g_log_collect)
+int TakeLogCollected (
+        std::vector<std::string>& lines ) {
+
+  std::lock_guard<std::mutex> lock( g_log_collect_mutex );
+  lines.swap( g_log_collected );
+  g_log_collected.clear( );
+
+  return 0;
+}
+
+________________________________________________________________________________
+
+
+//------------------------------------------------------------------------------
+//-- binary files
+//------------------------------------------------------------------------------
+
+//! @internal initialize a binary header
+int InitBinaryHeader (
+        BinaryHeader& header,
+        int64_t numb_rows,
+        int64_t numb_columns ) {
+
+  memset( &header, 0, sizeof(BinaryHeader) );
+  memcpy( header.magic, "MRGDENSE", 8 );
+  header.version = 1;
+  header.element_type = binary::c_DOUBLE;
+  header.numb_rows = numb_rows;
+  header.numb_columns = numb_columns;
+  header.data_offset = binary::c_ALIGNMENT;
+  header.layout = binary::c_ROW_MAJOR;
+  header.alignment = binary::c_ALIGNMENT;
+  header.checksum = 0;
+
+  return 0;
+}
+
+________________________________________________________________________________
+
+//! @internal check a binary header
+int CheckBinaryHeader (
+        const BinaryHeader& header ) {
+
+  if ( memcmp( header.magic, "MRGDENSE", 8 ) != 0 ) {
+    return 1;
+  }
+  if ( header.element_type != binary::c_DOUBLE ||
+       header.layout != binary::c_ROW_MAJOR ) {
+    return 1;
+  }
+  if ( header.numb_rows < 0 || header.numb_columns < 0 ||
+       header.data_offset < (int64_t) sizeof(BinaryHeader) ) {
+    return 1;
+  }
+
+  return 0;
+}
+
+________________________________________________________________________________
+
+//! @internal checksum (FNV-1a, 64 bits) of a buffer
+uint64_t ChecksumBinary (
+        const void* data,
+        size_t size ) {
+
+  const unsigned char* bytes = static_cast<const unsigned char*>(data);
+  uint64_t checksum = 14695981039346656037ULL;
+  for ( size_t i = 0; i < size; i++ ) {
+    checksum ^= bytes[i];
+    checksum *= 1099511628211ULL;
+  }
+
+  // -- 0 is kept for "not computed"
+  return ( checksum != 0 ) ? checksum : 1;
+}
+
+________________________________________________________________________________
+
+//! @internal write a binary file (header and elements)
+int WriteFileBinary (
+        const char* file_name,
+        const double* coef,
+        int64_t numb_rows,
+        int64_t numb_columns ) {
+
+  size_t data_size = numb_rows * numb_columns * sizeof(double);
+
+  BinaryHeader header;
+  InitBinaryHeader( header, numb_rows, numb_columns );
+  header.checksum = ChecksumBinary( coef, data_size );
+
+  FILE* file = fopen( file_name, "wb" );
+  if ( file == NULL ) {
+    return 1;
+  }
+
+  // -- header, padding up to the aligned data offset, elements
+  char padding[binary::c_ALIGNMENT];
+  memset( padding, 0, sizeof(padding) );
+  size_t padding_size = header.data_offset - sizeof(BinaryHeader);
+  size_t numb_written = fwrite( &header, sizeof(BinaryHeader), 1, file );
+  if ( padding_size > 0 ) {
+    numb_written += fwrite( padding, padding_size, 1, file );
+  } else {
+    numb_written++;
+  }
+  if ( data_size > 0 ) {
+    numb_written += fwrite( coef, data_size, 1, file );
+  } else {
+    numb_written++;
+  }
+
+  // -- buffered elements are written (and may fail) at fclose
+  if ( fclose( file ) != 0 ) {
+    return 1;
+  }
+
+  return ( numb_written == 3 ) ? 0 : 1;
+}
+
+________________________________________________________________________________
+
+//! @internal map a binary file in memory (private, copy on write)
+int MapFileBinary (
+        void*& map_base,
+        size_t& map_size,
+        BinaryHeader& header,
+        const char* file_name,
+        const int opt_map,
+        const bool opt_check ) {
+
+  map_base = NULL;
+  map_size = 0;
+
+  int file = open( file_name, O_RDONLY );
+  if ( file < 0 ) {
+    return 1;
+  }
+
+  struct stat file_stat;
+  if ( fstat( file, &file_stat ) != 0 ||
+       file_stat.st_size < (off_t) sizeof(BinaryHeader) ) {
+    close( file );
+    return 1;
+  }
+
+  // -- check the header before mapping the elements
+  if ( pread( file, &header, sizeof(BinaryHeader), 0 ) != sizeof(BinaryHeader) ||
+       CheckBinaryHeader( header ) != 0 ) {
+    close( file );
+    return 1;
+  }
+  size_t data_size = header.numb_rows * header.numb_columns * sizeof(double);
+  if ( (size_t) file_stat.st_size < header.data_offset + data_size ) {
+    close( file );
+    return 1;
+  }
+
+  int flags = MAP_PRIVATE;
+#ifdef MAP_POPULATE
+  if ( opt_map == binary::c_MAP_PREFAULT ) {
+    flags |= MAP_POPULATE;
+  }
+#endif
+  map_size = file_stat.st_size;
+  map_base = mmap( NULL, map_size, PROT_READ | PROT_WRITE, flags, file, 0 );
+  // -- the mapping keeps its own reference on the file
+  close( file );
+  if ( map_base == MAP_FAILED ) {
+    map_base = NULL;
+    map_size = 0;
+    return 1;
+  }
+
+  char* data = static_cast<char*>(map_base) + header.data_offset;
+  if ( opt_map == binary::c_MAP_WILLNEED ) {
+    madvise( map_base, map_size, MADV_WILLNEED );
+  }
+
+  if ( opt_check && header.checksum != 0 &&
+       ChecksumBinary( data, data_size ) != header.checksum ) {
+    UnmapFileBinary( map_base, map_size );
+    map_base = NULL;
+    map_size = 0;
+    return 1;
+  }
+
+  return 0;
+}
+
+________________________________________________________________________________
+
+//! @internal unmap a binary file
+int UnmapFileBinary (
+        void* map_base,
+        size_t map_size ) {
+
+  if ( map_base != NULL ) {
+    munmap( map_base, map_size );
+  }
+
+  return 0;
+}
+
+________________________________________________________________________________
+
+
+//------------------------------------------------------------------------------
+//-- csv files
+//------------------------------------------------------------------------------
+
+int g_csv_numb_threads = 0;
+
+//! @internal separator of the csv files (blank, comma or semicolon)
+static inline bool IsSeparatorCsv (
+        const char c ) {
+
+  return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == ',' || c == ';';
+}
+
+//! @internal number of threads for a job (no thread for small jobs)
+static int NumbThreadsCsv (
+        int numb_threads,
+        size_t job_size,
+        size_t min_job_size ) {
+
+  if ( numb_threads <= 0 ) {
+    numb_threads = g_csv_numb_threads;
+  }
+  if ( numb_threads <= 0 ) {
+    numb_threads = std::thread::hardware_concurrency( );
+  }
+  size_t max_numb_threads = job_size / min_job_size + 1;
+  if ( numb_threads <= 0 ) {
+    numb_threads = 1;
+  } else if ( (size_t) numb_threads > max_numb_threads ) {
+    numb_threads = max_numb_threads;
+  }
+
+  return numb_threads;
+}
+
+//! @internal run job(t) for t < numb_threads, job(0) on the calling thread
+template <class F>
+static void RunThreadsCsv (
+        int numb_threads,
+        F job ) {
+
+  std::vector<std::thread> threads;
+  for ( int t = 1; t < numb_threads; t++ ) {
+    threads.push_back( std::thread( job, t ) );
+  }
+  job( 0 );
+  for ( size_t t = 0; t < threads.size( ); t++ ) {
+    threads[t].join( );
+  }
+}
+
+________________________________________________________________________________
+
+//! @internal map a text file in memory (read only)
+int MapFileText (
+        const char*& text,
+        size_t& text_size,
+        const char* file_name ) {
+
+  text = NULL;
+  text_size = 0;
+
+  int file = open( file_name, O_RDONLY );
+  if ( file < 0 ) {
+    return 1;
+  }
+
+  struct stat file_stat;
+  if ( fstat( file, &file_stat ) != 0 || file_stat.st_size == 0 ) {
+    close( file );
+    return 1;
+  }
+
+  void* map_base = mmap( NULL, file_stat.st_size, PROT_READ, MAP_PRIVATE, file, 0 );
+  // -- the mapping keeps its own reference on the file
+  close( file );
+  if ( map_base == MAP_FAILED ) {
+    return 1;
+  }
+  madvise( map_base, file_stat.st_size, MADV_SEQUENTIAL );
+
+  text = static_cast<const char*>(map_base);
+  text_size = file_stat.st_size;
+
+  return 0;
+}
+
+________________________________________________________________________________
+
+//! @internal unmap a text file
+int UnmapFileText (
+        const char* text,
+        size_t text_size ) {
+
+  if ( text != NULL ) {
+    munmap( const_cast<char*>(text), text_size );
+  }
+
+  return 0;
+}
+
+________________________________________________________________________________
+
+//! @internal count the elements of a chunk
+static size_t CountChunkCsv (
+        const char* p,
+        const char* p_end ) {
+
+  size_t numb_coef = 0;
+  bool is_in_coef = false;
+  for ( ; p < p_end; p++ ) {
+    bool is_separator = IsSeparatorCsv( *p );
+    if ( !is_separator && !is_in_coef ) {
+      numb_coef++;
+    }
+    is_in_coef = !is_separator;
+  }
+
+  return numb_coef;
+}
+
+//! @internal parse the elements of a chunk
+template <class T>
+static int ParseChunkCsv (
+        T* coef,
+        const char* p,
+        const char* p_end ) {
+
+  while ( true ) {
+    while ( p < p_end && IsSeparatorCsv( *p ) ) {
+      p++;
+    }
+    if ( p == p_end ) {
+      return 0;
+    }
+    // -- from_chars does not accept a leading plus sign
+    if ( *p == '+' ) {
+      p++;
+    }
+    std::from_chars_result result = std::from_chars( p, p_end, *coef );
+    if ( result.ec != std::errc( ) ||
+         ( result.ptr < p_end && !IsSeparatorCsv( *result.ptr ) ) ) {
+      return 1;
+    }
+    p = result.ptr;
+    coef++;
+  }
+}
+
+________________________________________________________________________________
+
+//! @internal parse numbers separated by blanks, commas or semicolons
+template <class T>
+int ParseCsv (
+        T* coef,
+        size_t numb_coef,
+        const char* text_begin,
+        const char* text_end,
+        int numb_threads ) {
+
+  const size_t text_size = text_end - text_begin;
+  numb_threads = NumbThreadsCsv( numb_threads, text_size, 1 << 20 );
+
+  // -- chunk boundaries, moved forward to the next line (or separator)
+  std::vector<const char*> bounds( numb_threads + 1 );
+  bounds[0] = text_begin;
+  bounds[numb_threads] = text_end;
+  const size_t chunk_size = text_size / numb_threads;
+  for ( int t = 1; t < numb_threads; t++ ) {
+    const char* p = std::max( text_begin + t * chunk_size, bounds[t-1] );
+    const char* eol = static_cast<const char*>(
+        memchr( p, '\n', std::min( chunk_size, (size_t) (text_end - p) ) ) );
+    if ( eol != NULL ) {
+      p = eol;
+    } else {
+      while ( p < text_end && !IsSeparatorCsv( *p ) ) {
+        p++;
+      }
+    }
+    bounds[t] = p;
+  }
+
+  // -- first pass: count the elements of each chunk
+  std::vector<size_t> shifts( numb_threads + 1, 0 );
+  RunThreadsCsv( numb_threads, [&] ( int t ) {
+    shifts[t+1] = CountChunkCsv( bounds[t], bounds[t+1] );
+  } );
+  for ( int t = 0; t < numb_threads; t++ ) {
+    shifts[t+1] += shifts[t];
+  }
+  if ( shifts[numb_threads] != numb_coef ) {
+    return 1;
+  }
+
+  // -- second pass: parse each chunk at its own offset
+  std::vector<int> errors( numb_threads, 0 );
+  RunThreadsCsv( numb_threads, [&] ( int t ) {
+    errors[t] = ParseChunkCsv( coef + shifts[t], bounds[t], bounds[t+1] );
+  } );
+  for ( int t = 0; t < numb_threads; t++ ) {
+    if ( errors[t] != 0 ) {
+      return 1;
+    }
+  }
+
+  return 0;
+}
+
+________________________________________________________________________________
+
+//! @internal upper bound of the number of characters of an element
+template <class T>
+static size_t MaxCharsCsv (
+        const int precision ) {
+
+  if ( std::is_floating_point<T>::value ) {
+    int digits = ( precision > 0 ) ? precision : std::numeric_limits<T>::max_digits10;
+    // -- sign, point, exponent
+    return digits + 16;
+  }
+  return std::numeric_limits<T>::digits10 + 3;
+}
+
+//! @internal format an element (buffer large enough, see MaxCharsCsv)
+template <class T>
+static inline char* FormatCsv (
+        char* p,
+        char* p_end,
+        const T value,
+        const int precision ) {
+
+  if constexpr ( std::is_floating_point<T>::value ) {
+    if ( precision > 0 ) {
+      return std::to_chars( p, p_end, value, std::chars_format::general, precision ).ptr;
+    }
+  }
+  // -- shortest representation that reads back to the same value
+  return std::to_chars( p, p_end, value ).ptr;
+}
+
+//! @internal write a whole buffer
+static int WriteAllCsv (
+        int file,
+        const char* data,
+        size_t size ) {
+
+  while ( size > 0 ) {
+    ssize_t numb_written = write( file, data, size );
+    if ( numb_written < 0 ) {
+      if ( errno == EINTR ) {
+        continue;
+      }
+      return 1;
+    }
+    data += numb_written;
+    size -= numb_written;
+  }
+
+  return 0;
+}
+
+________________________________________________________________________________
+
+//! @internal write a row-major array into a csv file
+template <class T>
+int WriteFileCsv (
+        const char* file_name,
+        const char* header,
+        const T* coef,
+        size_t numb_rows,
+        size_t numb_columns,
+        const char separator_column,
+        const char separator_row,
+        const int precision,
+        int numb_threads ) {
+
+  int file = open( file_name, O_WRONLY | O_CREAT | O_TRUNC, 0644 );
+  if ( file < 0 ) {
+    return 1;
+  }
+
+  int error = 0;
+  if ( header != NULL ) {
+    error |= WriteAllCsv( file, header, strlen( header ) );
+    error |= WriteAllCsv( file, "\n", 1 );
+  }
+
+  // -- elements are formatted by blocks, one block per thread and per round
+  const size_t numb_coef = numb_rows * numb_columns;
+  const size_t block_size = 1 << 16;
+  const size_t numb_blocks = ( numb_coef + block_size - 1 ) / block_size;
+  numb_threads = NumbThreadsCsv( numb_threads, numb_coef, block_size );
+
+  const size_t buffer_size = block_size * ( MaxCharsCsv<T>( precision ) + 1 );
+  std::vector<std::vector<char> > buffers( numb_threads, std::vector<char>( buffer_size ) );
+  std::vector<size_t> buffer_sizes( numb_threads, 0 );
+
+  for ( size_t block = 0; block < numb_blocks && error == 0; block += numb_threads ) {
+    RunThreadsCsv( numb_threads, [&] ( int t ) {
+      const size_t k_begin = std::min( ( block + t ) * block_size, numb_coef );
+      const size_t k_end = std::min( k_begin + block_size, numb_coef );
+      char* p = buffers[t].data( );
+      char* p_end = p + buffer_size;
+      size_t j = ( k_begin < k_end ) ? k_begin % numb_columns : 0;
+      for ( size_t k = k_begin; k < k_end; k++ ) {
+        p = FormatCsv( p, p_end, coef[k], precision );
+        char separator = separator_column;
+        if ( ++j == numb_columns ) {
+          separator = separator_row;
+          j = 0;
+        }
+        if ( separator != '\0' ) {
+          *p++ = separator;
+        }
+      }
+      buffer_sizes[t] = p - buffers[t].data( );
+    } );
+    // -- one large write per block, in order
+    for ( int t = 0; t < numb_threads; t++ ) {
+      error |= WriteAllCsv( file, buffers[t].data( ), buffer_sizes[t] );
+    }
+  }
+
+  if ( close( file ) != 0 ) {
+    error = 1;
+  }
+
+  return error;
+}
+
+________________________________________________________________________________
+
+//! instantiate the csv functions
+#define INSTANTIATE_CSV(T) \
+  template int ParseCsv<T> ( T*, size_t, const char*, const char*, int ); \
+  template int WriteFileCsv<T> ( const char*, const char*, const T*, size_t, size_t, \
+                                 const char, const char, const int, int );
+
+INSTANTIATE_CSV(double)
+INSTANTIATE_CSV(float)
+INSTANTIATE_CSV(int)
+
+________________________________________________________________________________
+
 
 } // namespace iomrg {
@@ -13,8 +13,13 @@
 // basic packages
 #include <stdio.h>
 #include <stdarg.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <atomic>
 #include <limits>
 #include <complex>
+#include <string>
+#include <vector>
 
 // project packages
 
@@ -148,6 +153,8 @@ struct norm {
 //! @param [in,out] dim_1 = first dimension
 //! @param [in,out] dim_2 = second dimension
 //! @param [in] dim = dimension
+//! @remarks dim_1 >= dim_2, dim_2 is the largest divisor of dim not above
+//           sqrt(dim) (e.g. 12: 4 x 3)
 //! @return error code
 int CreateDims (
     int& dim_1,
@@ -175,6 +182,20 @@ extern bool g_log_file_reset;
 extern bool g_log_close_file;
 extern bool g_log_project_close;
 
+// -- asynchronous log (SetLogAsync)
+extern std::atomic<bool> g_log_async;
+// -- collective log: printf keeps the lines for LogCollect::Sync
+extern bool g_log_collect;
+
+//! @struct log_policy
+//! @brief what a thread does when its ring of records is full
+struct log_policy {
+  enum log_policy_enum {
+    c_DROP = 0,  //!< the record is dropped (and counted)
+    c_BLOCK = 1  //!< the thread waits for the drain (backpressure)
+  } ;
+} ;
+
 
 //! @brief set log file name
 //! @param [in] file_name  = file name
@@ -189,9 +210,38 @@ int SetLogProjectName (
         const char* project_name ) ;
 
 //! @brief finalize log
+//! @remarks stops the asynchronous log after writing all pending records
 //! @return error code
 int SetLogFinalize ( void ) ;
 
+//! @brief switch printf to an asynchronous log into a file per processor
+//! @param [in] file_group_name = file of the processor: file_group_name_%03d.log
+//! @param [in] capacity = records per thread (rounded up to a power of two)
+//! @param [in] policy = drop records or wait when the ring of a thread is full
+//! @remarks printf formats the record into a slot of the lock-free ring of
+//           the calling thread (single producer, one ring per thread); a
+//           background thread drains the rings into the file, and to stdout
+//           the records printed while g_enabled_stdout is set
+//! @remarks records are truncated to 239 characters; order is kept per thread
+//! @remarks SetLogFinalize waits for the records being pushed; a record
+//           printed once it has started is dropped
+//! @return error code
+int SetLogAsync (
+        const char* file_group_name,
+        size_t capacity = 1024,
+        int policy = log_policy::c_DROP ) ;
+
+//! @brief number of records dropped by the asynchronous log so far
+long long GetLogNumbDropped ( void ) ;
+
+//! @brief take the lines kept by printf in collective log (g_log_collect)
+//! @param [out] lines = complete lines (without '\n') printed since the last call
+//! @remarks only the lines printed while g_enabled_stdout is set are kept;
+//           an unfinished line stays until its '\n' is printed
+//! @return error code
+int TakeLogCollected (
+        std::vector<std::string>& lines ) ;
+
 //! @brief custom mrg printf
 //! @param [in] stream = file stream
 //! @param [in] message = message to print
@@ -210,6 +260,20 @@ void mrgprintflog (
         const char* message,
         va_list args ) ;
 
+//! @brief custom asynchronous mrg printf (record pushed to the thread ring)
+//! @param [in] message = message to print
+//! @param [in] args = list of arguments
+void mrgprintfasync (
+        const char* message,
+        va_list args ) ;
+
+//! @brief custom collective mrg printf (lines kept for LogCollect::Sync)
+//! @param [in] message = message to print
+//! @param [in] args = list of arguments
+void mrgprintfcollect (
+        const char* message,
+        va_list args ) ;
+
 //! @brief custom mrg printf
 //! @param [in] message = message to print
 //! @param [in] ... = more arguments
@@ -220,6 +284,22 @@ inline void printf (
 
   va_list args;
 
+  // -- collective log: lines kept until the next LogCollect::Sync
+  if ( g_log_collect ) {
+    va_start( args, message );
+    mrgprintfcollect( message, args );
+    va_end( args );
+    return;
+  }
+
+  // -- asynchronous log: no io on the calling thread
+  if ( g_log_async ) {
+    va_start( args, message );
+    mrgprintfasync( message, args );
+    va_end( args );
+    return;
+  }
+
   // -- print to stdout
   va_start( args, message );
   mrgprintf( stdout, message, args );
@@ -232,6 +312,191 @@ inline void printf (
 
 }
 
+// -----------------------------------------------------------------------------
+// -- binary files
+// -----------------------------------------------------------------------------
+
+//! @struct binary
+//! @brief manage binary element type, layout and paging
+struct binary {
+  enum element_enum {
+    //! double precision real
+    c_DOUBLE = 1
+  }  ; // enum element_enum {
+
+  enum layout_enum {
+    //! row-major storage
+    c_ROW_MAJOR = 0
+  }  ; // enum layout_enum {
+
+  //! alignment of the elements (page, bytes)
+  static const int c_ALIGNMENT = 4096;
+
+  enum map_enum {
+    //! pages are loaded on first access
+    c_MAP_LAZY = 0,
+    //! pages are read ahead asynchronously (madvise WILLNEED)
+    c_MAP_WILLNEED = 1,
+    //! pages are loaded before returning (MAP_POPULATE)
+    c_MAP_PREFAULT = 2
+  }  ; // enum map_enum {
+
+} ; // struct binary {
+
+//! @struct BinaryHeader
+//! @brief header (64 bytes) of a binary matrix (or vector) file
+//! @remarks the header is followed, at data_offset, by the elements stored
+//           in row-major order (native endianness); a vector is n x 1
+//! @remarks data_offset is a multiple of alignment, so that mapped elements
+//           are page aligned
+struct BinaryHeader {
+  //! magic number "MRGDENSE"
+  char magic[8];
+  //! format version
+  int32_t version;
+  //! element type (binary::element_enum)
+  int32_t element_type;
+  //! number of rows
+  int64_t numb_rows;
+  //! number of columns
+  int64_t numb_columns;
+  //! offset of the first element (bytes)
+  int64_t data_offset;
+  //! storage layout (binary::layout_enum)
+  int32_t layout;
+  //! alignment of the first element (bytes, binary::c_ALIGNMENT)
+  int32_t alignment;
+  //! checksum (FNV-1a) of the elements, 0 if not computed
+  uint64_t checksum;
+  //! reserved (zero)
+  char reserved[8];
+} ; // struct BinaryHeader {
+
+//! @brief initialize a binary header
+//! @param [in,out] header = binary header
+//! @param [in] numb_rows = number of rows
+//! @param [in] numb_columns = number of columns
+//! @return error code
+int InitBinaryHeader (
+        BinaryHeader& header,
+        int64_t numb_rows,
+        int64_t numb_columns ) ;
+
+//! @brief check a binary header
+//! @param [in] header = binary header
+//! @return error code (1 if not a supported binary file)
+int CheckBinaryHeader (
+        const BinaryHeader& header ) ;
+
+//! @brief checksum (FNV-1a, 64 bits) of a buffer
+//! @param [in] data = buffer
+//! @param [in] size = size of the buffer (bytes)
+//! @return checksum (never 0)
+uint64_t ChecksumBinary (
+        const void* data,
+        size_t size ) ;
+
+//! @brief write a binary file (header and elements)
+//! @param [in] file_name = name of the file
+//! @param [in] coef = elements (row-major)
+//! @param [in] numb_rows = number of rows
+//! @param [in] numb_columns = number of columns
+//! @return error code
+int WriteFileBinary (
+        const char* file_name,
+        const double* coef,
+        int64_t numb_rows,
+        int64_t numb_columns ) ;
+
+//! @brief map a binary file in memory (private, copy on write)
+//! @param [in,out] map_base = address of the mapping
+//! @param [in,out] map_size = size of the mapping (bytes)
+//! @param [in,out] header = header of the file
+//! @param [in] file_name = name of the file
+//! @param [in] opt_map = paging policy (binary::map_enum)
+//! @param [in] opt_check = verify the checksum (touches every page)
+//! @remarks elements start at (char*) map_base + header.data_offset
+//! @return error code
+int MapFileBinary (
+        void*& map_base,
+        size_t& map_size,
+        BinaryHeader& header,
+        const char* file_name,
+        const int opt_map = binary::c_MAP_LAZY,
+        const bool opt_check = false ) ;
+
+//! @brief unmap a binary file
+//! @param [in] map_base = address of the mapping
+//! @param [in] map_size = size of the mapping (bytes)
+//! @return error code
+int UnmapFileBinary (
+        void* map_base,
+        size_t map_size ) ;
+
+// -----------------------------------------------------------------------------
+// -- csv files
+// -----------------------------------------------------------------------------
+
+//! number of threads of the csv reader and writer (0 = hardware concurrency)
+extern int g_csv_numb_threads;
+
+//! @brief map a text file in memory (read only)
+//! @param [in,out] text = first character of the file
+//! @param [in,out] text_size = size of the file (bytes)
+//! @param [in] file_name = name of the file
+//! @return error code
+int MapFileText (
+        const char*& text,
+        size_t& text_size,
+        const char* file_name ) ;
+
+//! @brief unmap a text file
+//! @param [in] text = first character of the file
+//! @param [in] text_size = size of the file (bytes)
+//! @return error code
+int UnmapFileText (
+        const char* text,
+        size_t text_size ) ;
+
+//! @brief parse numbers separated by blanks, commas or semicolons
+//! @param [in,out] coef = parsed elements (allocated with numb_coef elements)
+//! @param [in] numb_coef = expected number of elements
+//! @param [in] text_begin = first character of the text
+//! @param [in] text_end = past the last character of the text
+//! @param [in] numb_threads = number of threads (0 = g_csv_numb_threads)
+//! @remarks the text is split at line (or separator) boundaries between threads
+//! @return error code (also when the text does not hold numb_coef elements)
+template <class T>
+int ParseCsv (
+        T* coef,
+        size_t numb_coef,
+        const char* text_begin,
+        const char* text_end,
+        int numb_threads = 0 ) ;
+
+//! @brief write a row-major array into a csv file
+//! @param [in] file_name = name of the file
+//! @param [in] header = first line of the file (without end of line)
+//! @param [in] coef = elements
+//! @param [in] numb_rows = number of rows
+//! @param [in] numb_columns = number of columns
+//! @param [in] separator_column = separator between elements of a row
+//! @param [in] separator_row = separator after the last element of a row
+//! @param [in] precision = significant digits (0 = shortest round-trip)
+//! @param [in] numb_threads = number of threads (0 = g_csv_numb_threads)
+//! @return error code
+template <class T>
+int WriteFileCsv (
+        const char* file_name,
+        const char* header,
+        const T* coef,
+        size_t numb_rows,
+        size_t numb_columns,
+        const char separator_column = ' ',
+        const char separator_row = '\n',
+        const int precision = 0,
+        int numb_threads = 0 ) ;
+
 // -- example:
 ////  iomrg::g_log_project = true;
 ////  iomrg::SetLogProjectName("Test");